@@ -0,0 +1,337 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+/*
+ * Awaitables for C++20 coroutines. This header is optional: The library itself is compiled as C++17 and does not
+ * include it. Applications built with C++20 can include it to co_await transfers:
+ *
+ *   auto dataLost = co_await ChimeraTK::awaitWrite(setpoint);
+ *   co_await ChimeraTK::awaitRead(status);
+ *   co_await ChimeraTK::awaitRead(transferGroup);
+ *   auto id = co_await ChimeraTK::awaitReadAny(readAnyGroup);
+ *
+ * Transfers of poll-type accessors and of TransferGroups are run in the backend's AsyncTransferPool, and the awaiting
+ * coroutine is resumed from the worker thread which completes the transfer. Push-type accessors do not occupy a thread
+ * while waiting: The coroutine is resumed through the read notification listener (see
+ * TransferElement::setReadNotificationListener()) from the thread which delivers the update, e.g. the interrupt
+ * dispatcher thread of the backend. Further updates are delayed until the coroutine is suspended again, so it should
+ * continue in the application's executor for longer work. No thread of the application's executor is blocked. Like
+ * with the synchronous functions, the accessors and groups must not be used otherwise until the transfer is complete.
+ *
+ * The suspension can be cancelled by destroying the suspended coroutine. It is then not resumed anymore. A transfer
+ * which is already running is still completed, but updates of push-type accessors are no longer consumed.
+ */
+
+#if !defined(__cpp_impl_coroutine) || __cplusplus < 202002L
+#  error "CoroutineAwaitables.h requires C++20 with coroutine support."
+#endif
+
+#include "ReadAnyGroup.h"
+#include "TransferElementAbstractor.h"
+#include "TransferGroup.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace ChimeraTK {
+
+  namespace detail {
+
+    /**
+     * Common part of the awaiters. The coroutine handle is kept in a state shared with the completing thread, so the
+     * completion can detect that the awaiter has been destroyed together with the suspended coroutine.
+     */
+    class TransferAwaiterBase {
+     public:
+      TransferAwaiterBase() = default;
+      TransferAwaiterBase(const TransferAwaiterBase&) = delete;
+      TransferAwaiterBase& operator=(const TransferAwaiterBase&) = delete;
+
+      /** Cancels the suspension. Waits until a running completion no longer accesses the awaiter. */
+      ~TransferAwaiterBase() {
+        bool isListening;
+        {
+          std::lock_guard<std::mutex> lock(_state->mutex);
+          _state->cancelled = true;
+          isListening = _state->isListening;
+        }
+        if(isListening) {
+          _setListener({});
+        }
+      }
+
+      bool await_ready() const noexcept { return false; }
+
+     protected:
+      struct State {
+        std::mutex mutex;
+        std::coroutine_handle<> handle;
+        bool cancelled{false};
+        bool isListening{false}; ///< the read notification listener is set and has not received the update yet
+      };
+
+      /**
+       * Resume the coroutine from the completing thread, unless the suspension has been cancelled. setResult is called
+       * before, while the awaiter is guaranteed to exist. The awaiter must not be accessed afterwards.
+       */
+      template<typename SET_RESULT>
+      static void complete(const std::shared_ptr<State>& state, SET_RESULT setResult) {
+        std::coroutine_handle<> handle;
+        {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if(state->cancelled) {
+            return;
+          }
+          setResult();
+          handle = state->handle;
+        }
+        handle.resume();
+      }
+
+      /**
+       * Wait for an update of push-type elements without occupying a thread. The read notification listener is set on
+       * the elements with _setListener, and each notification calls _tryRead, which must receive an update without
+       * blocking and return whether there was one. The coroutine is then resumed from the notifying thread. _tryRead
+       * is called with the state's mutex held, so it is only called while the awaiter exists.
+       *
+       * Returns false if the update has already been received here, so the coroutine must not be suspended.
+       */
+      bool suspendUntilUpdate(std::coroutine_handle<> handle) {
+        auto listener = [state = _state, this] {
+          std::coroutine_handle<> handleToResume;
+          {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if(state->cancelled || !state->isListening || !tryReceive()) {
+              return;
+            }
+            state->isListening = false;
+            _setListener({});
+            handleToResume = state->handle;
+          }
+          handleToResume.resume();
+        };
+
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        _state->handle = handle;
+        _setListener(listener);
+        _state->isListening = true;
+        // an update might have arrived before the listener was set
+        if(tryReceive()) {
+          _state->isListening = false;
+          _setListener({});
+          return false;
+        }
+        return true;
+      }
+
+      void rethrowException() const {
+        if(_exception) {
+          std::rethrow_exception(_exception);
+        }
+      }
+
+      std::shared_ptr<State> _state{std::make_shared<State>()};
+      std::exception_ptr _exception;
+
+      /// Set (or with an empty function remove) the read notification listener. Only used by suspendUntilUpdate().
+      std::function<void(const std::function<void()>&)> _setListener;
+
+      /// Try to receive an update without blocking. Only used by suspendUntilUpdate().
+      std::function<bool()> _tryRead;
+
+     private:
+      /// Call _tryRead. An exception counts as received update and is rethrown in await_resume().
+      bool tryReceive() {
+        try {
+          return _tryRead();
+        }
+        catch(...) {
+          _exception = std::current_exception();
+          return true;
+        }
+      }
+    };
+
+    /******************************************************************************************************************/
+
+    /** Awaiter of awaitRead() for accessors. */
+    class ReadAwaiter : public TransferAwaiterBase {
+     public:
+      explicit ReadAwaiter(TransferElementAbstractor& accessor) : _accessor(accessor) {}
+
+      /** Push-type accessors complete immediately if an update is already queued. */
+      bool await_ready() {
+        return _accessor.getAccessModeFlags().has(AccessMode::wait_for_new_data) && _accessor.readNonBlocking();
+      }
+
+      bool await_suspend(std::coroutine_handle<> handle) {
+        auto element = _accessor.getHighLevelImplElement();
+        if(_accessor.getAccessModeFlags().has(AccessMode::wait_for_new_data)) {
+          _setListener = [element](const std::function<void()>& listener) {
+            element->setReadNotificationListener(listener);
+          };
+          _tryRead = [this] { return _accessor.readNonBlocking(); };
+          return suspendUntilUpdate(handle);
+        }
+        _state->handle = handle;
+        element->readAsyncTransfer([state = _state, this](const std::exception_ptr& exception) {
+          complete(state, [&] { _exception = exception; });
+        });
+        return true;
+      }
+
+      void await_resume() const { rethrowException(); }
+
+     protected:
+      TransferElementAbstractor& _accessor;
+    };
+
+    /******************************************************************************************************************/
+
+    /** Awaiter of awaitWrite() for accessors. */
+    class WriteAwaiter : public TransferAwaiterBase {
+     public:
+      WriteAwaiter(TransferElementAbstractor& accessor, VersionNumber versionNumber)
+      : _accessor(accessor), _versionNumber(versionNumber) {}
+
+      void await_suspend(std::coroutine_handle<> handle) {
+        _state->handle = handle;
+        _accessor.writeAsyncTransfer(
+            [state = _state, this](bool previousDataLost, const std::exception_ptr& exception) {
+              complete(state, [&] {
+                _previousDataLost = previousDataLost;
+                _exception = exception;
+              });
+            },
+            _versionNumber);
+      }
+
+      bool await_resume() const {
+        rethrowException();
+        return _previousDataLost;
+      }
+
+     protected:
+      TransferElementAbstractor& _accessor;
+      VersionNumber _versionNumber;
+      bool _previousDataLost{false};
+    };
+
+    /******************************************************************************************************************/
+
+    /** Awaiter of awaitRead() and awaitWrite() for TransferGroups. */
+    class TransferGroupAwaiter : public TransferAwaiterBase {
+     public:
+      TransferGroupAwaiter(TransferGroup& group, bool isWrite, VersionNumber versionNumber)
+      : _group(group), _isWrite(isWrite), _versionNumber(versionNumber) {}
+
+      void await_suspend(std::coroutine_handle<> handle) {
+        _state->handle = handle;
+        auto onCompletion = [state = _state, this](const std::exception_ptr& exception) {
+          complete(state, [&] { _exception = exception; });
+        };
+        if(_isWrite) {
+          _group.writeAsyncTransfer(onCompletion, _versionNumber);
+        }
+        else {
+          _group.readAsyncTransfer(onCompletion);
+        }
+      }
+
+      void await_resume() const { rethrowException(); }
+
+     protected:
+      TransferGroup& _group;
+      bool _isWrite;
+      VersionNumber _versionNumber;
+    };
+
+    /******************************************************************************************************************/
+
+    /** Awaiter of awaitReadAny(). */
+    class ReadAnyAwaiter : public TransferAwaiterBase {
+     public:
+      explicit ReadAnyAwaiter(ReadAnyGroup& group) : _group(group) {}
+
+      /** Completes immediately if an update is already queued. */
+      bool await_ready() { return tryReadAny(); }
+
+      bool await_suspend(std::coroutine_handle<> handle) {
+        _setListener = [this](const std::function<void()>& listener) { _group.setReadNotificationListener(listener); };
+        _tryRead = [this] { return tryReadAny(); };
+        return suspendUntilUpdate(handle);
+      }
+
+      TransferElementID await_resume() const {
+        rethrowException();
+        return _id;
+      }
+
+     protected:
+      /** Receive the next update like readAnyNonBlocking(), but without transfers of the poll-type elements if nothing
+       *  is queued. Returns whether an update has been received. */
+      bool tryReadAny() {
+        auto notification = _group.waitAnyNonBlocking();
+        while(notification.isReady()) {
+          if(notification.accept()) {
+            _group.processPolled();
+            _id = notification.getId();
+            return true;
+          }
+          notification = _group.waitAnyNonBlocking();
+        }
+        return false;
+      }
+
+      ReadAnyGroup& _group;
+      TransferElementID _id;
+    };
+
+  } // namespace detail
+
+  /********************************************************************************************************************/
+
+  /**
+   * Read the accessor like TransferElement::read() when awaited. Poll-type accessors are read in the backend's
+   * AsyncTransferPool (see TransferElement::readAsyncTransfer()). Push-type accessors complete without suspension if an
+   * update is already queued, otherwise the coroutine is resumed from the thread which delivers the update. Throws a
+   * ChimeraTK::logic_error if the accessor does not support TransferElement::setReadNotificationListener().
+   */
+  inline detail::ReadAwaiter awaitRead(TransferElementAbstractor& accessor) {
+    return detail::ReadAwaiter(accessor);
+  }
+
+  /**
+   * Write the accessor like TransferElement::write() when awaited, in the backend's AsyncTransferPool. The result of
+   * the co_await is the return value of write().
+   */
+  inline detail::WriteAwaiter awaitWrite(TransferElementAbstractor& accessor, VersionNumber versionNumber = {}) {
+    return {accessor, versionNumber};
+  }
+
+  /** Read the TransferGroup like TransferGroup::read() when awaited, see TransferGroup::readAsyncTransfer(). */
+  inline detail::TransferGroupAwaiter awaitRead(TransferGroup& group) {
+    return {group, false, {}};
+  }
+
+  /** Write the TransferGroup like TransferGroup::write() when awaited, see TransferGroup::writeAsyncTransfer(). */
+  inline detail::TransferGroupAwaiter awaitWrite(TransferGroup& group, VersionNumber versionNumber = {}) {
+    return {group, true, versionNumber};
+  }
+
+  /**
+   * Read the next update of the ReadAnyGroup like ReadAnyGroup::readAny() when awaited. The result of the co_await is
+   * the ID of the updated element. Completes without suspension if an update is already queued, otherwise the
+   * coroutine is resumed from the thread which delivers the update, like for awaitRead().
+   */
+  inline detail::ReadAnyAwaiter awaitReadAny(ReadAnyGroup& group) {
+    return detail::ReadAnyAwaiter(group);
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -0,0 +1,99 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "NDRegisterAccessorDecorator.h"
+
+#include <deque>
+#include <vector>
+
+namespace ChimeraTK::detail {
+
+  /********************************************************************************************************************/
+
+  /**
+   * Type-independent interface of the DataConsistencyDecorator, used by the DataConsistencyGroup.
+   */
+  class DataConsistencyDecoratorBase {
+   public:
+    virtual ~DataConsistencyDecoratorBase() = default;
+
+    /** Number of values in the history. */
+    [[nodiscard]] virtual size_t getHistorySize() const = 0;
+
+    /** VersionNumber of the value with the given index in the history. Index 0 is the oldest value. */
+    [[nodiscard]] virtual VersionNumber getHistoryVersion(size_t index) const = 0;
+
+    /** Put the value with the given index in the history into the user buffer (including VersionNumber and
+     *  DataValidity). This value and all older values are removed from the history, their VersionNumbers (except the
+     *  restored one) are appended to droppedVersions. */
+    virtual void restore(size_t index, std::vector<VersionNumber>& droppedVersions) = 0;
+
+    /** Append the VersionNumbers of values which have been dropped from the history because it was full, and forget
+     *  them. */
+    virtual void takeOverflowVersions(std::vector<VersionNumber>& droppedVersions) = 0;
+  };
+
+  /********************************************************************************************************************/
+
+  /**
+   * Decorator used by the DataConsistencyGroup in the historized matching modes. It keeps a copy of the most recent
+   * values received by the target, so the group can put an older value back into the user buffer when a consistent set
+   * is found.
+   */
+  template<typename UserType>
+  class DataConsistencyDecorator : public NDRegisterAccessorDecorator<UserType>, public DataConsistencyDecoratorBase {
+   public:
+    DataConsistencyDecorator(const boost::shared_ptr<NDRegisterAccessor<UserType>>& target, size_t historyLength)
+    : NDRegisterAccessorDecorator<UserType>(target), _historyLength(historyLength) {}
+
+    void doPostRead(TransferType type, bool updateDataBuffer) override {
+      NDRegisterAccessorDecorator<UserType>::doPostRead(type, updateDataBuffer);
+      if(!updateDataBuffer) return;
+      if(_history.size() == _historyLength) {
+        _overflowVersions.push_back(_history.front().versionNumber);
+        _history.pop_front();
+      }
+      _history.push_back({buffer_2D, this->_versionNumber, this->_dataValidity});
+    }
+
+    [[nodiscard]] size_t getHistorySize() const override { return _history.size(); }
+
+    [[nodiscard]] VersionNumber getHistoryVersion(size_t index) const override {
+      return _history[index].versionNumber;
+    }
+
+    void restore(size_t index, std::vector<VersionNumber>& droppedVersions) override {
+      for(size_t i = 0; i < index; ++i) {
+        droppedVersions.push_back(_history.front().versionNumber);
+        _history.pop_front();
+      }
+      auto& entry = _history.front();
+      buffer_2D.swap(entry.buffer);
+      this->_versionNumber = entry.versionNumber;
+      this->_dataValidity = entry.dataValidity;
+      _history.pop_front();
+    }
+
+    void takeOverflowVersions(std::vector<VersionNumber>& droppedVersions) override {
+      droppedVersions.insert(droppedVersions.end(), _overflowVersions.begin(), _overflowVersions.end());
+      _overflowVersions.clear();
+    }
+
+   protected:
+    struct HistoryEntry {
+      std::vector<std::vector<UserType>> buffer;
+      VersionNumber versionNumber;
+      DataValidity dataValidity;
+    };
+
+    size_t _historyLength;
+    std::deque<HistoryEntry> _history;
+    std::vector<VersionNumber> _overflowVersions;
+
+    using NDRegisterAccessorDecorator<UserType>::buffer_2D;
+  };
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK::detail
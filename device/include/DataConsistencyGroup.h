@@ -4,10 +4,17 @@
 
 #include "TransferElementAbstractor.h"
 #include "VersionNumber.h"
+
+#include <chrono>
 #include <unordered_set>
+#include <vector>
 
 namespace ChimeraTK {
 
+  namespace detail {
+    class DataConsistencyDecoratorBase;
+  } // namespace detail
+
   /********************************************************************************************************************/
 
   /**
@@ -15,6 +22,12 @@ namespace ChimeraTK {
    * algorithm which matches the VersionNumber. This group does not read on its own. It should work together with a
    * ReadAnyGroup. You should wait for changed variable and transfer it to this group by calling
    * ChimeraTK::DataConsistencyGroup::update. If a consistent state is reached, this function returns true.
+   *
+   * In the historized matching modes, the group keeps a history of the most recent values of each element. A
+   * consistent set can then also be assembled if the updates of the elements arrive out of order, e.g. if one element
+   * is one event late. For this, the group replaces the implementation of each added element with a decorator which
+   * records the values. Hence the elements must be added to the DataConsistencyGroup before they are added to a
+   * ReadAnyGroup, and the matching mode and history length must be set before adding elements.
    */
   class DataConsistencyGroup {
    public:
@@ -29,26 +42,49 @@ namespace ChimeraTK {
     DataConsistencyGroup(ITERATOR first, ITERATOR last);
 
     /** Add register to group. The same TransferElement can be part of multiple DataConsistencyGroups. The register
-     *  must be must be readable, and it must have AccessMode::wait_for_new_data. */
+     *  must be must be readable, and it must have AccessMode::wait_for_new_data.
+     *
+     *  In the historized matching modes, the element must be passed as non-const reference, since its implementation
+     *  is replaced (see class description). Otherwise a ChimeraTK::logic_error is thrown. */
+    void add(TransferElementAbstractor& element);
     void add(const TransferElementAbstractor& element);
     void add(boost::shared_ptr<TransferElement> element);
 
     /** This function updates consistentElements, a set of TransferElementID. It returns true, if a consistent state is
-     *  reached. It returns false if an TransferElementID was updated, that was not added to this Group. */
+     *  reached. It returns false if an TransferElementID was updated, that was not added to this Group.
+     *
+     *  In the historized matching modes, the user buffers of all elements are set to the values of the consistent set
+     *  when true is returned. */
     bool update(const TransferElementID& transferelementid);
 
     /** Enum describing the matching mode of a DataConsistencyGroup. */
     enum class MatchingMode {
-      none, ///< No matching, effectively disable the DataConsitencyGroup. update() will always return true.
-      exact ///< Require an exact match of the VersionNumber of all current values of the group's members.
+      none,       ///< No matching, effectively disable the DataConsitencyGroup. update() will always return true.
+      exact,      ///< Require an exact match of the VersionNumber of all current values of the group's members.
+      historized, ///< Require an exact match of the VersionNumber, searching the history of each member.
+      timeWindow  ///< Require the time stamps of the VersionNumbers to be within the tolerance, searching the history.
     };
 
-    /** Change the matching mode. The default mode is MatchingMode::exact. */
-    void setMatchingMode(MatchingMode newMode) { mode = newMode; }
+    /** Change the matching mode. The default mode is MatchingMode::exact. Switching to or from one of the historized
+     *  modes is only allowed while the group is empty, otherwise a ChimeraTK::logic_error is thrown. */
+    void setMatchingMode(MatchingMode newMode);
 
     /** Return the current matching mode. */
     MatchingMode getMatchingMode() const { return mode; };
 
+    /** Set the number of values kept per element in the historized matching modes. The default is 16. Must be called
+     *  while the group is empty, otherwise a ChimeraTK::logic_error is thrown. */
+    void setHistoryLength(size_t length);
+
+    /** Set the maximum difference between the time stamps of the VersionNumbers in MatchingMode::timeWindow. */
+    void setTolerance(std::chrono::nanoseconds tolerance) { _tolerance = tolerance; }
+
+    /** Return the VersionNumbers of values which have been given up during the last call to update(), because they can
+     *  no longer become part of a consistent set (historized matching modes only). These are the events for which at
+     *  least one element has not delivered a value in time. The list is sorted and free of duplicates. A VersionNumber
+     *  can be reported again by a later call to update(), if other elements give up their values for it later. */
+    const std::vector<VersionNumber>& getIncompleteVersions() const { return _incompleteVersions; }
+
    private:
     /// A set of TransferElementID, that were updatet with update();
     std::unordered_set<TransferElementID> consistentElements;
@@ -63,6 +99,21 @@ namespace ChimeraTK {
 
     /// the matching mode used in update()
     MatchingMode mode{MatchingMode::exact};
+
+    /// Implementation of update() for the historized matching modes
+    bool updateHistorized(const TransferElementID& transferElementID);
+
+    /// Decorators holding the history of the elements, only used in the historized matching modes
+    std::map<TransferElementID, boost::shared_ptr<detail::DataConsistencyDecoratorBase>> _decorators;
+
+    /// See setHistoryLength()
+    size_t _historyLength{16};
+
+    /// See setTolerance()
+    std::chrono::nanoseconds _tolerance{0};
+
+    /// See getIncompleteVersions()
+    std::vector<VersionNumber> _incompleteVersions;
   };
 
   /********************************************************************************************************************/
@@ -81,7 +132,9 @@ namespace ChimeraTK {
     }
     // if matching mode is none, always return true
     if(mode == MatchingMode::none) return true;
-    assert(mode == MatchingMode::exact);
+    if(mode != MatchingMode::exact) {
+      return updateHistorized(transferElementID);
+    }
 
     auto getVNFromElement = push_elements[transferElementID].getVersionNumber();
     assert(getVNFromElement != VersionNumber{nullptr});
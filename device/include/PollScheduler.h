@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "AsyncAccessorManager.h"
+#include "DeviceBackend.h"
+#include "OneDRegisterAccessor.h"
+#include "ScalarRegisterAccessor.h"
+#include "TimerInterruptSource.h"
+#include "TransferGroup.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ChimeraTK {
+
+  namespace detail {
+
+    /** Typeless base class of the PollAsyncVariable. */
+    struct PollAsyncVariableBase {
+      virtual ~PollAsyncVariableBase() = default;
+
+      /** Create a new synchronous accessor to the register of the variable, to be read in a TransferGroup. */
+      virtual boost::shared_ptr<TransferElement> createSyncAccessor() = 0;
+
+      /** Fill the send buffer from the given synchronous accessor, which must have been created by
+       *  createSyncAccessor(). The given version is used. */
+      virtual void fillSendBuffer(TransferElement& syncAccessor, VersionNumber const& version) = 0;
+    };
+
+    /** AsyncVariable of the PollScheduler. It creates the synchronous accessors which are read in the TransferGroups of
+     *  the scheduler. */
+    template<typename UserType>
+    struct PollAsyncVariable : public AsyncVariableImpl<UserType>, public PollAsyncVariableBase {
+      PollAsyncVariable(boost::shared_ptr<DeviceBackend> backend_, AccessorInstanceDescriptor descriptor_,
+          boost::shared_ptr<NDRegisterAccessor<UserType>> syncAccessor_);
+
+      boost::shared_ptr<TransferElement> createSyncAccessor() final;
+
+      void fillSendBuffer(TransferElement& syncAccessor_, VersionNumber const& version) final;
+
+      boost::shared_ptr<DeviceBackend> backend;
+      AccessorInstanceDescriptor descriptor;
+
+      /// Accessor created on subscription. It provides the initial value and the information about the register.
+      boost::shared_ptr<NDRegisterAccessor<UserType>> syncAccessor;
+
+      unsigned int getNumberOfChannels() override { return syncAccessor->getNumberOfChannels(); }
+      unsigned int getNumberOfSamples() override { return syncAccessor->getNumberOfSamples(); }
+      const std::string& getUnit() override { return syncAccessor->getUnit(); }
+      const std::string& getDescription() override { return syncAccessor->getDescription(); }
+      bool isWriteable() override { return false; }
+    };
+
+    /** All subscriptions of a PollScheduler with the same period. The group manages the subscriptions and their
+     *  activation state. The registers are read by the PollScheduler, together with the other groups which are due
+     *  in the same tick.
+     *
+     *  Like the NumericAddressedInterruptDispatcher, the group only holds the _variablesMutex to take a snapshot of the
+     *  subscribed variables or to activate them, but not while sending data.
+     */
+    class PollGroup : public AsyncAccessorManager {
+     public:
+      PollGroup();
+
+      using AsyncAccessorManager::AsyncVariableList;
+
+      template<typename UserType>
+      std::unique_ptr<AsyncVariable> createAsyncVariable(
+          const boost::shared_ptr<DeviceBackend>& backend, AccessorInstanceDescriptor const& descriptor, bool isActive);
+
+      /** The variables are activated by distribute() with the first tick at which the backend is functional. This
+       *  function does nothing. */
+      VersionNumber activate() override { return {}; }
+
+      /** Return the current snapshot of the subscribed variables. */
+      std::shared_ptr<const AsyncVariableList> getAsyncVariableList();
+
+      /** Send the data of the given synchronous accessors to the subscribers. The accessors have been created for the
+       *  given snapshot of the variables (same index) and have just been read. If the group is not active yet, it is
+       *  activated instead. This only happens if the snapshot is still current, so no new subscription can be missed.
+       */
+      void distribute(const std::shared_ptr<const AsyncVariableList>& variables,
+          const std::vector<boost::shared_ptr<TransferElement>>& syncAccessors, VersionNumber const& version);
+
+      /** Handle a backend which is not functional: If the backend has an active exception, it is sent to the
+       *  subscribers. If the backend has been closed, the subscribers are deactivated. */
+      void handleFaultyBackend(const boost::shared_ptr<DeviceBackend>& backend);
+    };
+
+  } // namespace detail
+
+  /********************************************************************************************************************/
+
+  /**
+   * Service which reads registers periodically and publishes the data through push-type accessors
+   * (AccessMode::wait_for_new_data). Consumers which only need a register at a certain rate subscribe to it instead of
+   * reading it on their own schedule, so each register is only transferred once per period, no matter how many
+   * consumers use it.
+   *
+   * The periods are rounded to a multiple of the tick of the scheduler. All subscriptions with the same period form a
+   * group. The groups are read by a single thread. In each tick, all groups which are due are read together in a
+   * single TransferGroup, so a register used with several periods is still transferred only once per tick.
+   *
+   * The accessors are activated by the scheduler itself: The initial value is sent with the first tick of the period
+   * at which the backend is functional. If the backend reports an exception, it is sent to the accessors, and new
+   * initial values are sent once the backend has recovered. Device::activateAsyncRead() has no influence on these
+   * accessors.
+   *
+   * The scheduler must be kept alive as long as its accessors are used. Missed ticks are skipped (see
+   * TimerInterruptSource).
+   */
+  class PollScheduler {
+   public:
+    using Duration = TimerInterruptSource::Duration;
+
+    /** Return the scheduler shared by all users of the given backend. It is created with the default tick if it does
+     *  not exist yet. */
+    static boost::shared_ptr<PollScheduler> getInstance(const boost::shared_ptr<DeviceBackend>& backend);
+
+    /** Create a scheduler for the given backend. The clock can be replaced for tests. */
+    explicit PollScheduler(boost::shared_ptr<DeviceBackend> backend, Duration tick = std::chrono::milliseconds(10),
+        std::shared_ptr<TimerInterruptSource::Clock> clock = std::make_shared<TimerInterruptSource::SteadyClock>());
+
+    /** Get a push-type accessor to the given register which is updated with the given period. The period is rounded to
+     *  a multiple of the tick, but is at least one tick. The flags are used for the synchronous accessor which is
+     *  read by the scheduler. AccessMode::wait_for_new_data is added for the returned accessor. */
+    template<typename UserType>
+    boost::shared_ptr<NDRegisterAccessor<UserType>> getRegisterAccessor(const RegisterPath& registerPathName,
+        Duration period, size_t numberOfWords = 0, size_t wordOffsetInRegister = 0, AccessModeFlags flags = {});
+
+    /** Convenience function returning a ScalarRegisterAccessor. See getRegisterAccessor(). */
+    template<typename UserType>
+    ScalarRegisterAccessor<UserType> getScalarRegisterAccessor(const RegisterPath& registerPathName, Duration period,
+        size_t wordOffsetInRegister = 0, const AccessModeFlags& flags = {}) {
+      return ScalarRegisterAccessor<UserType>(
+          getRegisterAccessor<UserType>(registerPathName, period, 1, wordOffsetInRegister, flags));
+    }
+
+    /** Convenience function returning a OneDRegisterAccessor. See getRegisterAccessor(). */
+    template<typename UserType>
+    OneDRegisterAccessor<UserType> getOneDRegisterAccessor(const RegisterPath& registerPathName, Duration period,
+        size_t numberOfWords = 0, size_t wordOffsetInRegister = 0, const AccessModeFlags& flags = {}) {
+      return OneDRegisterAccessor<UserType>(
+          getRegisterAccessor<UserType>(registerPathName, period, numberOfWords, wordOffsetInRegister, flags));
+    }
+
+    /** Return the tick of the scheduler. */
+    [[nodiscard]] Duration getTick() const { return _timer.getPeriod(); }
+
+    /** Return the number of distinct periods, i.e. the number of groups of subscriptions. */
+    [[nodiscard]] size_t getNumberOfPollGroups();
+
+    /** Return the number of ticks which have been processed. */
+    [[nodiscard]] size_t getTickCount() const { return _tickCount; }
+
+   protected:
+    /** Called by the timer for each tick. Polls all groups whose period is due. */
+    void tick();
+
+    /** Return the group for the given period, creating it if needed. Starts the timer. */
+    boost::shared_ptr<detail::PollGroup> getPollGroup(Duration period);
+
+    /** TransferGroup reading all variables of the groups which are due in the same tick. */
+    struct ReadPlan {
+      /// Snapshots of the variables of the groups the plan has been created for
+      std::vector<std::shared_ptr<const detail::PollGroup::AsyncVariableList>> variableLists;
+
+      /// Synchronous accessors for the variables in variableLists (same indices)
+      std::vector<std::vector<boost::shared_ptr<TransferElement>>> syncAccessors;
+
+      TransferGroup transferGroup;
+      bool isEmpty{true};
+    };
+
+    /** Read the given due groups with their periods in ticks, and send the data to the subscribers. */
+    void poll(const std::vector<size_t>& periods, const std::vector<boost::shared_ptr<detail::PollGroup>>& groups);
+
+    /** Return the ReadPlan for the given due groups. The plan is created again if the subscriptions have changed. */
+    ReadPlan& getReadPlan(const std::vector<size_t>& periods,
+        const std::vector<boost::shared_ptr<detail::PollGroup>>& groups);
+
+    boost::shared_ptr<DeviceBackend> _backend;
+
+    /// Protects _groups
+    std::mutex _groupsMutex;
+
+    /// The groups by their period in ticks
+    std::map<size_t, boost::shared_ptr<detail::PollGroup>> _groups;
+
+    /// The ReadPlans by the periods of the due groups. Only used by the timer thread.
+    std::map<std::vector<size_t>, std::unique_ptr<ReadPlan>> _readPlans;
+
+    std::atomic<size_t> _tickCount{0};
+
+    /// Declared last, so the thread is stopped before the other members are destroyed
+    TimerInterruptSource _timer;
+  };
+
+  /********************************************************************************************************************/
+  /* Implementations */
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  boost::shared_ptr<NDRegisterAccessor<UserType>> PollScheduler::getRegisterAccessor(
+      const RegisterPath& registerPathName, Duration period, size_t numberOfWords, size_t wordOffsetInRegister,
+      AccessModeFlags flags) {
+    flags.add(AccessMode::wait_for_new_data);
+    return getPollGroup(period)->subscribe<UserType>(
+        _backend, registerPathName, numberOfWords, wordOffsetInRegister, flags);
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  std::unique_ptr<AsyncVariable> detail::PollGroup::createAsyncVariable(
+      const boost::shared_ptr<DeviceBackend>& backend, AccessorInstanceDescriptor const& descriptor, bool isActive) {
+    auto synchronousFlags = descriptor.flags;
+    synchronousFlags.remove(AccessMode::wait_for_new_data);
+    auto syncAccessor = backend->getRegisterAccessor<UserType>(
+        descriptor.name, descriptor.numberOfWords, descriptor.wordOffsetInRegister, synchronousFlags);
+    if(!syncAccessor->isReadable()) {
+      throw ChimeraTK::logic_error("PollScheduler: Register " + descriptor.name + " is not readable.");
+    }
+    // read the initial value
+    if(isActive) {
+      try {
+        syncAccessor->read();
+      }
+      catch(ChimeraTK::runtime_error&) {
+        isActive = false;
+      }
+    }
+
+    return std::make_unique<PollAsyncVariable<UserType>>(backend, descriptor, syncAccessor);
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  detail::PollAsyncVariable<UserType>::PollAsyncVariable(boost::shared_ptr<DeviceBackend> backend_,
+      AccessorInstanceDescriptor descriptor_, boost::shared_ptr<NDRegisterAccessor<UserType>> syncAccessor_)
+  : AsyncVariableImpl<UserType>(syncAccessor_->getNumberOfChannels(), syncAccessor_->getNumberOfSamples()),
+    backend(std::move(backend_)), descriptor(std::move(descriptor_)), syncAccessor(std::move(syncAccessor_)) {
+    PollAsyncVariable<UserType>::fillSendBuffer(*syncAccessor, {});
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  boost::shared_ptr<TransferElement> detail::PollAsyncVariable<UserType>::createSyncAccessor() {
+    auto synchronousFlags = descriptor.flags;
+    synchronousFlags.remove(AccessMode::wait_for_new_data);
+    return backend->getRegisterAccessor<UserType>(
+        descriptor.name, descriptor.numberOfWords, descriptor.wordOffsetInRegister, synchronousFlags);
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  void detail::PollAsyncVariable<UserType>::fillSendBuffer(TransferElement& syncAccessor_, VersionNumber const& version) {
+    auto& accessor = dynamic_cast<NDRegisterAccessor<UserType>&>(syncAccessor_);
+    this->_sendBuffer.versionNumber = version;
+    this->_sendBuffer.dataValidity = accessor.dataValidity();
+    this->_sendBuffer.value.swap(accessor.accessChannels());
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
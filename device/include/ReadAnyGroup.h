@@ -8,7 +8,15 @@
 
 #include <ChimeraTK/cppext/future_queue.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace ChimeraTK {
 
@@ -142,13 +150,26 @@ namespace ChimeraTK {
      * given register may not yet be part of a ReadAnyGroup or a TransferGroup, otherwise an exception is thrown.
      *
      * The register must be must be readable.
+     *
+     * The priority is only relevant for elements with AccessMode::wait_for_new_data. If pending updates exist for
+     * elements with different priorities, the update of the element with the highest priority is processed first.
+     * Updates of elements with the same priority are processed in the order of arrival. To avoid starvation of low
+     * priority elements, see setStarvationLimit(). If all elements have the same priority (the default), all updates
+     * are processed in the order of arrival.
      */
-    void add(const TransferElementAbstractor& element);
+    void add(const TransferElementAbstractor& element, int priority = 0);
 
     /**
      * See the other signature of add().
      */
-    void add(boost::shared_ptr<TransferElement> element);
+    void add(boost::shared_ptr<TransferElement> element, int priority = 0);
+
+    /**
+     * Set the maximum number of updates which are processed in a row ahead of a pending update with lower priority.
+     * When the limit is reached, the oldest pending update is processed next, regardless of its priority. The default
+     * is 100. Only relevant if elements with different priorities have been added.
+     */
+    void setStarvationLimit(size_t limit) { _starvationLimit = limit; }
 
     /**
      * Finalise the group. From this point on, add() may no longer be called. Only after the group has been finalised
@@ -171,7 +192,8 @@ namespace ChimeraTK {
      * Wait until one of the elements in this group has received an update. The function will return the
      * TransferElementID of the element which has received the update. If multiple updates are received at the same time
      * or if multiple updates were already present before the call to this function, the ID of the first element
-     * receiving an update will be returned.
+     * receiving an update will be returned. If elements have been added with different priorities, the ID of the
+     * element with the highest priority will be returned instead (see add()).
      *
      * Only elements with AccessMode::wait_for_new_data are used for waiting. Once an update has been received for one
      * of these elements, the function will call readLatest() on all elements without AccessMode::wait_for_new_data
@@ -184,6 +206,15 @@ namespace ChimeraTK {
      */
     TransferElementID readAny();
 
+    /**
+     * Like readAny(), but return runtime errors and interruptions as TransferResult instead of throwing them. The value
+     * of a successful result is the ID of the updated element. The poll-type elements are read with
+     * TransferElement::tryRead(), so no exception is thrown for them while their backend is in an exception state.
+     *
+     * Before calling this function, finalise() must have been called, otherwise the behaviour is undefined.
+     */
+    TransferResult<TransferElementID> tryReadAny();
+
     /**
      * Read the next available update in the group, but do not block if no update is available. If no update is
      * available, a default-constructed TransferElementID is returned after all poll-type elements in the group have
@@ -193,6 +224,42 @@ namespace ChimeraTK {
      */
     TransferElementID readAnyNonBlocking();
 
+    /**
+     * Like readAny(), but wait at most until the given deadline. If no update has been received until then, a
+     * default-constructed TransferElementID is returned. No exception is thrown in that case, and the poll-type
+     * elements are not updated.
+     *
+     * Before calling this function, finalise() must have been called, otherwise the behaviour is undefined.
+     */
+    TransferElementID readAnyUntil(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * Wait until one of the elements in this group has received an update, then process all further updates which are
+     * already available without blocking again, up to maxCount updates in total. The IDs of the TransferElements are
+     * returned in the order the updates have been received. An element appears multiple times if multiple updates of
+     * it have been processed.
+     *
+     * postRead is called for each returned update, so all read data is present in the user buffers. The poll-type
+     * elements are updated only once, after all updates have been processed. This is more efficient than calling
+     * readAny() in a loop when many updates arrive at a high rate.
+     *
+     * If an exception is thrown for the first update, it is thrown by this function like by readAny(). If it is thrown
+     * for a later update, the IDs of the updates processed before are returned without updating the poll-type
+     * elements, and the exception is thrown by the next call to one of the read or wait functions of this group.
+     *
+     * Before calling this function, finalise() must have been called, otherwise the behaviour is undefined.
+     */
+    std::vector<TransferElementID> readAnyBatch(size_t maxCount = std::numeric_limits<size_t>::max());
+
+    /**
+     * Like readAnyBatch(), but wait at most until the given deadline for the first update. If no update has been
+     * received until then, an empty vector is returned. No exception is thrown in that case, and the poll-type elements
+     * are not updated.
+     *
+     * Before calling this function, finalise() must have been called, otherwise the behaviour is undefined.
+     */
+    std::vector<TransferElementID> readAnyBatch(size_t maxCount, std::chrono::steady_clock::time_point deadline);
+
     /**
      * Wait until the given TransferElement has received an update and store it to its user buffer. All updates of other
      * elements which are received before the update of the given element will be processed and are thus visible in the
@@ -252,6 +319,18 @@ namespace ChimeraTK {
      */
     Notification waitAnyNonBlocking();
 
+    /**
+     * Like waitAny(), but wait at most until the given deadline. If no update has been received until then, an invalid
+     * Notification object is returned (i.e. Notification::isReady() will return false). When the deadline is reached
+     * while waiting, a notification may be returned whose accept() returns false, like for a discarded value. Calling
+     * this function again then returns the invalid Notification object.
+     *
+     * Before calling this function, finalise() must have been called, otherwise the behaviour is undefined.
+     *
+     * The returned Notification object is only valid as long as the ReadAnyGroup still exists.
+     */
+    Notification waitAnyUntil(std::chrono::steady_clock::time_point deadline);
+
     /**
      * Process polled transfer elements (update them if new values are available).
      *
@@ -265,10 +344,38 @@ namespace ChimeraTK {
      */
     void interrupt() { push_elements.front().getHighLevelImplElement()->interrupt(); }
 
+    /**
+     * Set the read notification listener of all push-type TransferElements in the group (see
+     * TransferElement::setReadNotificationListener()). An empty function removes it again.
+     */
+    void setReadNotificationListener(const std::function<void()>& listener) {
+      for(auto& element : push_elements) {
+        element.getHighLevelImplElement()->setReadNotificationListener(listener);
+      }
+    }
+
    private:
     /// Call preRead() on the push_elements which need it
     void handlePreRead();
 
+    /// Process further updates which are already available for readAnyBatch(), after the first update has been added to
+    /// ids.
+    void completeBatch(std::vector<TransferElementID>& ids, size_t maxCount);
+
+    /// Throw the exception deferred by completeBatch(), if any
+    void rethrowDeferredException();
+
+    /// Move all notifications from the notification_queue into the per-priority lists of pending updates. Only used if
+    /// priorities are in use.
+    void collectPending();
+
+    /// Return the priority of the pending update which is to be processed next. The list of pending updates must not
+    /// be empty.
+    int selectPending() const;
+
+    /// Remove the pending update which is to be processed next and return its index into push_elements.
+    std::size_t takePending();
+
     /// Flag if this group has been finalised already
     bool isFinalised{false};
 
@@ -281,10 +388,33 @@ namespace ChimeraTK {
     /// The notification queue, will be valid only if isFinalised == true
     cppext::future_queue<size_t> notification_queue;
 
+    /// Priorities of the push_elements (same index)
+    std::vector<int> _priorities;
+
+    /// Flag whether the push_elements have different priorities. If not, the notification_queue is used directly.
+    bool _usePriorities{false};
+
+    /// Pending updates taken from the notification_queue, sorted by priority (highest first). Each entry holds the
+    /// index into push_elements and the sequence number of arrival.
+    std::map<int, std::deque<std::pair<std::size_t, std::size_t>>, std::greater<>> _pending;
+
+    /// Sequence number for the next update taken from the notification_queue
+    std::size_t _arrivalCounter{0};
+
+    /// Number of updates processed in a row while an update with lower priority was pending
+    std::size_t _skipCount{0};
+
+    /// See setStarvationLimit()
+    std::size_t _starvationLimit{100};
+
     /// Index into push_elements pointing to the last operation's TransferElementAbstractor, or
     /// std::numeric_limits<size_t>::max() in case there was not yet an operation.
     /// This is used to call preRead() at the beginning of the next operation.
     size_t _lastOperationIndex{std::numeric_limits<size_t>::max()};
+
+    /// Exception of an update in readAnyBatch() which has been processed after other updates. It is thrown by the next
+    /// operation, so the IDs of the other updates can be returned.
+    std::exception_ptr _deferredException;
   };
 
   /********************************************************************************************************************/
@@ -437,7 +567,7 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  inline void ReadAnyGroup::add(const TransferElementAbstractor& element) {
+  inline void ReadAnyGroup::add(const TransferElementAbstractor& element, int priority) {
     if(isFinalised) {
       throw std::logic_error("ReadAnyGroup has already been finalised, calling "
                              "add() is no longer allowed.");
@@ -448,6 +578,7 @@ namespace ChimeraTK {
     }
     if(element.getAccessModeFlags().has(AccessMode::wait_for_new_data)) {
       push_elements.push_back(element);
+      _priorities.push_back(priority);
     }
     else {
       poll_elements.push_back(element);
@@ -456,8 +587,8 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  inline void ReadAnyGroup::add(boost::shared_ptr<TransferElement> element) {
-    add(TransferElementAbstractor(std::move(element)));
+  inline void ReadAnyGroup::add(boost::shared_ptr<TransferElement> element, int priority) {
+    add(TransferElementAbstractor(std::move(element)), priority);
   }
 
   /********************************************************************************************************************/
@@ -477,6 +608,12 @@ namespace ChimeraTK {
       throw std::logic_error("ReadAnyGroup has no element with AccessMode::wait_for_new_data.");
     }
     notification_queue = cppext::when_any(queueList.begin(), queueList.end());
+    for(auto priority : _priorities) {
+      if(priority != _priorities.front()) {
+        _usePriorities = true;
+      }
+      _pending[priority]; // create all lists now to avoid modifying the map later
+    }
     isFinalised = true;
   }
 
@@ -495,6 +632,33 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  inline TransferResult<TransferElementID> ReadAnyGroup::tryReadAny() {
+    Notification notification;
+    try {
+      do {
+        notification = this->waitAny();
+      } while(!notification.accept());
+    }
+    catch(ChimeraTK::runtime_error&) {
+      return {TransferStatus::runtimeError, std::current_exception()};
+    }
+    catch(boost::thread_interrupted&) {
+      return {TransferStatus::interrupted, std::current_exception()};
+    }
+
+    for(auto& e : poll_elements) {
+      if(e.getAccessModeFlags().has(AccessMode::wait_for_new_data)) continue;
+      auto result = e.tryRead();
+      if(!result) {
+        return TransferResult<TransferElementID>(result);
+      }
+    }
+
+    return notification.getId();
+  }
+
+  /********************************************************************************************************************/
+
   inline TransferElementID ReadAnyGroup::readAnyNonBlocking() {
     Notification notification;
     do {
@@ -511,6 +675,96 @@ namespace ChimeraTK {
   }
   /********************************************************************************************************************/
 
+  inline TransferElementID ReadAnyGroup::readAnyUntil(std::chrono::steady_clock::time_point deadline) {
+    Notification notification;
+    do {
+      notification = this->waitAnyUntil(deadline);
+      if(!notification.isReady()) {
+        return {};
+      }
+    } while(!notification.accept());
+
+    this->processPolled();
+
+    return notification.getId();
+  }
+
+  /********************************************************************************************************************/
+
+  inline std::vector<TransferElementID> ReadAnyGroup::readAnyBatch(size_t maxCount) {
+    std::vector<TransferElementID> ids;
+    if(maxCount == 0) {
+      return ids;
+    }
+
+    // block only for the first update
+    Notification notification;
+    do {
+      notification = this->waitAny();
+    } while(!notification.accept());
+    ids.push_back(notification.getId());
+
+    completeBatch(ids, maxCount);
+    return ids;
+  }
+
+  /********************************************************************************************************************/
+
+  inline std::vector<TransferElementID> ReadAnyGroup::readAnyBatch(
+      size_t maxCount, std::chrono::steady_clock::time_point deadline) {
+    std::vector<TransferElementID> ids;
+    if(maxCount == 0) {
+      return ids;
+    }
+
+    Notification notification;
+    do {
+      notification = this->waitAnyUntil(deadline);
+      if(!notification.isReady()) {
+        return ids;
+      }
+    } while(!notification.accept());
+    ids.push_back(notification.getId());
+
+    completeBatch(ids, maxCount);
+    return ids;
+  }
+
+  /********************************************************************************************************************/
+
+  inline void ReadAnyGroup::completeBatch(std::vector<TransferElementID>& ids, size_t maxCount) {
+    // drain what is already available
+    try {
+      while(ids.size() < maxCount) {
+        auto notification = this->waitAnyNonBlocking();
+        if(!notification.isReady()) {
+          break;
+        }
+        if(notification.accept()) {
+          ids.push_back(notification.getId());
+        }
+      }
+    }
+    catch(...) {
+      // The data of the updates in ids is already in the user buffers, so their IDs must not get lost. The exception
+      // is thrown by the next operation instead.
+      _deferredException = std::current_exception();
+      return;
+    }
+
+    this->processPolled();
+  }
+
+  /********************************************************************************************************************/
+
+  inline void ReadAnyGroup::rethrowDeferredException() {
+    if(_deferredException) {
+      std::rethrow_exception(std::exchange(_deferredException, nullptr));
+    }
+  }
+
+  /********************************************************************************************************************/
+
   inline void ReadAnyGroup::handlePreRead() {
     // preRead() and postRead() must be called in pairs. Hence we call all preReads here before waiting for transfers to
     // finish. postRead() will be called when accepting the notification. We can call preRead() repeatedly on the same
@@ -535,10 +789,22 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   inline ReadAnyGroup::Notification ReadAnyGroup::waitAny() {
+    rethrowDeferredException();
     handlePreRead();
 
     // Wait for notification
     std::size_t index;
+    if(_usePriorities) {
+      collectPending();
+      if(_pending.at(selectPending()).empty()) {
+        // nothing pending: wait for the next notification and take everything which has arrived in the meantime
+        notification_queue.pop_wait(index);
+        _pending.at(_priorities[index]).emplace_back(index, _arrivalCounter++);
+        collectPending();
+      }
+      index = takePending();
+      return {index, this};
+    }
     notification_queue.pop_wait(index);
     // clazy has a false positive warning about index being uninitialised.
     // NOLINTNEXTLINE(clang-analyzer-core.CallAndMessage)
@@ -547,10 +813,30 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  inline ReadAnyGroup::Notification ReadAnyGroup::waitAnyUntil(std::chrono::steady_clock::time_point deadline) {
+    rethrowDeferredException();
+    if(std::chrono::steady_clock::now() >= deadline) {
+      return waitAnyNonBlocking();
+    }
+
+    // The notification_queue has no timed wait, hence one of the push-type elements is woken up at the deadline. Its
+    // DiscardValueException arrives like an update, so the returned notification cannot be accepted. If an update
+    // arrives first, the DiscardValueException might still be placed, but is discarded later like any other.
+    auto wakeUp = DeadlineTimer::getInstance().schedule(
+        deadline, TransferElement::wakeUpReadFunction(push_elements.front().getHighLevelImplElement()));
+    return waitAny();
+  }
+
+  /********************************************************************************************************************/
+
   inline ReadAnyGroup::Notification ReadAnyGroup::waitAnyNonBlocking() {
+    rethrowDeferredException();
   restart_after_discard_value:
+    if(_usePriorities) {
+      collectPending();
+    }
     // check if update is available
-    if(notification_queue.empty()) {
+    if(_usePriorities ? _pending.at(selectPending()).empty() : notification_queue.empty()) {
       // If no notification is present, do not even execute preRead. This is necessary for two reasons:
       // - We always used TransferType::read to avoid mixing TransferType::read and TransferType::readNonBlocking
       //   in the same transfer of the same variable. We can do this even in this non-blocking case, if we already know
@@ -563,7 +849,7 @@ namespace ChimeraTK {
     }
 
     // if update is available, peek into the queue to check whether a DiscardValueException will be read
-    auto id = notification_queue.front();
+    auto id = _usePriorities ? _pending.at(selectPending()).front().first : notification_queue.front();
     try {
       // call to empty() necessary before call to front(), to gain ownership of front element
       if(push_elements[id].getHighLevelImplElement()->_readQueue.empty()) {
@@ -574,7 +860,12 @@ namespace ChimeraTK {
     }
     catch(detail::DiscardValueException&) {
       // Remove discarded transfer from the queues and go back to square one
-      notification_queue.pop();
+      if(_usePriorities) {
+        _pending.at(selectPending()).pop_front();
+      }
+      else {
+        notification_queue.pop();
+      }
       try {
         push_elements[id].getHighLevelImplElement()->_readQueue.pop();
       }
@@ -604,6 +895,51 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  inline void ReadAnyGroup::collectPending() {
+    std::size_t index;
+    while(notification_queue.pop(index)) {
+      _pending.at(_priorities[index]).emplace_back(index, _arrivalCounter++);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  inline int ReadAnyGroup::selectPending() const {
+    // highest priority with a pending update. If nothing is pending at all, the highest priority is returned.
+    auto top = std::find_if(_pending.begin(), _pending.end(), [](const auto& level) { return !level.second.empty(); });
+    if(top == _pending.end()) {
+      return _pending.begin()->first;
+    }
+    if(_skipCount < _starvationLimit) {
+      return top->first;
+    }
+    // starvation limit reached: select the oldest pending update
+    auto oldest = top;
+    for(auto it = std::next(top); it != _pending.end(); ++it) {
+      if(!it->second.empty() && it->second.front().second < oldest->second.front().second) {
+        oldest = it;
+      }
+    }
+    return oldest->first;
+  }
+
+  /********************************************************************************************************************/
+
+  inline std::size_t ReadAnyGroup::takePending() {
+    auto& level = _pending.at(selectPending());
+    auto index = level.front().first;
+    level.pop_front();
+
+    // count how often a lower priority update has been passed over
+    bool lowerPending = std::any_of(_pending.upper_bound(_priorities[index]), _pending.end(),
+        [](const auto& lowerLevel) { return !lowerLevel.second.empty(); });
+    _skipCount = lowerPending ? _skipCount + 1 : 0;
+
+    return index;
+  }
+
+  /********************************************************************************************************************/
+
   inline void ReadAnyGroup::processPolled() {
     // update all poll-type elements in the group
     for(auto& e : poll_elements) {
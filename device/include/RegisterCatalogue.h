@@ -8,6 +8,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <map>
+#include <vector>
 
 namespace ChimeraTK {
 
@@ -16,10 +17,19 @@ namespace ChimeraTK {
 
   /*******************************************************************************************************************/
 
-  /** Catalogue of register information */
+  /**
+   * Catalogue of register information.
+   *
+   * The catalogue is an immutable view of the implementation object, which is shared e.g. with the backend and with
+   * copies of the RegisterCatalogue. Obtaining or copying a catalogue hence does not copy the register information.
+   */
   class RegisterCatalogue {
    public:
-    explicit RegisterCatalogue(std::unique_ptr<BackendRegisterCatalogueBase>&& impl);
+    /**
+     * Create catalogue from the implementation object. The implementation object must not be modified any more, once
+     * passed to this constructor.
+     */
+    explicit RegisterCatalogue(std::shared_ptr<const BackendRegisterCatalogueBase> impl);
 
     RegisterCatalogue(const RegisterCatalogue& other);
     RegisterCatalogue(RegisterCatalogue&& other) noexcept;
@@ -29,7 +39,8 @@ namespace ChimeraTK {
     ~RegisterCatalogue();
 
     /**
-     *  Get register information for a given full path name.
+     *  Get register information for a given full path name. The returned RegisterInfo shares the information stored
+     *  in the catalogue where possible, so this does not copy the register information.
      *
      *  Throws ChimeraTK::logic_error if register does not exist in the catalogue.
      */
@@ -41,6 +52,29 @@ namespace ChimeraTK {
     /** Get number of registers in the catalogue */
     [[nodiscard]] size_t getNumberOfRegisters() const;
 
+    /**
+     * Get all registers in the given module, including all submodules. If the module name itself is the name of a
+     * register, that register is included as well. Registers are sorted by module (depth first), and in the order of
+     * the catalogue within a module. Only registers which appear when iterating the catalogue are considered.
+     *
+     * The query uses an index which is built on first use, so the time does not depend on the size of the catalogue.
+     */
+    [[nodiscard]] std::vector<RegisterInfo> getRegistersInModule(const RegisterPath& moduleName) const;
+
+    /**
+     * Get the names of the direct children (registers and submodules) of the given module, e.g. to display the
+     * catalogue as a tree. Pass "/" to obtain the top-level names.
+     */
+    [[nodiscard]] std::vector<std::string> getChildNames(const RegisterPath& moduleName) const;
+
+    /**
+     * Get all registers matching the given glob pattern, e.g. "/APP/MODULE?/TEMPERATURE*". The pattern is matched
+     * component by component: "*" matches any number of characters and "?" matches a single character within a
+     * component, while a component "**" matches any number of components (including none). Registers are sorted like
+     * in getRegistersInModule().
+     */
+    [[nodiscard]] std::vector<RegisterInfo> getRegistersMatching(const std::string& pattern) const;
+
     /**
      * Return a const reference to the implementation object. Only for advanced use, e.g. when backend-depending code
      * shall be written.
@@ -76,7 +110,7 @@ namespace ChimeraTK {
     [[nodiscard]] const_iterator end() const;
 
    protected:
-    std::unique_ptr<BackendRegisterCatalogueBase> _impl;
+    std::shared_ptr<const BackendRegisterCatalogueBase> _impl;
   };
 
   /*******************************************************************************************************************/
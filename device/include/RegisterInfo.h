@@ -11,12 +11,18 @@ namespace ChimeraTK {
 
   class RegisterInfo {
    public:
-    explicit RegisterInfo(std::unique_ptr<BackendRegisterInfoBase>&& impl);
+    /**
+     * Create RegisterInfo from the implementation object. The implementation object may be shared with other
+     * RegisterInfo objects or with a register catalogue, e.g. when obtained through RegisterCatalogue::getRegister().
+     * It is copied only when modified through the non-const getImpl().
+     */
+    explicit RegisterInfo(std::shared_ptr<const BackendRegisterInfoBase> impl);
 
-    RegisterInfo(const RegisterInfo& other);
+    /** Copies share the implementation object, see getImpl(). */
+    RegisterInfo(const RegisterInfo& other) = default;
     RegisterInfo(RegisterInfo&& other) = default;
 
-    RegisterInfo& operator=(const RegisterInfo& other);
+    RegisterInfo& operator=(const RegisterInfo& other) = default;
     RegisterInfo& operator=(RegisterInfo&& other) = default;
 
     /** Return full path name of the register (including modules) */
@@ -50,6 +56,10 @@ namespace ChimeraTK {
     /**
      * Return a reference to the implementation object. Only for advanced use, e.g. when backend-depending code shall
      * be written.
+     *
+     * If the implementation object is shared with other RegisterInfo objects or with a register catalogue, it is
+     * cloned first (copy on write), so modifications never affect other objects. The returned reference must not be
+     * used any more after this RegisterInfo has been copied.
      */
     [[nodiscard]] BackendRegisterInfoBase& getImpl();
 
@@ -60,7 +70,7 @@ namespace ChimeraTK {
     [[nodiscard]] const BackendRegisterInfoBase& getImpl() const;
 
    protected:
-    std::unique_ptr<BackendRegisterInfoBase> _impl;
+    std::shared_ptr<const BackendRegisterInfoBase> _impl;
   };
 
 } /* namespace ChimeraTK */
@@ -69,6 +69,12 @@ namespace ChimeraTK {
      */
     bool readNonBlocking() { return _impl->readNonBlocking(); }
 
+    /**
+     * Read the next value, but wait at most until the given deadline. Returns false if no value has been read before
+     * the deadline. See TransferElement::readUntil() for details.
+     */
+    bool readUntil(std::chrono::steady_clock::time_point deadline) { return _impl->readUntil(deadline); }
+
     /**
      * Read the latest value, discarding any other update since the last read if present. Otherwise this function is
      * identical to readNonBlocking(), i.e. it will never wait for new values and it will return whether a new value was
@@ -96,6 +102,49 @@ namespace ChimeraTK {
      */
     bool writeDestructively(ChimeraTK::VersionNumber versionNumber = {});
 
+    /**
+     * Like read(), but return runtime errors as TransferResult instead of throwing them. See TransferElement::tryRead()
+     * for details.
+     */
+    TransferResult<> tryRead() { return _impl->tryRead(); }
+
+    /**
+     * Like write(), but return runtime errors as TransferResult instead of throwing them. See
+     * TransferElement::tryWrite() for details.
+     */
+    TransferResult<bool> tryWrite(ChimeraTK::VersionNumber versionNumber = {}) { return _impl->tryWrite(versionNumber); }
+
+    /**
+     * Start a read in a worker thread and return a queue which receives an entry when the read is complete. The
+     * accessor must not be used until then. See TransferElement::readAsyncTransfer() for details.
+     */
+    cppext::future_queue<void> readAsyncTransfer() { return _impl->readAsyncTransfer(); }
+
+    /**
+     * Start a write in a worker thread and return a queue which receives the return value of write() when the write is
+     * complete. The accessor must not be used until then. See TransferElement::writeAsyncTransfer() for details.
+     */
+    cppext::future_queue<bool> writeAsyncTransfer(ChimeraTK::VersionNumber versionNumber = {}) {
+      return _impl->writeAsyncTransfer(versionNumber);
+    }
+
+    /**
+     * Start a read in a worker thread and call the given function when it is complete. See
+     * TransferElement::readAsyncTransfer() for details.
+     */
+    void readAsyncTransfer(std::function<void(std::exception_ptr)> onCompletion) {
+      _impl->readAsyncTransfer(std::move(onCompletion));
+    }
+
+    /**
+     * Start a write in a worker thread and call the given function when it is complete. See
+     * TransferElement::writeAsyncTransfer() for details.
+     */
+    void writeAsyncTransfer(std::function<void(bool, std::exception_ptr)> onCompletion,
+        ChimeraTK::VersionNumber versionNumber = {}) {
+      _impl->writeAsyncTransfer(std::move(onCompletion), versionNumber);
+    }
+
     /**
      * Check if transfer element is read only, i\.e\. it is readable but not writeable.
      */
@@ -4,6 +4,10 @@
 
 #include "TransferElementAbstractor.h"
 
+#include <ChimeraTK/cppext/future_queue.hpp>
+
+#include <functional>
+#include <optional>
 #include <set>
 
 namespace ChimeraTK {
@@ -25,6 +29,13 @@ namespace ChimeraTK {
    */
   class TransferGroup {
    public:
+    TransferGroup() = default;
+    TransferGroup(const TransferGroup&) = default;
+    TransferGroup& operator=(const TransferGroup&) = default;
+
+    /** Waits until an asynchronous transfer in progress is complete. */
+    ~TransferGroup();
+
     /**
      * Add a register accessor to the group. The register accessor might internally be altered so that accessors
      * accessing the same hardware register will share their buffers. Register accessors must not be placed into
@@ -41,6 +52,30 @@ namespace ChimeraTK {
     /** Trigger write transfer for all accessors in the group */
     void write(VersionNumber versionNumber = {});
 
+    /**
+     * Start read() in a worker thread and return immediately. The returned queue receives a single entry when the read
+     * is complete, pop_wait() on it rethrows exceptions thrown by read(). The worker thread is taken from the
+     * AsyncTransferPool of the backend, if all accessors belong to the same backend, otherwise from the default pool.
+     *
+     * The TransferGroup and its accessors must not be used until the transfer is complete. Starting another
+     * asynchronous transfer before throws a ChimeraTK::logic_error. The destructor waits for the transfer.
+     */
+    cppext::future_queue<void> readAsyncTransfer();
+
+    /** Start write() in a worker thread and return immediately. See readAsyncTransfer() for details. */
+    cppext::future_queue<void> writeAsyncTransfer(VersionNumber versionNumber = {});
+
+    /**
+     * Like readAsyncTransfer(), but call the given function from the worker thread when the read is complete, instead
+     * of returning a queue. The function receives the exception thrown by read(), or nullptr. It must not throw. The
+     * group is no longer accessed by the transfer when the function is called, so it may be destroyed by the function.
+     */
+    void readAsyncTransfer(std::function<void(std::exception_ptr)> onCompletion);
+
+    /** Like writeAsyncTransfer(), but call the given function when the write is complete. See the other
+     *  readAsyncTransfer() for details. */
+    void writeAsyncTransfer(std::function<void(std::exception_ptr)> onCompletion, VersionNumber versionNumber = {});
+
     /**
      * Check if transfer group is read-only. A transfer group is read-only, if at least one of its transfer elements is
      * read-only.
@@ -104,6 +139,21 @@ namespace ChimeraTK {
     // Counter how many runtime errors have been thrown.
     size_t _nRuntimeErrors;
 
+    /** Execute the given transfer in the AsyncTransferPool and call onCompletion afterwards. */
+    void submitAsyncTransfer(std::function<void()> transfer, std::function<void(std::exception_ptr)> onCompletion);
+
+    /** State of the last asynchronous transfer. It is not copied with the group, since the transfer only accesses the
+     *  original group. */
+    struct AsyncTransferState {
+      AsyncTransferState() = default;
+      AsyncTransferState(const AsyncTransferState&) {}
+      AsyncTransferState& operator=(const AsyncTransferState&) { return *this; }
+
+      /** Receives an entry when the transfer no longer accesses the group. */
+      std::optional<cppext::future_queue<void>> groupReleased;
+    };
+    AsyncTransferState _asyncTransfer;
+
    private:
     void addAccessorImpl(TransferElementAbstractor& accessor, bool isTemporaryAbstractor);
   };
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "Exception.h"
+
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  /** Outcome of a transfer, see TransferResult. */
+  enum class TransferStatus {
+    ok,           ///< The transfer was successful.
+    runtimeError, ///< The transfer failed with a ChimeraTK::runtime_error.
+    interrupted   ///< The transfer was interrupted with boost::thread_interrupted, see TransferElement::interrupt().
+  };
+
+  /********************************************************************************************************************/
+
+  /**
+   * Result of the non-throwing transfer functions TransferElement::tryRead(), TransferElement::tryWrite() and
+   * ReadAnyGroup::tryReadAny(). It holds either the return value of the corresponding throwing function, or the
+   * exception which would have been thrown by it. This corresponds to std::expected, which is not available in C++17.
+   *
+   * Only runtime errors and interruptions are returned. ChimeraTK::logic_error is still thrown, since it indicates a
+   * programming error.
+   */
+  template<typename T = void>
+  class TransferResult;
+
+  /********************************************************************************************************************/
+
+  template<>
+  class TransferResult<void> {
+   public:
+    /** Construct a successful result. */
+    TransferResult() = default;
+
+    /** Construct a failed result. The status must not be TransferStatus::ok. */
+    TransferResult(TransferStatus status, std::exception_ptr exception)
+    : _status(status), _exception(std::move(exception)) {}
+
+    /** Return true if the transfer was successful. */
+    [[nodiscard]] bool hasValue() const noexcept { return _status == TransferStatus::ok; }
+
+    explicit operator bool() const noexcept { return hasValue(); }
+
+    /** Return the outcome of the transfer. */
+    [[nodiscard]] TransferStatus getStatus() const noexcept { return _status; }
+
+    /** Return the exception of a failed transfer, or nullptr. */
+    [[nodiscard]] const std::exception_ptr& getException() const noexcept { return _exception; }
+
+    /** Throw the exception of a failed transfer. Does nothing if the transfer was successful. */
+    void rethrow() const {
+      if(_exception) {
+        std::rethrow_exception(_exception);
+      }
+    }
+
+    /**
+     * Return the message of the exception of a failed transfer, or an empty string. Since the message can only be
+     * obtained from the exception object, the exception is rethrown and caught internally. Use getStatus() in
+     * frequently executed code.
+     */
+    [[nodiscard]] std::string getErrorMessage() const {
+      if(!_exception) {
+        return {};
+      }
+      try {
+        std::rethrow_exception(_exception);
+      }
+      catch(std::exception& e) {
+        return e.what();
+      }
+      catch(...) {
+        return "thread interrupted";
+      }
+    }
+
+   protected:
+    TransferStatus _status{TransferStatus::ok};
+    std::exception_ptr _exception;
+  };
+
+  /********************************************************************************************************************/
+
+  template<typename T>
+  class TransferResult : public TransferResult<void> {
+   public:
+    /** Construct a successful result with the given value. */
+    TransferResult(T value) : _value(std::move(value)) {} // NOLINT(google-explicit-constructor)
+
+    /** Construct a failed result. The status must not be TransferStatus::ok. */
+    TransferResult(TransferStatus status, std::exception_ptr exception)
+    : TransferResult<void>(status, std::move(exception)) {}
+
+    /** Construct a failed result from a failed result of another type. */
+    template<typename U>
+    explicit TransferResult(const TransferResult<U>& failed)
+    : TransferResult<void>(failed.getStatus(), failed.getException()) {}
+
+    /** Return the value. If the transfer has failed, its exception is thrown instead. */
+    const T& value() const {
+      rethrow();
+      return _value;
+    }
+
+    /** Return the value, or the given default value if the transfer has failed. */
+    T valueOr(T defaultValue) const { return hasValue() ? _value : std::move(defaultValue); }
+
+   protected:
+    T _value{};
+  };
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -5,6 +5,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <ctime>
 #include <string>
 
 namespace ChimeraTK {
@@ -22,10 +23,27 @@ namespace ChimeraTK {
    */
   class VersionNumber {
    public:
+    /**
+     * Process-wide policy how the time stamp of a new version number is obtained by the default constructor.
+     */
+    enum class ClockPolicy {
+      precise, ///< Use std::chrono::system_clock::now(). This is the default.
+      coarse   ///< Use CLOCK_REALTIME_COARSE where available, which is considerably cheaper to read but only has the
+               ///< resolution of the kernel tick (typically 1 to 4 ms). Falls back to precise on other platforms.
+    };
+
+    /**
+     * Set the process-wide ClockPolicy. Only the time stamps are affected, the comparison of version numbers is not.
+     */
+    static void setClockPolicy(ClockPolicy policy) { _clockPolicy = policy; }
+
+    /** Return the current process-wide ClockPolicy. */
+    static ClockPolicy getClockPolicy() { return _clockPolicy; }
+
     /**
      * Default constructor: Generate new unique version number with current time as time stamp
      */
-    VersionNumber() : _value(nextVersionNumber()), _time(std::chrono::system_clock::now()) {}
+    VersionNumber() : _value(nextVersionNumber()), _time(now()) {}
 
     /** Copy constructor */
     VersionNumber(const VersionNumber& other) = default;
@@ -84,13 +102,26 @@ namespace ChimeraTK {
      * guaranteed to be greater than the version numbers returned for earlier calls to this method. This method may
      * safely be called by any thread without any synchronization.
      */
-    static uint64_t nextVersionNumber() { return ++_lastGeneratedVersionNumber; }
+    static uint64_t nextVersionNumber() {
+      // No memory ordering is needed: the modification order of the counter alone guarantees the ordering.
+      return _lastGeneratedVersionNumber.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
 
     /**
      * Global static atomic: Last version number that was generated.
      */
     static std::atomic<uint64_t> _lastGeneratedVersionNumber;
 
+    /**
+     * Return the current time according to the ClockPolicy.
+     */
+    static std::chrono::system_clock::time_point now();
+
+    /**
+     * Global static atomic: The ClockPolicy.
+     */
+    static std::atomic<ClockPolicy> _clockPolicy;
+
     friend std::ostream& operator<<(std::ostream& stream, const VersionNumber& version);
   };
 
@@ -99,6 +130,20 @@ namespace ChimeraTK {
   inline VersionNumber::VersionNumber(std::chrono::system_clock::time_point timestamp)
   : _value(nextVersionNumber()), _time(timestamp) {}
 
+  /********************************************************************************************************************/
+
+  inline std::chrono::system_clock::time_point VersionNumber::now() {
+#ifdef CLOCK_REALTIME_COARSE
+    if(_clockPolicy.load(std::memory_order_relaxed) == ClockPolicy::coarse) {
+      timespec ts{};
+      clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+      return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec)));
+    }
+#endif
+    return std::chrono::system_clock::now();
+  }
+
   /********************************************************************************************************************/
   /********************************************************************************************************************/
 
@@ -3,8 +3,35 @@
 
 #include "DataConsistencyGroup.h"
 
+#include "DataConsistencyDecorator.h"
+#include "SupportedUserTypes.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
 namespace ChimeraTK {
 
+  namespace {
+
+    bool isHistorized(DataConsistencyGroup::MatchingMode mode) {
+      return mode == DataConsistencyGroup::MatchingMode::historized ||
+          mode == DataConsistencyGroup::MatchingMode::timeWindow;
+    }
+
+    void checkElement(const TransferElementAbstractor& element) {
+      if(!element.isReadable()) {
+        throw ChimeraTK::logic_error(
+            "Cannot add non-readable accessor for register " + element.getName() + " to DataConsistencyGroup.");
+      }
+      if(!element.getAccessModeFlags().has(AccessMode::wait_for_new_data)) {
+        throw ChimeraTK::logic_error(
+            "Cannot add poll type accessor for register " + element.getName() + " to DataConsistencyGroup.");
+      }
+    }
+
+  } // namespace
+
   /********************************************************************************************************************/
 
   DataConsistencyGroup::DataConsistencyGroup() = default;
@@ -23,15 +50,39 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  void DataConsistencyGroup::add(const TransferElementAbstractor& element) {
-    if(!element.isReadable()) {
-      throw ChimeraTK::logic_error(
-          "Cannot add non-readable accessor for register " + element.getName() + " to DataConsistencyGroup.");
+  void DataConsistencyGroup::add(TransferElementAbstractor& element) {
+    if(!isHistorized(mode)) {
+      add(std::as_const(element));
+      return;
     }
-    if(!element.getAccessModeFlags().has(AccessMode::wait_for_new_data)) {
-      throw ChimeraTK::logic_error(
-          "Cannot add poll type accessor for register " + element.getName() + " to DataConsistencyGroup.");
+    checkElement(element);
+    if(_decorators.count(element.getId())) {
+      // already decorated
+      return;
+    }
+
+    // replace the implementation with a decorator recording the history
+    boost::shared_ptr<detail::DataConsistencyDecoratorBase> decorator;
+    callForType(element.getValueType(), [&](auto arg) {
+      using UserType = decltype(arg);
+      auto target = boost::dynamic_pointer_cast<NDRegisterAccessor<UserType>>(element.getHighLevelImplElement());
+      assert(target);
+      auto newImpl = boost::make_shared<detail::DataConsistencyDecorator<UserType>>(target, _historyLength);
+      element.replace(boost::static_pointer_cast<TransferElement>(newImpl));
+      decorator = newImpl;
+    });
+    push_elements[element.getId()] = element;
+    _decorators[element.getId()] = decorator;
+  }
+
+  /********************************************************************************************************************/
+
+  void DataConsistencyGroup::add(const TransferElementAbstractor& element) {
+    if(isHistorized(mode)) {
+      throw ChimeraTK::logic_error("Cannot add accessor for register " + element.getName() +
+          " to DataConsistencyGroup: In historized matching modes, elements must be passed as non-const reference.");
     }
+    checkElement(element);
     push_elements[element.getId()] = element;
   }
 
@@ -43,4 +94,86 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void DataConsistencyGroup::setMatchingMode(MatchingMode newMode) {
+    if(!push_elements.empty() && isHistorized(newMode) != isHistorized(mode)) {
+      throw ChimeraTK::logic_error(
+          "DataConsistencyGroup: Cannot switch to or from a historized matching mode after elements have been added.");
+    }
+    mode = newMode;
+  }
+
+  /********************************************************************************************************************/
+
+  void DataConsistencyGroup::setHistoryLength(size_t length) {
+    if(!push_elements.empty()) {
+      throw ChimeraTK::logic_error("DataConsistencyGroup: Cannot change history length after elements have been added.");
+    }
+    if(length == 0) {
+      throw ChimeraTK::logic_error("DataConsistencyGroup: History length must be at least 1.");
+    }
+    _historyLength = length;
+  }
+
+  /********************************************************************************************************************/
+
+  bool DataConsistencyGroup::updateHistorized(const TransferElementID& transferElementID) {
+    std::vector<VersionNumber> dropped;
+    for(auto& decorator : _decorators) {
+      decorator.second->takeOverflowVersions(dropped);
+    }
+
+    // find the index of the matching value in the history of the given decorator
+    auto findMatch = [&](const detail::DataConsistencyDecoratorBase& decorator,
+                         const VersionNumber& reference) -> std::optional<size_t> {
+      std::optional<size_t> match;
+      std::chrono::nanoseconds bestDistance{_tolerance};
+      for(size_t i = 0; i < decorator.getHistorySize(); ++i) {
+        auto version = decorator.getHistoryVersion(i);
+        if(mode == MatchingMode::historized) {
+          if(version == reference) {
+            return i;
+          }
+          continue;
+        }
+        auto distance = std::chrono::abs(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            version.getTime() - reference.getTime()));
+        if(distance <= bestDistance) {
+          bestDistance = distance;
+          match = i;
+        }
+      }
+      return match;
+    };
+
+    // The newest value of the updated element is the only candidate for a new consistent set, since all older values
+    // have been checked in previous calls already.
+    bool consistent = false;
+    auto& updated = _decorators.at(transferElementID);
+    if(updated->getHistorySize() > 0) {
+      auto reference = updated->getHistoryVersion(updated->getHistorySize() - 1);
+      std::map<TransferElementID, size_t> matches;
+      consistent = true;
+      for(auto& [id, decorator] : _decorators) {
+        auto match = findMatch(*decorator, reference);
+        if(!match) {
+          consistent = false;
+          break;
+        }
+        matches[id] = *match;
+      }
+      if(consistent) {
+        for(auto& [id, decorator] : _decorators) {
+          decorator->restore(matches[id], dropped);
+        }
+      }
+    }
+
+    std::sort(dropped.begin(), dropped.end());
+    dropped.erase(std::unique(dropped.begin(), dropped.end()), dropped.end());
+    _incompleteVersions = std::move(dropped);
+    return consistent;
+  }
+
+  /********************************************************************************************************************/
+
 } // namespace ChimeraTK
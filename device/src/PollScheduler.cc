@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "PollScheduler.h"
+
+#include <algorithm>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  detail::PollGroup::PollGroup() {
+    FILL_VIRTUAL_FUNCTION_TEMPLATE_VTABLE(createAsyncVariable);
+  }
+
+  /********************************************************************************************************************/
+
+  std::shared_ptr<const detail::PollGroup::AsyncVariableList> detail::PollGroup::getAsyncVariableList() {
+    std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+    return _asyncVariableList;
+  }
+
+  /********************************************************************************************************************/
+
+  void detail::PollGroup::distribute(const std::shared_ptr<const AsyncVariableList>& variables,
+      const std::vector<boost::shared_ptr<TransferElement>>& syncAccessors, VersionNumber const& version) {
+    assert(variables->size() == syncAccessors.size());
+    {
+      std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+      if(!_isActive) {
+        // Activation has to be atomic w.r.t. subscriptions, which check the _isActive flag. A variable subscribed after
+        // the snapshot has been taken would not be activated, so the activation is postponed to the next poll then.
+        if(variables != _asyncVariableList) return;
+        for(size_t i = 0; i < variables->size(); ++i) {
+          auto* pollVariable = dynamic_cast<PollAsyncVariableBase*>((*variables)[i].get());
+          assert(pollVariable);
+          pollVariable->fillSendBuffer(*syncAccessors[i], version);
+          (*variables)[i]->activateAndSend();
+        }
+        _isActive = true;
+        return;
+      }
+    }
+
+    for(size_t i = 0; i < variables->size(); ++i) {
+      auto* pollVariable = dynamic_cast<PollAsyncVariableBase*>((*variables)[i].get());
+      assert(pollVariable);
+      pollVariable->fillSendBuffer(*syncAccessors[i], version);
+      (*variables)[i]->send();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void detail::PollGroup::handleFaultyBackend(const boost::shared_ptr<DeviceBackend>& backend) {
+    {
+      std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+      if(_asyncVariables.empty() || !_isActive) return;
+    }
+
+    if(backend->isOpen()) {
+      try {
+        backend->checkActiveException();
+      }
+      catch(ChimeraTK::runtime_error&) {
+        sendException(std::current_exception());
+      }
+    }
+    else {
+      deactivate();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<PollScheduler> PollScheduler::getInstance(const boost::shared_ptr<DeviceBackend>& backend) {
+    static std::mutex instancesMutex;
+    static std::map<DeviceBackend*, boost::weak_ptr<PollScheduler>> instances;
+
+    std::lock_guard<std::mutex> lock(instancesMutex);
+    // Remove the entries of schedulers which no longer exist. The scheduler keeps the backend alive, so a remaining
+    // entry cannot refer to another backend at the same address.
+    for(auto it = instances.begin(); it != instances.end();) {
+      it = it->second.expired() ? instances.erase(it) : std::next(it);
+    }
+    auto& weakInstance = instances[backend.get()];
+    auto instance = weakInstance.lock();
+    if(!instance) {
+      instance = boost::make_shared<PollScheduler>(backend);
+      weakInstance = instance;
+    }
+    return instance;
+  }
+
+  /********************************************************************************************************************/
+
+  PollScheduler::PollScheduler(
+      boost::shared_ptr<DeviceBackend> backend, Duration tick, std::shared_ptr<TimerInterruptSource::Clock> clock)
+  : _backend(std::move(backend)), _timer(tick, [this] { this->tick(); }, std::move(clock)) {}
+
+  /********************************************************************************************************************/
+
+  size_t PollScheduler::getNumberOfPollGroups() {
+    std::lock_guard<std::mutex> lock(_groupsMutex);
+    return _groups.size();
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<detail::PollGroup> PollScheduler::getPollGroup(Duration period) {
+    auto tick = _timer.getPeriod();
+    size_t nTicks = std::max<Duration::rep>(1, (period + tick / 2) / tick);
+
+    std::lock_guard<std::mutex> lock(_groupsMutex);
+    auto [it, isNew] = _groups.try_emplace(nTicks);
+    if(isNew) {
+      it->second = boost::make_shared<detail::PollGroup>();
+    }
+    _timer.start();
+    return it->second;
+  }
+
+  /********************************************************************************************************************/
+
+  void PollScheduler::tick() {
+    auto tickNumber = _tickCount + 1;
+
+    std::vector<size_t> duePeriods;
+    std::vector<boost::shared_ptr<detail::PollGroup>> dueGroups;
+    {
+      std::lock_guard<std::mutex> lock(_groupsMutex);
+      for(auto& [nTicks, group] : _groups) {
+        if(tickNumber % nTicks == 0) {
+          duePeriods.push_back(nTicks);
+          dueGroups.push_back(group);
+        }
+      }
+    }
+
+    if(!dueGroups.empty()) {
+      poll(duePeriods, dueGroups);
+    }
+
+    _tickCount = tickNumber;
+  }
+
+  /********************************************************************************************************************/
+
+  void PollScheduler::poll(
+      const std::vector<size_t>& periods, const std::vector<boost::shared_ptr<detail::PollGroup>>& groups) {
+    if(!_backend->isFunctional()) {
+      for(auto& group : groups) {
+        group->handleFaultyBackend(_backend);
+      }
+      return;
+    }
+
+    ReadPlan* plan = nullptr;
+    try {
+      plan = &getReadPlan(periods, groups);
+      if(plan->isEmpty) return;
+      plan->transferGroup.read();
+    }
+    catch(ChimeraTK::runtime_error&) {
+      // The backend's setException() has been called by the failing accessor, so the exception is sent to the active
+      // groups. The groups are activated again with the next poll once the backend has recovered.
+      for(auto& group : groups) {
+        group->handleFaultyBackend(_backend);
+      }
+      return;
+    }
+    catch(ChimeraTK::logic_error&) {
+      // the backend has been closed concurrently
+      for(auto& group : groups) {
+        group->handleFaultyBackend(_backend);
+      }
+      return;
+    }
+
+    VersionNumber version;
+    for(size_t i = 0; i < groups.size(); ++i) {
+      groups[i]->distribute(plan->variableLists[i], plan->syncAccessors[i], version);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  PollScheduler::ReadPlan& PollScheduler::getReadPlan(
+      const std::vector<size_t>& periods, const std::vector<boost::shared_ptr<detail::PollGroup>>& groups) {
+    std::vector<std::shared_ptr<const detail::PollGroup::AsyncVariableList>> variableLists;
+    for(auto& group : groups) {
+      variableLists.push_back(group->getAsyncVariableList());
+    }
+
+    auto& plan = _readPlans[periods];
+    if(plan && plan->variableLists == variableLists) {
+      return *plan;
+    }
+
+    // The subscriptions have changed: Create a new TransferGroup with new synchronous accessors. Accessors can only be
+    // part of one TransferGroup, hence the accessors of the previous plan cannot be reused. The TransferGroup merges
+    // the transfers of the same register used in several groups.
+    auto newPlan = std::make_unique<ReadPlan>();
+    for(auto& variables : variableLists) {
+      auto& syncAccessors = newPlan->syncAccessors.emplace_back();
+      for(auto& variable : *variables) {
+        auto* pollVariable = dynamic_cast<detail::PollAsyncVariableBase*>(variable.get());
+        assert(pollVariable);
+        syncAccessors.push_back(pollVariable->createSyncAccessor());
+        newPlan->transferGroup.addAccessor(syncAccessors.back());
+        newPlan->isEmpty = false;
+      }
+    }
+    newPlan->variableLists = std::move(variableLists);
+    plan = std::move(newPlan);
+    return *plan;
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -9,29 +9,24 @@ namespace ChimeraTK {
 
   /*******************************************************************************************************************/
 
-  RegisterCatalogue::RegisterCatalogue(std::unique_ptr<BackendRegisterCatalogueBase>&& impl) : _impl(std::move(impl)) {}
+  RegisterCatalogue::RegisterCatalogue(std::shared_ptr<const BackendRegisterCatalogueBase> impl)
+  : _impl(std::move(impl)) {}
 
   /*******************************************************************************************************************/
 
-  RegisterCatalogue::RegisterCatalogue(const RegisterCatalogue& other) : _impl(other._impl->clone()) {}
+  RegisterCatalogue::RegisterCatalogue(const RegisterCatalogue& other) = default;
 
   /*******************************************************************************************************************/
 
-  RegisterCatalogue::RegisterCatalogue(RegisterCatalogue&& other) noexcept : _impl(std::move(other._impl)) {}
+  RegisterCatalogue::RegisterCatalogue(RegisterCatalogue&& other) noexcept = default;
 
   /*******************************************************************************************************************/
 
-  RegisterCatalogue& RegisterCatalogue::operator=(const RegisterCatalogue& other) {
-    _impl = other._impl->clone();
-    return *this;
-  }
+  RegisterCatalogue& RegisterCatalogue::operator=(const RegisterCatalogue& other) = default;
 
   /*******************************************************************************************************************/
 
-  RegisterCatalogue& RegisterCatalogue::operator=(RegisterCatalogue&& other) noexcept {
-    _impl = std::move(other._impl);
-    return *this;
-  }
+  RegisterCatalogue& RegisterCatalogue::operator=(RegisterCatalogue&& other) noexcept = default;
 
   /*******************************************************************************************************************/
 
@@ -41,6 +36,11 @@ namespace ChimeraTK {
   /*******************************************************************************************************************/
 
   RegisterInfo RegisterCatalogue::getRegister(const RegisterPath& registerPathName) const {
+    // Registers stored in the catalogue are handed out without copying. The RegisterInfo keeps the catalogue alive.
+    const auto* info = _impl->findRegister(registerPathName);
+    if(info != nullptr) {
+      return RegisterInfo(std::shared_ptr<const BackendRegisterInfoBase>(_impl, info));
+    }
     return _impl->getRegister(registerPathName);
   }
 
@@ -58,6 +58,39 @@ namespace ChimeraTK {
 
   /*******************************************************************************************************************/
 
+  namespace {
+    // Convert register information stored in the catalogue into RegisterInfo objects without copying it
+    std::vector<RegisterInfo> toRegisterInfos(const std::shared_ptr<const BackendRegisterCatalogueBase>& catalogue,
+        const std::vector<const BackendRegisterInfoBase*>& registers) {
+      std::vector<RegisterInfo> result;
+      result.reserve(registers.size());
+      for(const auto* info : registers) {
+        result.emplace_back(std::shared_ptr<const BackendRegisterInfoBase>(catalogue, info));
+      }
+      return result;
+    }
+  } // namespace
+
+  /*******************************************************************************************************************/
+
+  std::vector<RegisterInfo> RegisterCatalogue::getRegistersInModule(const RegisterPath& moduleName) const {
+    return toRegisterInfos(_impl, _impl->getRegistersInModule(moduleName));
+  }
+
+  /*******************************************************************************************************************/
+
+  std::vector<std::string> RegisterCatalogue::getChildNames(const RegisterPath& moduleName) const {
+    return _impl->getChildNames(moduleName);
+  }
+
+  /*******************************************************************************************************************/
+
+  std::vector<RegisterInfo> RegisterCatalogue::getRegistersMatching(const std::string& pattern) const {
+    return toRegisterInfos(_impl, _impl->getRegistersMatching(pattern));
+  }
+
+  /*******************************************************************************************************************/
+
   RegisterCatalogue::const_iterator RegisterCatalogue::begin() const {
     return RegisterCatalogue::const_iterator(_impl->getConstIteratorBegin());
   }
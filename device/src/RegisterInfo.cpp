@@ -7,25 +7,7 @@ namespace ChimeraTK {
 
   /*******************************************************************************************************************/
 
-  RegisterInfo::RegisterInfo(std::unique_ptr<BackendRegisterInfoBase>&& impl) : _impl(std::move(impl)) {}
-
-  /*******************************************************************************************************************/
-
-  RegisterInfo::RegisterInfo(const RegisterInfo& other) {
-    operator=(other);
-  }
-
-  /*******************************************************************************************************************/
-
-  RegisterInfo& RegisterInfo::operator=(const RegisterInfo& other) {
-    if(other.isValid()) {
-      _impl = other.getImpl().clone();
-    }
-    else {
-      _impl = nullptr;
-    }
-    return *this;
-  }
+  RegisterInfo::RegisterInfo(std::shared_ptr<const BackendRegisterInfoBase> impl) : _impl(std::move(impl)) {}
 
   /*******************************************************************************************************************/
 
@@ -84,7 +66,12 @@ namespace ChimeraTK {
   /*******************************************************************************************************************/
 
   BackendRegisterInfoBase& RegisterInfo::getImpl() {
-    return *_impl;
+    // Copy on write: If we are the only owner, nobody else can observe the modification. The implementation objects
+    // are not created as const objects, so casting away the constness is allowed.
+    if(_impl.use_count() != 1) {
+      _impl = _impl->clone();
+    }
+    return const_cast<BackendRegisterInfoBase&>(*_impl);
   }
 
   /*******************************************************************************************************************/
@@ -41,6 +41,14 @@ namespace ChimeraTK {
 
   /*********************************************************************************************************************/
 
+  TransferGroup::~TransferGroup() {
+    if(_asyncTransfer.groupReleased) {
+      _asyncTransfer.groupReleased->pop_wait();
+    }
+  }
+
+  /*********************************************************************************************************************/
+
   void TransferGroup::read() {
     // reset exception flags
     for(auto& it : _lowLevelElementsAndExceptionFlags) {
@@ -183,6 +191,82 @@ namespace ChimeraTK {
 
   /*********************************************************************************************************************/
 
+  cppext::future_queue<void> TransferGroup::readAsyncTransfer() {
+    cppext::future_queue<void> done(1);
+    readAsyncTransfer([done](const std::exception_ptr& exception) mutable {
+      if(exception) {
+        done.push_exception(exception);
+      }
+      else {
+        done.push();
+      }
+    });
+    return done;
+  }
+
+  /*********************************************************************************************************************/
+
+  cppext::future_queue<void> TransferGroup::writeAsyncTransfer(VersionNumber versionNumber) {
+    cppext::future_queue<void> done(1);
+    writeAsyncTransfer(
+        [done](const std::exception_ptr& exception) mutable {
+          if(exception) {
+            done.push_exception(exception);
+          }
+          else {
+            done.push();
+          }
+        },
+        versionNumber);
+    return done;
+  }
+
+  /*********************************************************************************************************************/
+
+  void TransferGroup::readAsyncTransfer(std::function<void(std::exception_ptr)> onCompletion) {
+    submitAsyncTransfer([this] { read(); }, std::move(onCompletion));
+  }
+
+  /*********************************************************************************************************************/
+
+  void TransferGroup::writeAsyncTransfer(
+      std::function<void(std::exception_ptr)> onCompletion, VersionNumber versionNumber) {
+    submitAsyncTransfer([this, versionNumber] { write(versionNumber); }, std::move(onCompletion));
+  }
+
+  /*********************************************************************************************************************/
+
+  void TransferGroup::submitAsyncTransfer(
+      std::function<void()> transfer, std::function<void(std::exception_ptr)> onCompletion) {
+    if(_asyncTransfer.groupReleased) {
+      if(_asyncTransfer.groupReleased->empty()) {
+        throw ChimeraTK::logic_error("TransferGroup: An asynchronous transfer is still in progress.");
+      }
+      _asyncTransfer.groupReleased->pop();
+    }
+
+    auto& pool = (_exceptionBackends.size() == 1 && *_exceptionBackends.begin())
+        ? (*_exceptionBackends.begin())->getAsyncTransferPool()
+        : AsyncTransferPool::getDefault();
+
+    cppext::future_queue<void> groupReleased(1);
+    _asyncTransfer.groupReleased = groupReleased;
+    pool.submit([transfer = std::move(transfer), groupReleased, onCompletion = std::move(onCompletion)]() mutable {
+      std::exception_ptr exception;
+      try {
+        transfer();
+      }
+      catch(...) {
+        exception = std::current_exception();
+      }
+      // the TransferGroup might be destroyed after this
+      groupReleased.push();
+      onCompletion(exception);
+    });
+  }
+
+  /*********************************************************************************************************************/
+
   bool TransferGroup::isReadOnly() {
     return isReadable() && !isWriteable();
   }
@@ -11,6 +11,10 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  std::atomic<VersionNumber::ClockPolicy> VersionNumber::_clockPolicy{VersionNumber::ClockPolicy::precise};
+
+  /********************************************************************************************************************/
+
   VersionNumber::operator std::string() const {
     return std::string("v") + std::to_string(_value);
   }
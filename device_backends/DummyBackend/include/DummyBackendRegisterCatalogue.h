@@ -14,6 +14,8 @@ namespace ChimeraTK {
 
     [[nodiscard]] bool hasRegister(const RegisterPath& registerPathName) const override;
 
+    [[nodiscard]] const BackendRegisterInfoBase* findRegister(const RegisterPath& registerPathName) const override;
+
     // Helper function to get x from DUMMY_INTERRUPT_x.
     // The first parameter is "true" if an according interrupt is in the catalogue. If the registerPathName
     // is not DUMMY_INTERRUPT_x or the interrupt is not in the catalogue, the first parameter is "false", and the second
@@ -206,6 +206,12 @@ namespace ChimeraTK {
 
     void interrupt() override { this->interrupt_impl(this->_myReadQueue); }
 
+    void wakeUpRead() override { this->wakeUpRead_impl(this->_myReadQueue); }
+
+    void setReadNotificationListener(std::function<void()> listener) override {
+      _readNotifier.set(std::move(listener));
+    }
+
     void setExceptionBackend(boost::shared_ptr<DeviceBackend> exceptionBackend) override {
       // do not set it for the target, since we read from the target in trigger(), but that is the wrong place to
       // call setException(). So we don't call it on our base class NDRegisterAccessorDecorator but on the
@@ -224,6 +230,8 @@ namespace ChimeraTK {
 
     cppext::future_queue<Buffer> _myReadQueue{3};
 
+    detail::ReadNotifier _readNotifier;
+
     void trigger() override {
       try {
         _hasException = false;
@@ -240,6 +248,7 @@ namespace ChimeraTK {
         if(!_hasException) _myReadQueue.push_overwrite_exception(std::current_exception());
         _hasException = true;
       }
+      _readNotifier.notify();
     }
 
     void doPreRead(TransferType) override {
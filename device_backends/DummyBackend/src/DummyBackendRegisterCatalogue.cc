@@ -33,6 +33,19 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  const BackendRegisterInfoBase* DummyBackendRegisterCatalogue::findRegister(
+      const RegisterPath& registerPathName) const {
+    // The special registers are synthesised by getBackendRegister(), even if a register of the same name is stored.
+    auto path = registerPathName;
+    path.setAltSeparator(".");
+    if(path.endsWith(DUMMY_WRITEABLE_SUFFIX) || registerPathName.startsWith("DUMMY_INTERRUPT_")) {
+      return nullptr;
+    }
+    return NumericAddressedRegisterCatalogue::findRegister(registerPathName);
+  }
+
+  /********************************************************************************************************************/
+
   bool DummyBackendRegisterCatalogue::hasRegister(const RegisterPath& registerPathName) const {
     auto path = registerPathName;
     path.setAltSeparator(".");
@@ -52,7 +52,7 @@ namespace ChimeraTK {
       std::string devName = info.deviceName;
       boost::shared_ptr<DeviceBackend> targetDevice;
       if(devName != "this") {
-        targetDevice = _dev->_devices[devName];
+        targetDevice = _dev->getTargetDevice(devName);
       }
       else {
         targetDevice = dev;
@@ -70,7 +70,8 @@ namespace ChimeraTK {
         // Note: we must not use boost::weak_ptr::expired() here, because we have to check the status and obtain the
         // accessor in one atomic step.
         if(it == map.end() || (_accessor = map[key].accessor.lock()) == nullptr) {
-          _accessor = targetDevice->getRegisterAccessor<uint64_t>(key.second, numberOfWords, wordOffsetInRegister, {});
+          _accessor =
+              _dev->getTargetAccessor<uint64_t>(targetDevice, key.second, numberOfWords, wordOffsetInRegister, {});
           if(_accessor->getNumberOfSamples() != 1) {
             throw ChimeraTK::logic_error("LNMBackendBitAccessors only work with registers of size 1");
           }
@@ -35,13 +35,13 @@ namespace ChimeraTK {
       std::string devName = _info.deviceName;
       boost::shared_ptr<DeviceBackend> targetDevice;
       if(devName != "this") {
-        targetDevice = _dev->_devices[devName];
+        targetDevice = _dev->getTargetDevice(devName);
       }
       else {
         targetDevice = dev;
       }
-      _accessor = targetDevice->getRegisterAccessor<UserType>(
-          RegisterPath(_info.registerName), numberOfWords, wordOffsetInRegister, flags);
+      _accessor = _dev->getTargetAccessor<UserType>(
+          targetDevice, RegisterPath(_info.registerName), numberOfWords, wordOffsetInRegister, flags);
 
       // verify channel number
       if(_info.channel >= _accessor->getNumberOfChannels()) {
@@ -104,6 +104,12 @@ namespace ChimeraTK {
 
     void interrupt() override { _accessor->interrupt(); }
 
+    void wakeUpRead() override { _accessor->wakeUpRead(); }
+
+    void setReadNotificationListener(std::function<void()> listener) override {
+      _accessor->setReadNotificationListener(std::move(listener));
+    }
+
    protected:
     /// pointer to underlying accessor
     boost::shared_ptr<NDRegisterAccessor<UserType>> _accessor;
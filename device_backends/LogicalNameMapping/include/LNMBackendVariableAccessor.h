@@ -47,6 +47,10 @@ namespace ChimeraTK {
 
     void interrupt() override;
 
+    void wakeUpRead() override;
+
+    void setReadNotificationListener(std::function<void()> listener) override;
+
    protected:
     /// register and module name
     RegisterPath _registerPathName;
@@ -65,6 +69,10 @@ namespace ChimeraTK {
     /// in doPostRead(). Only used when wait_for_new_data is set.
     typename LNMVariable::ValueTable<UserType>::QueuedValue _queueValue;
 
+    /// Listener to be notified when a value has been placed in the subscription queue. Only used when
+    /// wait_for_new_data is set.
+    std::shared_ptr<detail::ReadNotifier> _readNotifier;
+
     /// Version number of the last transfer
     VersionNumber currentVersion{nullptr};
 
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "DeviceBackend.h"
+#include "NDRegisterAccessorDecorator.h"
+
+#include <utility>
+
+namespace ChimeraTK::LNMBackend {
+
+  /********************************************************************************************************************/
+
+  /**
+   * Decorator for accessors of a target device which has been created with the lazyTargets parameter, but could not
+   * be opened (see LogicalNameMappingBackend::getTargetAccessor()). Until the recovery of the logical device has opened
+   * the target, transfers throw a runtime_error instead of the logic_error of the closed target. Afterwards everything
+   * is passed on to the target accessor.
+   *
+   * The decorator is its own hardware accessing element, so the transfers of a TransferGroup also go through it.
+   */
+  template<typename UserType>
+  class LazyTargetDecorator : public NDRegisterAccessorDecorator<UserType> {
+   public:
+    LazyTargetDecorator(const boost::shared_ptr<NDRegisterAccessor<UserType>>& target,
+        boost::shared_ptr<DeviceBackend> targetDevice, boost::shared_ptr<DeviceBackend> logicalDevice)
+    : NDRegisterAccessorDecorator<UserType>(target), _targetDevice(std::move(targetDevice)),
+      _logicalDevice(std::move(logicalDevice)) {}
+
+    void doPreRead(TransferType type) override {
+      checkLogicalDeviceOpened();
+      _readSkipsTarget = !_targetDevice->isOpen();
+      if(!_readSkipsTarget) {
+        _target->preRead(type);
+      }
+    }
+
+    void doReadTransferSynchronously() override {
+      if(_readSkipsTarget) {
+        throwTargetNotOpened();
+      }
+      _target->readTransfer();
+    }
+
+    void doPostRead(TransferType type, bool updateDataBuffer) override {
+      if(_readSkipsTarget) {
+        if(!_targetDevice->isOpen()) {
+          // nothing has been received, the exception is rethrown by postRead()
+          return;
+        }
+        // a push-type update has arrived after the recovery has opened the target
+        _target->preRead(type);
+        _readSkipsTarget = false;
+      }
+      NDRegisterAccessorDecorator<UserType>::doPostRead(type, updateDataBuffer);
+    }
+
+    void doPreWrite(TransferType type, VersionNumber versionNumber) override {
+      checkLogicalDeviceOpened();
+      _writeSkipsTarget = !_targetDevice->isOpen();
+      if(!_writeSkipsTarget) {
+        NDRegisterAccessorDecorator<UserType>::doPreWrite(type, versionNumber);
+      }
+    }
+
+    bool doWriteTransfer(VersionNumber versionNumber) override {
+      if(_writeSkipsTarget) {
+        throwTargetNotOpened();
+      }
+      return _target->writeTransfer(versionNumber);
+    }
+
+    bool doWriteTransferDestructively(VersionNumber versionNumber) override {
+      if(_writeSkipsTarget) {
+        throwTargetNotOpened();
+      }
+      return _target->writeTransferDestructively(versionNumber);
+    }
+
+    void doPostWrite(TransferType type, VersionNumber versionNumber) override {
+      if(_writeSkipsTarget) {
+        return; // the buffers have not been swapped into the target in doPreWrite()
+      }
+      NDRegisterAccessorDecorator<UserType>::doPostWrite(type, versionNumber);
+    }
+
+    std::vector<boost::shared_ptr<TransferElement>> getHardwareAccessingElements() override {
+      return {boost::enable_shared_from_this<TransferElement>::shared_from_this()};
+    }
+
+   protected:
+    using NDRegisterAccessorDecorator<UserType>::_target;
+
+    void checkLogicalDeviceOpened() {
+      if(!_logicalDevice->isOpen()) {
+        throw ChimeraTK::logic_error("Device not opened.");
+      }
+    }
+
+    [[noreturn]] void throwTargetNotOpened() {
+      // The logical device is in the exception state until the recovery has opened the target.
+      _logicalDevice->checkActiveException();
+      throw ChimeraTK::runtime_error("Target device of '" + this->getName() + "' is not opened.");
+    }
+
+    boost::shared_ptr<DeviceBackend> _targetDevice;
+    boost::shared_ptr<DeviceBackend> _logicalDevice;
+
+    /// Whether the current read resp. write transfer bypasses the target, since it was not opened in preRead() resp.
+    /// preWrite().
+    bool _readSkipsTarget{false};
+    bool _writeSkipsTarget{false};
+  };
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK::LNMBackend
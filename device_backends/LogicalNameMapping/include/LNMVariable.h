@@ -6,7 +6,10 @@
 
 #include <boost/shared_ptr.hpp>
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 namespace ChimeraTK {
 
@@ -33,9 +36,40 @@ namespace ChimeraTK {
     };
     TemplateUserTypeMap<ValueTable> valueTable;
 
-    /** Mutex one needs to hold while accessing valueTable. */
+    /** Mutex one needs to hold while accessing valueTable and readNotifiers. */
     std::mutex valueTable_mutex;
 
+    /** Read notification listeners of the subscribed accessors (see TransferElement::setReadNotificationListener()).
+     *  They have to be notified after pushing to the subscription queues, without holding valueTable_mutex. */
+    std::map<TransferElementID, std::shared_ptr<detail::ReadNotifier>> readNotifiers;
+
+    /** Return a copy of readNotifiers, to notify them after releasing valueTable_mutex. valueTable_mutex must be
+     *  held. */
+    [[nodiscard]] std::vector<std::shared_ptr<detail::ReadNotifier>> getReadNotifiers() const {
+      std::vector<std::shared_ptr<detail::ReadNotifier>> notifiers;
+      notifiers.reserve(readNotifiers.size());
+      for(const auto& notifier : readNotifiers) {
+        notifiers.push_back(notifier.second);
+      }
+      return notifiers;
+    }
+
+    /** Notify all given readNotifiers. valueTable_mutex must not be held, since the listeners may resume application
+     *  code, which might access the variable again. */
+    static void notifyReaders(const std::vector<std::shared_ptr<detail::ReadNotifier>>& notifiers) {
+      for(const auto& notifier : notifiers) {
+        notifier->notify();
+      }
+    }
+
+    /** Notify all readNotifiers. valueTable_mutex must not be held. */
+    void notifyReaders() {
+      std::unique_lock<std::mutex> lock(valueTable_mutex);
+      auto notifiers = getReadNotifiers();
+      lock.unlock();
+      notifyReaders(notifiers);
+    }
+
     /** formulas which need updates after variable was written */
     std::set<LNMBackend::MathPlugin*> usingFormulas;
 
@@ -11,6 +11,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <map>
+#include <optional>
 #include <utility>
 
 // forward declaration
@@ -29,16 +30,31 @@ namespace ChimeraTK {
     LogicalNameMapParser(std::map<std::string, std::string> parameters, std::map<std::string, LNMVariable>& variables)
     : _parameters(std::move(parameters)), _variables(variables) {}
 
-    /** parse the given XML file */
+    /** parse the given XML file. If the CatalogueCache is enabled, the result is read from the cache file instead, as
+     *  long as the content of the file and the parameters have not changed. Otherwise the cache file is written after
+     *  parsing. */
     BackendRegisterCatalogue<LNMBackendRegisterInfo> parseFile(const std::string& fileName);
     // BackendRegisterCatalogue<LNMBackendRegisterInfo> _catalogue;
 
    protected:
-    /** called inside parseFile() to parse an XML element and its sub-elements
-     * recursively */
-    void parseElement(const RegisterPath& currentPath, const xmlpp::Element* element,
+    /** called inside parseFile() to parse the XML element of a single register. The file is read as a stream, only
+     * the subtree of the register is expanded. */
+    void parseRegister(const RegisterPath& currentPath, const xmlpp::Element* element,
         BackendRegisterCatalogue<LNMBackendRegisterInfo>& catalogue);
 
+    /** Read the result of parseFile() from the catalogue cache, including the initial values of the variables. Returns
+     *  std::nullopt on a cache miss. */
+    std::optional<BackendRegisterCatalogue<LNMBackendRegisterInfo>> readCache(
+        const std::string& cacheFileName, uint64_t contentHash);
+
+    /** Write the result of parseFile() to the catalogue cache. */
+    void writeCache(const std::string& cacheFileName, uint64_t contentHash,
+        const BackendRegisterCatalogue<LNMBackendRegisterInfo>& catalogue);
+
+    /** Kind and format version of the cache files. Increase the version when changing the format. */
+    static constexpr std::string_view cacheKind{"LNMBackendRegisterCatalogue"};
+    static constexpr uint32_t cacheVersion{1};
+
     /** throw a parsing error with more information */
     [[noreturn]] void parsingError(const xmlpp::Node* node, const std::string& message);
 
@@ -47,6 +63,10 @@ namespace ChimeraTK {
     ValueType getValueFromXmlSubnode(const xmlpp::Node* node, const std::string& subnodeName,
         BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue, bool hasDefault = false,
         ValueType defaultValue = ValueType());
+    /** Obtain the value of the given node, resolving references and parameters. */
+    std::string getValueFromXmlNode(
+        const xmlpp::Element* node, BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue);
+
     template<typename ValueType>
     std::vector<ValueType> getValueVectorFromXmlSubnode(const xmlpp::Node* node, const std::string& subnodeName,
         BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue);
@@ -66,6 +86,16 @@ namespace ChimeraTK {
 
     /** Reference to the variables map inside the LNM backend. Is filled with initial values in the parser **/
     std::map<std::string, LNMVariable>& _variables;
+
+    /** Name and parameters of a plugin, as needed to create the plugin with LNMBackend::makePlugin() */
+    struct PluginDescription {
+      std::string name;
+      std::map<std::string, std::string> parameters;
+    };
+
+    /** Plugins of each register in the order of the catalogue. The plugin instances cannot be serialised for the
+     *  catalogue cache, hence their descriptions are kept. */
+    std::vector<std::vector<PluginDescription>> _pluginDescriptions;
   };
 
   template<>
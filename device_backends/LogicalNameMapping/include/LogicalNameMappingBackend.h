@@ -5,6 +5,7 @@
 #include "BackendRegisterCatalogue.h"
 #include "DeviceBackendImpl.h"
 #include "LNMBackendRegisterInfo.h"
+#include "LNMLazyTargetDecorator.h"
 #include "LNMVariable.h"
 #include <unordered_set>
 
@@ -15,6 +16,12 @@ namespace ChimeraTK {
 
   /**
    * Backend to map logical register names onto real hardware registers. See \ref lmap for details.
+   *
+   * Besides the map file parameters, the following CDD parameters are understood:
+   *  - openConcurrency: Maximum number of target devices opened concurrently by open(). Defaults to 8.
+   *  - lazyTargets: If set to 1, a target device is only created when it is first needed, and opened when the first
+   *    accessor using it is requested while this backend is open. If that open fails, this backend goes into the
+   *    exception state, and the target is opened again as part of the recovery.
    */
   class LogicalNameMappingBackend : public DeviceBackendImpl {
    public:
@@ -52,9 +59,37 @@ namespace ChimeraTK {
     /// name of the logical map file
     std::string _lmapFileName;
 
-    /// map of target devices
+    /// map of target devices. Protected by _devicesMutex
     mutable std::map<std::string, boost::shared_ptr<DeviceBackend>> _devices;
 
+    /// mutex protecting _devices, since target devices might be created when an accessor is requested
+    mutable std::mutex _devicesMutex;
+
+    /// flag whether target devices are created on first use (CDD parameter lazyTargets)
+    bool _lazyTargets{false};
+
+    /// maximum number of target devices opened concurrently (CDD parameter openConcurrency)
+    size_t _openConcurrency{8};
+
+    /**
+     * Return the target device with the given name, or nullptr if it is not referenced in the map. With lazyTargets,
+     * the device is created on first use, and opened if this backend is open.
+     */
+    boost::shared_ptr<DeviceBackend> getTargetDevice(const std::string& devName) const;
+
+    /**
+     * Obtain an accessor of the given target device. If the target could not be opened on first use (see
+     * getTargetDevice()), the accessor is decorated with an LNMBackend::LazyTargetDecorator, so its transfers throw a
+     * runtime_error until the recovery has opened the target.
+     */
+    template<typename UserType>
+    boost::shared_ptr<NDRegisterAccessor<UserType>> getTargetAccessor(
+        const boost::shared_ptr<DeviceBackend>& targetDevice, const RegisterPath& registerPathName,
+        size_t numberOfWords, size_t wordOffsetInRegister, AccessModeFlags flags);
+
+    /// Return a copy of _devices, to iterate the target devices without holding the lock
+    std::map<std::string, boost::shared_ptr<DeviceBackend>> getCreatedTargetDevices() const;
+
     /// map of parameters passed through the CDD
     std::map<std::string, std::string> _parameters;
 
@@ -66,6 +101,10 @@ namespace ChimeraTK {
      * from the target backends */
     mutable bool catalogueCompleted{false};
 
+    /** Copy of the completed catalogue, which is shared with the RegisterCatalogue objects returned by
+     * getRegisterCatalogue(). A new copy is made each time the catalogue is completed again. */
+    mutable std::shared_ptr<const BackendRegisterCatalogueBase> _catalogueSnapshot;
+
     /** Struct holding shared accessors together with a mutex for thread safety. See sharedAccessorMap data member. */
     template<typename UserType>
     struct SharedAccessor {
@@ -110,6 +149,9 @@ namespace ChimeraTK {
     std::unordered_set<std::string> getTargetDevices() const;
 
    private:
+    /// Open all created target devices, up to _openConcurrency at the same time. The errors are combined.
+    void openTargetDevices();
+
     // A version number created when opening the backend. All variables will report this version number until they are
     // changed for the first time after opening the device.
     std::atomic<ChimeraTK::VersionNumber> _versionOnOpen{ChimeraTK::VersionNumber{nullptr}};
@@ -118,4 +160,18 @@ namespace ChimeraTK {
     ChimeraTK::VersionNumber getVersionOnOpen() const;
   };
 
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  boost::shared_ptr<NDRegisterAccessor<UserType>> LogicalNameMappingBackend::getTargetAccessor(
+      const boost::shared_ptr<DeviceBackend>& targetDevice, const RegisterPath& registerPathName, size_t numberOfWords,
+      size_t wordOffsetInRegister, AccessModeFlags flags) {
+    auto accessor =
+        targetDevice->getRegisterAccessor<UserType>(registerPathName, numberOfWords, wordOffsetInRegister, flags);
+    if(!_lazyTargets || !_opened || targetDevice->isOpen()) {
+      return accessor;
+    }
+    return boost::make_shared<LNMBackend::LazyTargetDecorator<UserType>>(accessor, targetDevice, shared_from_this());
+  }
+
 } // namespace ChimeraTK
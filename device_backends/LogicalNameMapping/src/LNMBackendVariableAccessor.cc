@@ -55,6 +55,9 @@ namespace ChimeraTK {
       auto& lnmVariable = _dev->_variables[_info.name];
       std::lock_guard<std::mutex> lock(lnmVariable.valueTable_mutex);
 
+      _readNotifier = std::make_shared<detail::ReadNotifier>();
+      lnmVariable.readNotifiers[this->getId()] = _readNotifier;
+
       callForType(_info.valueType, [&, this](auto arg) {
         using T = decltype(arg);
         auto& vtEntry = boost::fusion::at_key<T>(lnmVariable.valueTable.table);
@@ -110,6 +113,7 @@ namespace ChimeraTK {
         auto& vtEntry = boost::fusion::at_key<T>(lnmVariable.valueTable.table);
         vtEntry.subscriptions.erase(this->getId());
       });
+      lnmVariable.readNotifiers.erase(this->getId());
     }
   }
 
@@ -140,7 +144,7 @@ namespace ChimeraTK {
   bool LNMBackendVariableAccessor<UserType>::doWriteTransfer(ChimeraTK::VersionNumber v) {
     _dev->checkActiveException();
     auto& lnmVariable = _dev->_variables[_info.name];
-    std::lock_guard<std::mutex> lock(lnmVariable.valueTable_mutex);
+    std::unique_lock<std::mutex> lock(lnmVariable.valueTable_mutex);
 
     callForType(_info.valueType, [&, this](auto arg) {
       auto& vtEntry = boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table);
@@ -159,6 +163,13 @@ namespace ChimeraTK {
         }
       }
     });
+
+    // the listeners may resume application code, which might write to this variable again
+    if(_dev->_asyncReadActive) {
+      auto notifiers = lnmVariable.getReadNotifiers();
+      lock.unlock();
+      LNMVariable::notifyReaders(notifiers);
+    }
     return false;
   }
 
@@ -260,5 +271,28 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  template<typename UserType>
+  void LNMBackendVariableAccessor<UserType>::setReadNotificationListener(std::function<void()> listener) {
+    if(!_readNotifier) {
+      TransferElement::setReadNotificationListener(std::move(listener)); // throws logic_error
+    }
+    _readNotifier->set(std::move(listener));
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename UserType>
+  void LNMBackendVariableAccessor<UserType>::wakeUpRead() {
+    auto& lnmVariable = _dev->_variables[_info.name];
+    std::lock_guard<std::mutex> lock(lnmVariable.valueTable_mutex);
+
+    callForType(_info.valueType, [&, this](auto arg) {
+      auto& vtEntry = boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table);
+      this->wakeUpRead_impl(vtEntry.subscriptions[this->getId()]);
+    });
+  }
+
+  /********************************************************************************************************************/
+
   INSTANTIATE_TEMPLATE_FOR_CHIMERATK_USER_TYPES(LNMBackendVariableAccessor);
 } // namespace ChimeraTK
@@ -60,15 +60,13 @@ namespace ChimeraTK::LNMBackend {
   : ChimeraTK::NDRegisterAccessorDecorator<UserType>(target), _plugin(plugin) {
     boost::shared_ptr<DeviceBackend> dev;
     const auto& parameters = plugin._parameters;
-    try {
-      if(plugin._targetDeviceName != "this") {
-        dev = backend->_devices.at(plugin._targetDeviceName);
-      }
-      else {
-        dev = backend;
-      }
+    if(plugin._targetDeviceName != "this") {
+      dev = backend->getTargetDevice(plugin._targetDeviceName);
     }
-    catch(std::out_of_range& ex) {
+    else {
+      dev = backend;
+    }
+    if(!dev) {
       std::string message = "LogicalNameMappingBackend DoubleBufferPlugin: unknown targetDevice " + std::string("'") +
           plugin._targetDeviceName + "'.";
       throw ChimeraTK::logic_error(message);
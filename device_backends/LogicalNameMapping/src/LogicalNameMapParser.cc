@@ -3,26 +3,50 @@
 
 #include "LogicalNameMapParser.h"
 
+#include "CatalogueCache.h"
 #include "DeviceBackend.h"
 #include "Exception.h"
 #include "LNMBackendRegisterInfo.h"
 #include <libxml++/libxml++.h>
 
+#include <cassert>
+#include <filesystem>
 #include <stdexcept>
 
 namespace ChimeraTK {
 
+  /********************************************************************************************************************/
+
+  /** Return the child elements with the given name. This replaces an XPath query, which is much more expensive. */
+  static std::vector<const xmlpp::Element*> getChildElements(const xmlpp::Node* node, const std::string& name) {
+    std::vector<const xmlpp::Element*> elements;
+    for(const auto& child : node->get_children(name)) {
+      const auto* element = dynamic_cast<const xmlpp::Element*>(child);
+      if(element) elements.push_back(element);
+    }
+    return elements;
+  }
+
+  /********************************************************************************************************************/
+
   template<>
   std::string LogicalNameMapParser::getValueFromXmlSubnode<std::string>(const xmlpp::Node* node,
       const std::string& subnodeName, BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue,
       bool hasDefault, std::string defaultValue) {
-    auto list = node->find(subnodeName);
+    auto list = getChildElements(node, subnodeName);
     if(list.empty() && hasDefault) return defaultValue;
     if(list.size() != 1) {
       parsingError(node,
           "Expected exactly one subnode of the type '" + subnodeName + "' below node '" + node->get_name() + "'.");
     }
-    auto childList = list[0]->get_children();
+    return getValueFromXmlNode(list[0], catalogue);
+  }
+
+  /********************************************************************************************************************/
+
+  std::string LogicalNameMapParser::getValueFromXmlNode(
+      const xmlpp::Element* node, BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue) {
+    auto childList = node->get_children();
 
     std::string value;
     for(auto& child : childList) {
@@ -96,12 +120,12 @@ namespace ChimeraTK {
 
       // neither found: throw error
       parsingError(node,
-          "Node '" + subnodeName +
+          "Node '" + node->get_name() +
               "' should contain only text, CDATA sections, references or parameters. Instead child '" +
               child->get_name() + "' was found.");
     }
     return value;
-  } // namespace ChimeraTK
+  }
 
   /********************************************************************************************************************/
 
@@ -162,7 +186,7 @@ namespace ChimeraTK {
   template<typename T>
   std::vector<T> LogicalNameMapParser::getValueVectorFromXmlSubnode(const xmlpp::Node* node,
       const std::string& subnodeName, BackendRegisterCatalogue<LNMBackendRegisterInfo> const& catalogue) {
-    auto list = node->find(subnodeName);
+    auto list = getChildElements(node, subnodeName);
     if(list.empty()) {
       parsingError(node,
           "Expected at least one subnode of the type '" + subnodeName + "' below node '" + node->get_name() + "'.");
@@ -170,10 +194,7 @@ namespace ChimeraTK {
 
     std::vector<T> valueVector;
 
-    for(auto& child : list) {
-      const auto* childElement = dynamic_cast<const xmlpp::Element*>(child);
-      if(!childElement) continue; // ignore comments etc.
-
+    for(const auto* childElement : list) {
       // obtain index and resize valueVector if necessary
       auto* indexAttr = childElement->get_attribute("index");
       size_t index = 0;
@@ -261,185 +282,373 @@ namespace ChimeraTK {
   BackendRegisterCatalogue<LNMBackendRegisterInfo> LogicalNameMapParser::parseFile(const std::string& fileName) {
     _fileName = fileName;
 
+    // use the catalogue cache if enabled and up to date. The parameters are part of the key, since they are resolved
+    // while parsing. Files which are not regular (e.g. pipes) can be read only once, so they are not cached.
+    std::string cacheFileName;
+    uint64_t contentHash = 0;
+    std::error_code error;
+    if(CatalogueCache::isEnabled() && std::filesystem::is_regular_file(fileName, error)) {
+      try {
+        parserUtilities::MappedFile file(fileName);
+        // the same file may be used with different parameters at the same time, so they also select the variant
+        std::string parameters;
+        for(const auto& [name, value] : _parameters) {
+          parameters.append(name.c_str(), name.size() + 1);
+          parameters.append(value.c_str(), value.size() + 1);
+        }
+        contentHash = CatalogueCache::hash(parameters, CatalogueCache::hash(file.getContent()));
+        cacheFileName = CatalogueCache::getCacheFileName(fileName, contentHash, "xlmapcache", parameters);
+      }
+      catch(ChimeraTK::logic_error&) {
+        // file cannot be read: leave error reporting to the parser below
+      }
+      if(!cacheFileName.empty()) {
+        auto cached = readCache(cacheFileName, contentHash);
+        if(cached) {
+          return std::move(*cached);
+        }
+      }
+    }
+
     BackendRegisterCatalogue<LNMBackendRegisterInfo> catalogue;
+    _pluginDescriptions.clear();
 
-    // parse the file into a DOM structure
-    xmlpp::DomParser parser;
+    // The file is read as a stream, so the DOM of the entire file is never built. Only the subtree of one register is
+    // expanded at a time, which is then parsed by parseRegister(). Modules are tracked by their start and end tags.
     try {
-      parser.parse_file(fileName);
+      xmlpp::TextReader reader(fileName);
+      RegisterPath currentPath;
+      std::vector<RegisterPath> parentPaths;
+      bool hasNode = reader.read();
+      while(hasNode) {
+        if(reader.get_node_type() == xmlpp::TextReader::EndElement && reader.get_name() == "module") {
+          currentPath = parentPaths.back();
+          parentPaths.pop_back();
+        }
+        if(reader.get_node_type() != xmlpp::TextReader::Element) {
+          hasNode = reader.read();
+          continue;
+        }
+
+        // check root element
+        if(reader.get_depth() == 0) {
+          if(reader.get_name() != "logicalNameMap") {
+            parsingError(reader.get_current_node(), "Expected 'logicalNameMap' tag instead of: " + reader.get_name());
+          }
+          hasNode = reader.read();
+          continue;
+        }
+
+        // module tag found: look for registers and sub-modules in module
+        if(reader.get_name() == "module") {
+          const auto* element = dynamic_cast<const xmlpp::Element*>(reader.get_current_node());
+          const auto* nameAttr = element ? element->get_attribute("name") : nullptr;
+          if(!nameAttr) {
+            parsingError(reader.get_current_node(), "Missing name attribute of 'module' tag.");
+          }
+          // an empty module has no end tag
+          if(!reader.is_empty_element()) {
+            parentPaths.push_back(currentPath);
+            currentPath /= std::string(nameAttr->get_value());
+          }
+          hasNode = reader.read();
+          continue;
+        }
+
+        // register tag found: parse its subtree and skip it in the stream
+        const auto* element = dynamic_cast<const xmlpp::Element*>(reader.expand());
+        if(!element) {
+          throw ChimeraTK::logic_error("Error parsing the xlmap file '" + fileName + "': Cannot expand element.");
+        }
+        parseRegister(currentPath, element, catalogue);
+        hasNode = reader.next();
+      }
     }
     catch(xmlpp::exception& e) {
       throw ChimeraTK::logic_error("Error opening the xlmap file '" + fileName + "': " + e.what());
     }
 
-    // get root element
-    auto* const root = parser.get_document()->get_root_node();
-    if(root->get_name() != "logicalNameMap") {
-      parsingError(root, "Expected 'logicalNameMap' tag instead of: " + root->get_name());
+    if(!cacheFileName.empty()) {
+      writeCache(cacheFileName, contentHash, catalogue);
     }
+    return catalogue;
+  }
 
-    // parsing loop
-    for(const auto& child : root->get_children()) {
-      // cast into element, ignore if not an element (e.g. comment)
-      const auto* element = dynamic_cast<const xmlpp::Element*>(child);
-      if(!element) continue;
+  /********************************************************************************************************************/
 
-      // parse the element
-      parseElement(RegisterPath(), element, catalogue);
-    }
+  std::optional<BackendRegisterCatalogue<LNMBackendRegisterInfo>> LogicalNameMapParser::readCache(
+      const std::string& cacheFileName, uint64_t contentHash) {
+    try {
+      CatalogueCache::Reader reader(cacheFileName, cacheKind, cacheVersion, contentHash);
+      BackendRegisterCatalogue<LNMBackendRegisterInfo> catalogue;
+      // variables are only passed to the backend if the entire cache file could be read
+      std::map<std::string, LNMVariable> variables;
+
+      auto nRegisters = reader.read<uint64_t>();
+      catalogue.reserve(nRegisters);
+      for(uint64_t i = 0; i < nRegisters; ++i) {
+        LNMBackendRegisterInfo info;
+        info.name = std::string(reader.readString());
+        info.targetType = reader.read<LNMBackendRegisterInfo::TargetType>();
+        if(info.targetType > LNMBackendRegisterInfo::TargetType::VARIABLE) {
+          throw ChimeraTK::runtime_error("Invalid target type in catalogue cache file.");
+        }
+        info.deviceName = reader.readString();
+        info.registerName = reader.readString();
+        info.firstIndex = reader.read<uint32_t>();
+        info.length = reader.read<uint32_t>();
+        info.channel = reader.read<uint32_t>();
+        info.bit = reader.read<uint32_t>();
+        info.nChannels = reader.read<uint32_t>();
+        info.valueType = reader.read<DataType::TheType>();
+        if(info.valueType > DataType::Void) {
+          throw ChimeraTK::runtime_error("Invalid value type in catalogue cache file.");
+        }
+        info.readable = reader.read<uint8_t>();
+        info.writeable = reader.read<uint8_t>();
+        info.supportedFlags = AccessModeFlags::deserialize(std::string(reader.readString()));
+
+        if(info.targetType == LNMBackendRegisterInfo::TargetType::CONSTANT ||
+            info.targetType == LNMBackendRegisterInfo::TargetType::VARIABLE) {
+          info._dataDescriptor = ChimeraTK::DataDescriptor(info.valueType);
+          auto& lnmVariable = variables[info.name];
+          callForType(info.valueType, [&](auto arg) {
+            using UserType = decltype(arg);
+            auto& values = boost::fusion::at_key<UserType>(lnmVariable.valueTable.table).latestValue;
+            values.resize(reader.read<uint64_t>());
+            for(auto& value : values) {
+              if constexpr(std::is_same_v<UserType, std::string>) {
+                value = reader.readString();
+              }
+              else {
+                value = reader.read<UserType>();
+              }
+            }
+          });
+          lnmVariable.isConstant = (info.targetType == LNMBackendRegisterInfo::TargetType::CONSTANT);
+          lnmVariable.valueType = info.valueType;
+        }
 
-    return catalogue;
-  }
+        auto nPlugins = reader.read<uint64_t>();
+        for(uint64_t k = 0; k < nPlugins; ++k) {
+          std::string pluginName(reader.readString());
+          std::map<std::string, std::string> parameters;
+          auto nParameters = reader.read<uint64_t>();
+          for(uint64_t l = 0; l < nParameters; ++l) {
+            std::string parameterName(reader.readString());
+            parameters[parameterName] = reader.readString();
+          }
+          info.plugins.push_back(LNMBackend::makePlugin(info, info.plugins.size(), pluginName, parameters));
+        }
 
-  void LogicalNameMapParser::parseElement(const RegisterPath& currentPath, const xmlpp::Element* element,
-      BackendRegisterCatalogue<LNMBackendRegisterInfo>& catalogue) {
-    // module tag found: look for registers and sub-modules in module
-    if(element->get_name() == "module") {
-      // obtain name of the module
-      auto* nameAttr = element->get_attribute("name");
-      if(!nameAttr) {
-        parsingError(element, "Missing name attribute of 'module' tag.");
+        catalogue.addRegister(info);
       }
-      std::string moduleName = nameAttr->get_value();
-
-      // iterate over children in module
-      for(const auto& child : element->get_children()) {
-        // cast into element, ignore if not an element (e.g. comment)
-        const auto* childElement = dynamic_cast<const xmlpp::Element*>(child);
-        if(!childElement) continue;
 
-        // parse the element
-        parseElement(currentPath / moduleName, childElement, catalogue);
+      if(!reader.atEnd()) {
+        throw ChimeraTK::runtime_error("Unexpected data at the end of the catalogue cache file.");
       }
+      _variables.merge(variables);
+      return catalogue;
     }
+    catch(ChimeraTK::runtime_error&) {
+      // cache miss or unusable cache file: the xlmap file will be parsed
+    }
+    catch(ChimeraTK::logic_error&) {
+      // inconsistent content (e.g. a corrupt cache file): the xlmap file will be parsed
+    }
+    return std::nullopt;
+  }
 
-    // register tag found: create new entry in map
-    else {
-      // obtain the type
-      std::string type = element->get_name();
+  /********************************************************************************************************************/
 
-      // obtain name of logical register
-      auto* nameAttr = element->get_attribute("name");
-      if(!nameAttr) {
-        parsingError(element, "Missing name attribute of '" + type + "' tag.");
-      }
-      RegisterPath registerName = currentPath / std::string(nameAttr->get_value());
-
-      // create new RegisterInfo object
-      LNMBackendRegisterInfo info;
-      info.name = registerName;
-      if(type == "redirectedRegister") {
-        info.targetType = LNMBackendRegisterInfo::TargetType::REGISTER;
-        info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
-        info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
-        info.firstIndex = getValueFromXmlSubnode<unsigned int>(element, "targetStartIndex", catalogue, true, 0);
-        info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 0);
-        info.nChannels = 0;
-      }
-      else if(type == "redirectedChannel") {
-        info.targetType = LNMBackendRegisterInfo::TargetType::CHANNEL;
-        info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
-        info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
-        info.channel = getValueFromXmlSubnode<unsigned int>(element, "targetChannel", catalogue);
-        info.firstIndex = getValueFromXmlSubnode<unsigned int>(element, "targetStartIndex", catalogue, true, 0);
-        info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 0);
-        info.nChannels = 1;
-      }
-      else if(type == "redirectedBit") {
-        info.targetType = LNMBackendRegisterInfo::TargetType::BIT;
-        info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
-        info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
-        info.bit = getValueFromXmlSubnode<unsigned int>(element, "targetBit", catalogue);
-        info.firstIndex = 0;
-        info.length = 0;
-        info.nChannels = 1;
-      }
-      else if(type == "constant") {
-        std::string constantType = getValueFromXmlSubnode<std::string>(element, "type", catalogue);
-        if(constantType == "integer") constantType = "int32";
-        info.targetType = LNMBackendRegisterInfo::TargetType::CONSTANT;
-        info.valueType = DataType(constantType);
+  void LogicalNameMapParser::writeCache(const std::string& cacheFileName, uint64_t contentHash,
+      const BackendRegisterCatalogue<LNMBackendRegisterInfo>& catalogue) {
+    assert(_pluginDescriptions.size() == catalogue.getNumberOfRegisters());
+    CatalogueCache::Writer writer(cacheKind, cacheVersion, contentHash);
+
+    writer.write(uint64_t(catalogue.getNumberOfRegisters()));
+    auto pluginDescriptions = _pluginDescriptions.begin();
+    for(const auto& info : catalogue) {
+      writer.writeString(std::string(info.name));
+      writer.write(info.targetType);
+      writer.writeString(info.deviceName);
+      writer.writeString(info.registerName);
+      writer.write(uint32_t(info.firstIndex));
+      writer.write(uint32_t(info.length));
+      writer.write(uint32_t(info.channel));
+      writer.write(uint32_t(info.bit));
+      writer.write(uint32_t(info.nChannels));
+      writer.write(DataType::TheType(info.valueType));
+      writer.write(uint8_t(info.readable));
+      writer.write(uint8_t(info.writeable));
+      writer.writeString(info.supportedFlags.serialize());
+
+      if(info.targetType == LNMBackendRegisterInfo::TargetType::CONSTANT ||
+          info.targetType == LNMBackendRegisterInfo::TargetType::VARIABLE) {
         auto& lnmVariable = _variables[info.name];
         callForType(info.valueType, [&](auto arg) {
-          boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table).latestValue =
-              this->getValueVectorFromXmlSubnode<decltype(arg)>(element, "value", catalogue);
+          using UserType = decltype(arg);
+          const auto& values = boost::fusion::at_key<UserType>(lnmVariable.valueTable.table).latestValue;
+          writer.write(uint64_t(values.size()));
+          for(const auto& value : values) {
+            if constexpr(std::is_same_v<UserType, std::string>) {
+              writer.writeString(value);
+            }
+            else {
+              writer.write(value);
+            }
+          }
         });
-        lnmVariable.isConstant = true;
-        lnmVariable.valueType = info.valueType;
-        info.firstIndex = 0;
-        info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 1);
-        info.nChannels = 1;
-        info.writeable = false;
-        info.readable = true;
-        info._dataDescriptor = ChimeraTK::DataDescriptor(info.valueType);
       }
-      else if(type == "variable") {
-        std::string constantType = getValueFromXmlSubnode<std::string>(element, "type", catalogue);
-        if(constantType == "integer") constantType = "int32";
-        info.targetType = LNMBackendRegisterInfo::TargetType::VARIABLE;
-        info.valueType = DataType(constantType);
-        auto& lnmVariable = _variables[info.name];
-        callForType(info.valueType, [&](auto arg) {
-          boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table).latestValue =
-              this->getValueVectorFromXmlSubnode<decltype(arg)>(element, "value", catalogue);
-        });
-        lnmVariable.isConstant = false;
-        lnmVariable.valueType = info.valueType;
-        info.firstIndex = 0;
-        info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 1);
-        info.nChannels = 1;
-        info.writeable = true;
-        info.readable = true;
-        info._dataDescriptor = ChimeraTK::DataDescriptor(info.valueType);
-        info.supportedFlags = {AccessMode::wait_for_new_data};
+
+      writer.write(uint64_t(pluginDescriptions->size()));
+      for(const auto& plugin : *pluginDescriptions) {
+        writer.writeString(plugin.name);
+        writer.write(uint64_t(plugin.parameters.size()));
+        for(const auto& [parameterName, value] : plugin.parameters) {
+          writer.writeString(parameterName);
+          writer.writeString(value);
+        }
       }
-      else {
-        parsingError(element, "Wrong logical register type: " + type);
+      ++pluginDescriptions;
+    }
+
+    writer.store(cacheFileName);
+  }
+
+  /********************************************************************************************************************/
+
+  void LogicalNameMapParser::parseRegister(const RegisterPath& currentPath, const xmlpp::Element* element,
+      BackendRegisterCatalogue<LNMBackendRegisterInfo>& catalogue) {
+    // obtain the type
+    std::string type = element->get_name();
+
+    // obtain name of logical register
+    auto* nameAttr = element->get_attribute("name");
+    if(!nameAttr) {
+      parsingError(element, "Missing name attribute of '" + type + "' tag.");
+    }
+    RegisterPath registerName = currentPath / std::string(nameAttr->get_value());
+
+    // create new RegisterInfo object
+    LNMBackendRegisterInfo info;
+    info.name = registerName;
+    if(type == "redirectedRegister") {
+      info.targetType = LNMBackendRegisterInfo::TargetType::REGISTER;
+      info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
+      info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
+      info.firstIndex = getValueFromXmlSubnode<unsigned int>(element, "targetStartIndex", catalogue, true, 0);
+      info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 0);
+      info.nChannels = 0;
+    }
+    else if(type == "redirectedChannel") {
+      info.targetType = LNMBackendRegisterInfo::TargetType::CHANNEL;
+      info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
+      info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
+      info.channel = getValueFromXmlSubnode<unsigned int>(element, "targetChannel", catalogue);
+      info.firstIndex = getValueFromXmlSubnode<unsigned int>(element, "targetStartIndex", catalogue, true, 0);
+      info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 0);
+      info.nChannels = 1;
+    }
+    else if(type == "redirectedBit") {
+      info.targetType = LNMBackendRegisterInfo::TargetType::BIT;
+      info.deviceName = getValueFromXmlSubnode<std::string>(element, "targetDevice", catalogue);
+      info.registerName = getValueFromXmlSubnode<std::string>(element, "targetRegister", catalogue);
+      info.bit = getValueFromXmlSubnode<unsigned int>(element, "targetBit", catalogue);
+      info.firstIndex = 0;
+      info.length = 0;
+      info.nChannels = 1;
+    }
+    else if(type == "constant") {
+      std::string constantType = getValueFromXmlSubnode<std::string>(element, "type", catalogue);
+      if(constantType == "integer") constantType = "int32";
+      info.targetType = LNMBackendRegisterInfo::TargetType::CONSTANT;
+      info.valueType = DataType(constantType);
+      auto& lnmVariable = _variables[info.name];
+      callForType(info.valueType, [&](auto arg) {
+        boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table).latestValue =
+            this->getValueVectorFromXmlSubnode<decltype(arg)>(element, "value", catalogue);
+      });
+      lnmVariable.isConstant = true;
+      lnmVariable.valueType = info.valueType;
+      info.firstIndex = 0;
+      info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 1);
+      info.nChannels = 1;
+      info.writeable = false;
+      info.readable = true;
+      info._dataDescriptor = ChimeraTK::DataDescriptor(info.valueType);
+    }
+    else if(type == "variable") {
+      std::string constantType = getValueFromXmlSubnode<std::string>(element, "type", catalogue);
+      if(constantType == "integer") constantType = "int32";
+      info.targetType = LNMBackendRegisterInfo::TargetType::VARIABLE;
+      info.valueType = DataType(constantType);
+      auto& lnmVariable = _variables[info.name];
+      callForType(info.valueType, [&](auto arg) {
+        boost::fusion::at_key<decltype(arg)>(lnmVariable.valueTable.table).latestValue =
+            this->getValueVectorFromXmlSubnode<decltype(arg)>(element, "value", catalogue);
+      });
+      lnmVariable.isConstant = false;
+      lnmVariable.valueType = info.valueType;
+      info.firstIndex = 0;
+      info.length = getValueFromXmlSubnode<unsigned int>(element, "numberOfElements", catalogue, true, 1);
+      info.nChannels = 1;
+      info.writeable = true;
+      info.readable = true;
+      info._dataDescriptor = ChimeraTK::DataDescriptor(info.valueType);
+      info.supportedFlags = {AccessMode::wait_for_new_data};
+    }
+    else {
+      parsingError(element, "Wrong logical register type: " + type);
+    }
+
+    // iterate over children of the register to find plugins
+    std::vector<PluginDescription> pluginDescriptions;
+    for(const auto& child : element->get_children()) {
+      // cast into element, ignore if not an element (e.g. comment)
+      const auto* childElement = dynamic_cast<const xmlpp::Element*>(child);
+      if(!childElement) continue;
+      if(childElement->get_name() != "plugin") continue; // look only for plugins
+
+      // get name of plugin
+      auto* pluginNameAttr = childElement->get_attribute("name");
+      if(!pluginNameAttr) {
+        parsingError(childElement, "Missing name attribute of 'plugin' tag.");
       }
+      std::string pluginName = pluginNameAttr->get_value();
 
-      // iterate over children of the register to find plugins
-      for(const auto& child : element->get_children()) {
+      // collect parameters
+      std::map<std::string, std::string> parameters;
+      for(const auto& paramchild : childElement->get_children()) {
         // cast into element, ignore if not an element (e.g. comment)
-        const auto* childElement = dynamic_cast<const xmlpp::Element*>(child);
-        if(!childElement) continue;
-        if(childElement->get_name() != "plugin") continue; // look only for plugins
-
-        // get name of plugin
-        auto* pluginNameAttr = childElement->get_attribute("name");
-        if(!pluginNameAttr) {
-          parsingError(childElement, "Missing name attribute of 'plugin' tag.");
+        const auto* paramElement = dynamic_cast<const xmlpp::Element*>(paramchild);
+        if(!paramElement) continue;
+        if(paramElement->get_name() != "parameter") {
+          parsingError(paramElement, "Unexpected element '" + paramElement->get_name() + "' inside plugin tag.");
         }
-        std::string pluginName = pluginNameAttr->get_value();
-
-        // collect parameters
-        std::map<std::string, std::string> parameters;
-        for(const auto& paramchild : childElement->get_children()) {
-          // cast into element, ignore if not an element (e.g. comment)
-          const auto* paramElement = dynamic_cast<const xmlpp::Element*>(paramchild);
-          if(!paramElement) continue;
-          if(paramElement->get_name() != "parameter") {
-            parsingError(paramElement, "Unexpected element '" + paramElement->get_name() + "' inside plugin tag.");
-          }
-
-          // get name of parameter
-          auto* parameterNameAttr = paramElement->get_attribute("name");
-          if(!pluginNameAttr) {
-            parsingError(paramElement, "Missing name attribute of 'parameter' tag.");
-          }
-          std::string parameterName = parameterNameAttr->get_value();
 
-          // get value of parameter and store in map
-          parameters[parameterName] =
-              getValueFromXmlSubnode<std::string>(childElement, "parameter[@name='" + parameterName + "']", catalogue);
+        // get name of parameter
+        auto* parameterNameAttr = paramElement->get_attribute("name");
+        if(!parameterNameAttr) {
+          parsingError(paramElement, "Missing name attribute of 'parameter' tag.");
         }
+        std::string parameterName = parameterNameAttr->get_value();
 
-        // create instance of plugin and add to the list in the register info
-        info.plugins.push_back(LNMBackend::makePlugin(info, info.plugins.size(), pluginName, parameters));
+        // get value of parameter and store in map
+        if(!parameters.emplace(parameterName, getValueFromXmlNode(paramElement, catalogue)).second) {
+          parsingError(
+              paramElement, "Parameter '" + parameterName + "' of plugin '" + pluginName + "' is given twice.");
+        }
       }
 
-      // add register to catalogue
-      catalogue.addRegister(info);
+      // create instance of plugin and add to the list in the register info
+      info.plugins.push_back(LNMBackend::makePlugin(info, info.plugins.size(), pluginName, parameters));
+      pluginDescriptions.push_back({pluginName, std::move(parameters)});
     }
+
+    // add register to catalogue
+    catalogue.addRegister(info);
+    _pluginDescriptions.push_back(std::move(pluginDescriptions));
   }
 
   /********************************************************************************************************************/
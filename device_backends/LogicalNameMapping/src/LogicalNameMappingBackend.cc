@@ -10,6 +10,10 @@
 #include "LogicalNameMapParser.h"
 #include "SupportedUserTypes.h"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 namespace ChimeraTK {
 
   LogicalNameMappingBackend::LogicalNameMappingBackend(std::string lmapFileName)
@@ -28,9 +32,12 @@ namespace ChimeraTK {
     LogicalNameMapParser parser = LogicalNameMapParser(_parameters, _variables);
     _catalogue_mutable = parser.parseFile(_lmapFileName);
 
-    // create all devices referenced in the map
-    for(const auto& devName : getTargetDevices()) {
-      _devices[devName] = BackendFactory::getInstance().createBackend(devName);
+    // create all devices referenced in the map, unless they are created on first use
+    if(!_lazyTargets) {
+      std::lock_guard<std::mutex> lock(_devicesMutex);
+      for(const auto& devName : getTargetDevices()) {
+        _devices[devName] = BackendFactory::getInstance().createBackend(devName);
+      }
     }
     // iterate over plugins and call postParsingHook
     for(auto& reg : _catalogue_mutable) {
@@ -48,9 +55,7 @@ namespace ChimeraTK {
     parse();
 
     // open all referenced devices (unconditionally, open() is also used for recovery)
-    for(const auto& device : _devices) {
-      device.second->open();
-    }
+    openTargetDevices();
 
     // flag as opened
     _versionOnOpen = ChimeraTK::VersionNumber{};
@@ -93,7 +98,7 @@ namespace ChimeraTK {
     }
 
     // close all referenced devices
-    for(const auto& device : _devices) {
+    for(const auto& device : getCreatedTargetDevices()) {
       if(device.second->isOpen()) device.second->close();
     }
     // flag as closed
@@ -113,6 +118,28 @@ namespace ChimeraTK {
     }
     auto ptr = boost::make_shared<LogicalNameMappingBackend>(parameters["map"]);
     parameters.erase(parameters.find("map"));
+
+    // reserved parameters controlling the target devices, which are not passed on to the map file
+    auto lazyTargets = parameters.find("lazyTargets");
+    if(lazyTargets != parameters.end()) {
+      if(lazyTargets->second != "0" && lazyTargets->second != "1") {
+        throw ChimeraTK::logic_error("LogicalNameMappingBackend: Parameter lazyTargets must be 0 or 1.");
+      }
+      ptr->_lazyTargets = (lazyTargets->second == "1");
+      parameters.erase(lazyTargets);
+    }
+    auto openConcurrency = parameters.find("openConcurrency");
+    if(openConcurrency != parameters.end()) {
+      try {
+        auto value = std::stol(openConcurrency->second);
+        if(value < 1) throw std::out_of_range("");
+        ptr->_openConcurrency = size_t(value);
+      }
+      catch(std::exception&) {
+        throw ChimeraTK::logic_error("LogicalNameMappingBackend: Parameter openConcurrency must be a positive integer.");
+      }
+      parameters.erase(openConcurrency);
+    }
     ptr->_parameters = parameters;
     return boost::static_pointer_cast<DeviceBackend>(ptr);
   }
@@ -171,22 +198,22 @@ namespace ChimeraTK {
     // implementation for each type
     boost::shared_ptr<NDRegisterAccessor<UserType>> ptr;
     if(info.targetType == LNMBackendRegisterInfo::TargetType::REGISTER) {
-      DeviceBackend* _targetDevice;
       std::string devName = info.deviceName;
+      boost::shared_ptr<DeviceBackend> targetDevice;
       if(devName != "this") {
-        _targetDevice = _devices[info.deviceName].get();
+        targetDevice = getTargetDevice(devName);
       }
       else {
-        _targetDevice = this;
+        targetDevice = shared_from_this();
       }
       // make sure the target device exists
-      if(_targetDevice == nullptr) {
+      if(targetDevice == nullptr) {
         throw ChimeraTK::logic_error("Target device for this logical register is not opened. See "
                                      "exception thrown in open()!");
       }
       // obtain underlying register accessor
-      ptr = _targetDevice->getRegisterAccessor<UserType>(
-          RegisterPath(info.registerName), actualLength, actualOffset, flags);
+      ptr = getTargetAccessor<UserType>(
+          targetDevice, RegisterPath(info.registerName), actualLength, actualOffset, flags);
     }
     else if(info.targetType == LNMBackendRegisterInfo::TargetType::CHANNEL) {
       ptr = boost::shared_ptr<NDRegisterAccessor<UserType>>(new LNMBackendChannelAccessor<UserType>(
@@ -213,7 +240,7 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   RegisterCatalogue LogicalNameMappingBackend::getRegisterCatalogue() const {
-    if(catalogueCompleted) return RegisterCatalogue(_catalogue_mutable.clone());
+    if(catalogueCompleted) return RegisterCatalogue(_catalogueSnapshot);
     parse();
 
     // fill in information to the catalogue from the target devices
@@ -230,7 +257,7 @@ namespace ChimeraTK {
       RegisterInfo target_info(lnmInfo.clone()); // Start with a clone of this info as there is not default constructor
       // In case the device is not "this" replace it with the real target register info
       if(devName != "this") {
-        auto cat = _devices.at(devName)->getRegisterCatalogue();
+        auto cat = getTargetDevice(devName)->getRegisterCatalogue();
         if(!cat.hasRegister(lnmInfo.registerName)) continue;
         target_info = cat.getRegister(lnmInfo.registerName);
       }
@@ -238,7 +265,7 @@ namespace ChimeraTK {
         target_info = _catalogue_mutable.getRegister(lnmInfo.registerName);
         // target_info might also be affected by plugins. e.g. forceReadOnly plugin
         // we need to process plugin list of target register before taking over anything
-        auto& i = dynamic_cast<LNMBackendRegisterInfo&>(target_info.getImpl());
+        const auto& i = dynamic_cast<const LNMBackendRegisterInfo&>(target_info.getImpl());
         for(auto& plugin : i.plugins) {
           plugin->updateRegisterInfo(_catalogue_mutable);
         }
@@ -276,7 +303,8 @@ namespace ChimeraTK {
     }
 
     catalogueCompleted = true;
-    return RegisterCatalogue(_catalogue_mutable.clone());
+    _catalogueSnapshot = _catalogue_mutable.clone();
+    return RegisterCatalogue(_catalogueSnapshot);
   }
 
   /********************************************************************************************************************/
@@ -302,7 +330,7 @@ namespace ChimeraTK {
 
   void LogicalNameMappingBackend::setExceptionImpl() noexcept {
     auto message = getActiveExceptionMessage();
-    for(auto& d : _devices) {
+    for(auto& d : getCreatedTargetDevices()) {
       d.second->setException(message);
     }
 
@@ -324,6 +352,7 @@ namespace ChimeraTK {
               }
             }
           });
+          _variables[info.name].notifyReaders();
         }
       }
     }
@@ -343,12 +372,13 @@ namespace ChimeraTK {
 
   void LogicalNameMappingBackend::activateAsyncRead() noexcept {
     if(!isFunctional()) return;
+    DeviceBackendImpl::activateAsyncRead();
 
     // store information locally, as variable accessors have async read
     _asyncReadActive = true;
 
     // delegate to target devices
-    for(auto& d : _devices) {
+    for(auto& d : getCreatedTargetDevices()) {
       d.second->activateAsyncRead();
     }
 
@@ -382,8 +412,113 @@ namespace ChimeraTK {
           std::ignore = e;
           assert(false);
         }
+        lnmVariable.notifyReaders();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<DeviceBackend> LogicalNameMappingBackend::getTargetDevice(const std::string& devName) const {
+    parse();
+    boost::shared_ptr<DeviceBackend> device;
+    {
+      std::lock_guard<std::mutex> lock(_devicesMutex);
+      auto it = _devices.find(devName);
+      if(it != _devices.end()) {
+        device = it->second;
+      }
+      else if(_lazyTargets && getTargetDevices().count(devName)) {
+        device = BackendFactory::getInstance().createBackend(devName);
+        _devices[devName] = device;
+      }
+      else {
+        return nullptr;
+      }
+    }
+
+    // A target created on first use is not opened by open(), so open it now. The open must not happen while holding
+    // the lock, since a failure calls setException(), which iterates the target devices.
+    if(_lazyTargets && _opened && !device->isOpen()) {
+      try {
+        device->open();
+        if(_asyncReadActive) device->activateAsyncRead();
+      }
+      catch(ChimeraTK::runtime_error& e) {
+        // The target will be opened again in the recovery through open(). Until then, the accessors obtained through
+        // getTargetAccessor() throw a runtime_error.
+        const_cast<LogicalNameMappingBackend*>(this)->setException(e.what());
+      }
+    }
+    return device;
+  }
+
+  /********************************************************************************************************************/
+
+  std::map<std::string, boost::shared_ptr<DeviceBackend>> LogicalNameMappingBackend::getCreatedTargetDevices() const {
+    std::lock_guard<std::mutex> lock(_devicesMutex);
+    return _devices;
+  }
+
+  /********************************************************************************************************************/
+
+  void LogicalNameMappingBackend::openTargetDevices() {
+    // the same backend instance might be referenced under different names (e.g. aliases in the dmap file)
+    std::vector<std::pair<std::string, boost::shared_ptr<DeviceBackend>>> targets;
+    for(const auto& device : getCreatedTargetDevices()) {
+      bool known = std::any_of(
+          targets.begin(), targets.end(), [&](const auto& target) { return target.second == device.second; });
+      if(!known) targets.emplace_back(device);
+    }
+    if(targets.empty()) return;
+
+    // Open the targets concurrently, since each open might take long (network connections, firmware checks). The
+    // calling thread takes part, so nothing is spawned for a single target.
+    std::vector<std::exception_ptr> errors(targets.size());
+    std::atomic<size_t> nextTarget{0};
+    auto worker = [&] {
+      for(size_t i = nextTarget++; i < targets.size(); i = nextTarget++) {
+        try {
+          targets[i].second->open();
+        }
+        catch(...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+    std::vector<std::thread> threads;
+    for(size_t i = 1; i < std::min(_openConcurrency, targets.size()); ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for(auto& t : threads) t.join();
+
+    // Report all failures at once. A single failure is rethrown unchanged.
+    size_t nFailed = 0;
+    bool hasLogicError = false;
+    std::string message;
+    std::exception_ptr firstError;
+    for(size_t i = 0; i < targets.size(); ++i) {
+      if(!errors[i]) continue;
+      if(!firstError) firstError = errors[i];
+      ++nFailed;
+      try {
+        std::rethrow_exception(errors[i]);
+      }
+      catch(ChimeraTK::logic_error& e) {
+        hasLogicError = true;
+        message += "; '" + targets[i].first + "': " + e.what();
+      }
+      catch(std::exception& e) {
+        message += "; '" + targets[i].first + "': " + e.what();
       }
     }
+    if(nFailed == 0) return;
+    if(nFailed == 1) std::rethrow_exception(firstError);
+    message = "LogicalNameMappingBackend: Failed to open " + std::to_string(nFailed) + " of " +
+        std::to_string(targets.size()) + " target devices: " + message.substr(2);
+    if(hasLogicError) throw ChimeraTK::logic_error(message);
+    throw ChimeraTK::runtime_error(message);
   }
 
   /********************************************************************************************************************/
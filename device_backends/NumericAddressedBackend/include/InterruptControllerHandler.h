@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ChimeraTK {
+
+  class NumericAddressedBackend;
+  class NumericAddressedInterruptDispatcher;
+  class NumericAddressedRegisterCatalogue;
+
+  /** The InterruptControllerHandler serves an interrupt controller which multiplexes several sub-interrupts onto one
+   *  interrupt. When the interrupt arrives, the handler reads the status register of the controller, acknowledges all
+   *  asserted sub-interrupts with a single write, and triggers the NumericAddressedInterruptDispatcher of each asserted
+   *  sub-interrupt. A sub-interrupt can itself be served by a controller, which allows arbitrarily nested interrupts.
+   *
+   *  The controller is described in the map file metadata:
+   *
+   *    \@INTERRUPT_CONTROLLER:<interrupt> <style>;<key>=<value>;...
+   *
+   *  where <interrupt> is the (possibly nested) interrupt the controller is connected to, e.g. "3" or "3:1". Two
+   *  styles are supported:
+   *
+   *  * INTC: The registers are found by name in the module given by the key "module". The status register ISR is
+   *    mandatory. If present, the acknowledge register IAR, the interrupt enable register IER and the master enable
+   *    register MER are used.
+   *  * FLAT: Each register is given by its own key. "status" is mandatory, "acknowledge", "mask" and "enable" are
+   *    optional.
+   *
+   *  All registers are accessed as raw 32 bit words, bit n corresponding to sub-interrupt n. Asserted bits are written
+   *  to the acknowledge register (write 1 to clear). On activation, the bits of all sub-interrupts used in the map file
+   *  are written to the mask register (IER), and the enable register (MER) is written with 1 (INTC: 3, i.e. master
+   *  enable and hardware interrupt enable).
+   */
+  class InterruptControllerHandler {
+   public:
+    /** Create the handler from the metadata value describing the controller. Throws ChimeraTK::logic_error if the
+     *  description is invalid or refers to registers which do not exist in the catalogue.
+     */
+    InterruptControllerHandler(NumericAddressedBackend& backend, const NumericAddressedRegisterCatalogue& catalogue,
+        std::vector<uint32_t> controllerId, const std::string& description);
+
+    /** Return the dispatcher for the given sub-interrupt. It is created if it does not exist yet. Must only be called
+     *  while the backend is constructed, as the list of dispatchers is not protected against concurrent access.
+     */
+    boost::shared_ptr<NumericAddressedInterruptDispatcher> addSubInterrupt(uint32_t subInterrupt);
+
+    /** Return the dispatcher for the given sub-interrupt. Throws ChimeraTK::logic_error if it does not exist. */
+    [[nodiscard]] boost::shared_ptr<NumericAddressedInterruptDispatcher> getSubInterrupt(uint32_t subInterrupt) const;
+
+    /** Read the status register, acknowledge and dispatch all asserted sub-interrupts. To be called by the
+     *  NumericAddressedInterruptDispatcher of the interrupt the controller is connected to.
+     */
+    void handle();
+
+    /** Enable the sub-interrupts in the controller and activate their dispatchers. */
+    void activate();
+
+    /** Deactivate the dispatchers of all sub-interrupts. */
+    void deactivate();
+
+    /** Send the exception to the dispatchers of all sub-interrupts. */
+    void sendException(const std::exception_ptr& e);
+
+   protected:
+    struct Register {
+      uint64_t bar{0};
+      uint64_t address{0};
+      bool isUsed{false};
+    };
+
+    /** Look up the register in the catalogue. Throws ChimeraTK::logic_error if it does not exist. */
+    Register findRegister(const NumericAddressedRegisterCatalogue& catalogue, const std::string& name) const;
+
+    /** Write a single word. ChimeraTK::runtime_error is propagated. */
+    void writeRegister(const Register& reg, uint32_t value);
+
+    /** Return the name of the controller for error messages. */
+    std::string getName() const;
+
+    NumericAddressedBackend& _backend;
+    std::vector<uint32_t> _controllerId;
+
+    Register _status;
+    Register _acknowledge;
+    Register _mask;
+    Register _enable;
+    uint32_t _enableValue{1};
+
+    std::map<uint32_t, boost::shared_ptr<NumericAddressedInterruptDispatcher>> _dispatchers;
+  };
+
+} // namespace ChimeraTK
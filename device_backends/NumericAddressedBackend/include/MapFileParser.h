@@ -10,7 +10,9 @@
 #include <fstream>
 #include <iomanip>
 #include <list>
+#include <optional>
 #include <string>
+#include <string_view>
 
 namespace ChimeraTK {
 
@@ -25,6 +27,8 @@ namespace ChimeraTK {
      * RegisterInfo object describing all registers and metadata available in
      * file.
      *
+     * If the CatalogueCache is enabled, the result is read from the cache file instead of parsing the map file, as
+     * long as the content of the map file has not changed. Otherwise the cache file is written after parsing.
      *
      * @throw ChimeraTK::logic_error if parsing error detected or the specified MAP
      * file cannot be opened
@@ -35,7 +39,7 @@ namespace ChimeraTK {
      */
     std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> parse(const std::string& file_name);
 
-   private:
+   protected:
     /** Hold parsed content of a single line */
     struct ParsedLine {
       RegisterPath pathName;      /**< Name of register */
@@ -61,18 +65,33 @@ namespace ChimeraTK {
     static std::pair<RegisterPath, std::string> splitStringAtLastDot(RegisterPath moduleDotName);
 
     static std::pair<NumericAddressedRegisterInfo::Type, int> getTypeAndNFractionalBits(
-        const std::string& bitInterpretation, uint32_t width);
+        std::string_view bitInterpretation, uint32_t width);
 
     // returns an empty vector if the type is not INTERRUPT
-    static std::vector<uint32_t> getInterruptId(std::string accessType);
+    static std::vector<uint32_t> getInterruptId(std::string_view accessType);
 
     static void checkFileConsitencyAndThrowIfError(NumericAddressedRegisterInfo::Access registerAccessMode,
         NumericAddressedRegisterInfo::Type registerType, uint32_t nElements, uint64_t address, uint32_t nBytes,
         uint64_t bar, uint32_t width, int32_t nFractionalBits, bool signedFlag);
 
-    void parseMetaData(std::string line);
+    void parseMetaData(std::string_view line);
 
-    ParsedLine parseLine(const std::string& line);
+    ParsedLine parseLine(std::string_view line);
+
+    /** Read the result of parse() from the catalogue cache. Returns std::nullopt on a cache miss. */
+    static std::optional<std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>> readCache(
+        const std::string& cacheFileName, uint64_t contentHash);
+
+    /** Write the result of parse() to the catalogue cache. */
+    static void writeCache(const std::string& cacheFileName, uint64_t contentHash,
+        const std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>& catalogues);
+
+    /** Kind and format version of the cache files. Increase the version when changing the format. */
+    static constexpr std::string_view cacheKind{"NumericAddressedRegisterCatalogue"};
+    static constexpr uint32_t cacheVersion{1};
+
+    /** Fill the catalogue from the parsed lines. Called at the end of parse(). */
+    std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> makeCatalogue();
 
     /**
      * On detection of a AREA_MULTIPLEXED_SEQUENCE line, collects the associated paresed lines and creates the
@@ -127,7 +146,8 @@ namespace ChimeraTK {
     uint32_t line_nr = 0;
 
     std::vector<ParsedLine> parsedLines;
-    std::map<RegisterPath, const ParsedLine&> parsedLinesMap;
+    /// Parsed lines by register name. The key is the name with "/" as separator, which is much faster to compare.
+    std::map<std::string, const ParsedLine&> parsedLinesMap;
   };
 
 } // namespace ChimeraTK
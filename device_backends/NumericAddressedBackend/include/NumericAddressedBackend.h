@@ -4,8 +4,12 @@
 
 #include "DeviceBackendImpl.h"
 #include "NumericAddressedRegisterCatalogue.h"
+#include "TimerInterruptSource.h"
+#include "TransferScheduler.h"
 #include "VersionNumber.h"
 
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <string>
 
@@ -13,6 +17,7 @@ namespace ChimeraTK {
 
   class NumericAddressedLowLevelTransferElement;
   class NumericAddressedInterruptDispatcher;
+  class TransferElementAbstractor;
 
   /** Base class for address-based device backends (e.g. PICe, Rebot, ...) */
   class NumericAddressedBackend : public DeviceBackendImpl {
@@ -101,11 +106,14 @@ namespace ChimeraTK {
      */
     NumericAddressedRegisterInfo getRegisterInfo(const RegisterPath& registerPathName);
 
+    /**
+     *  Activates all asynchronous accessors and starts the timers of the timer interrupts.
+     */
     void activateAsyncRead() noexcept override;
     void setExceptionImpl() noexcept override;
 
     /**
-     *  Deactivates all asynchronous accessors and calls closeImpl().
+     *  Stops the timers of the timer interrupts, deactivates all asynchronous accessors and calls closeImpl().
      */
     void close() final;
 
@@ -121,16 +129,79 @@ namespace ChimeraTK {
      *  only those threads are running for which accessors have been created. The function implementation must check
      *  whether the according thread is already running and should do nothing when called a second time.
      *
+     *  The function is not called for timer interrupts (see getTimerInterruptSource()).
+     *
      *  The function has an empty default implementation.
      */
     virtual void startInterruptHandlingThread(uint32_t interruptNumber);
 
+    /**
+     *  Return the length of the data transport queue for push-type accessors of the given register.
+     *
+     *  The length can be configured in the map file through metadata. "@ASYNC_QUEUE_SIZE <n>" sets the default for all
+     *  registers of the backend, "@ASYNC_QUEUE_SIZE:<register> <n>" sets it for the given register only. Without
+     *  configuration, AsyncQueueStatistics::defaultQueueSize is used.
+     *
+     *  A length of 1 turns the queue into a mailbox: each new value replaces the value which has not been read yet, so
+     *  the consumer always receives the latest value and never has to drain stale entries.
+     */
+    [[nodiscard]] size_t getAsyncQueueSize(const RegisterPath& registerPathName) const;
+
+    /**
+     *  Return the timer of the given timer interrupt, or nullptr if the interrupt is not a timer interrupt.
+     *
+     *  Registers without hardware interrupt can be read with push-type accessors through a timer interrupt, which is a
+     *  virtual primary interrupt triggered periodically by the backend itself. The registers are assigned to the
+     *  interrupt in the map file like for hardware interrupts, and the timer is declared with the metadata
+     *  "@TIMER_INTERRUPT:<interrupt> <period in milliseconds>". All registers of the interrupt are read in one
+     *  TransferGroup by a single timer thread. The timer runs while asynchronous read is active. No interrupt
+     *  handling thread is started for timer interrupts (see startInterruptHandlingThread()).
+     */
+    TimerInterruptSource* getTimerInterruptSource(uint32_t interruptNumber);
+
+    /**
+     *  Replace the clock of all timer interrupts, e.g. by a TimerInterruptSource::SimulatedClock in tests. Throws
+     *  ChimeraTK::logic_error if the timers are running, i.e. while asynchronous read is active.
+     */
+    void setTimerInterruptClock(const std::shared_ptr<TimerInterruptSource::Clock>& clock);
+
+    /**
+     *  Enable the scheduling of transfers. All transfers of the backend are then serialised by a TransferScheduler,
+     *  which lets the waiting transfer with the highest priority class (see setTransferPriority()) proceed first.
+     *  Transfers larger than the given chunk size are split into chunks which are scheduled separately, so a small
+     *  high-priority transfer does not have to wait for a large transfer to complete. A chunk size of 0 disables the
+     *  splitting. The chunk size is rounded to a multiple of the word size and of minimumTransferAlignment().
+     *
+     *  Note that a transfer split into chunks is not atomic any more. Backends which can execute transfers in parallel
+     *  lose this ability while the scheduling is enabled.
+     *
+     *  The scheduling can also be enabled in the map file with the metadata "@TRANSFER_SCHEDULING <chunk size in
+     *  bytes>". It cannot be disabled again.
+     */
+    void enableTransferScheduling(size_t chunkSizeInBytes);
+
+    /**
+     *  Set the priority class of all transfers executed by the given accessor. The default is TransferPriority::normal.
+     *  The priority only has an effect if the scheduling of transfers is enabled (see enableTransferScheduling()).
+     *
+     *  The priority is a property of the low-level transfer, which is shared by all accessors merged into the same
+     *  transfer by a TransferGroup. A merged transfer uses the highest priority of its accessors.
+     *
+     *  Throws ChimeraTK::logic_error if the accessor does not directly access a NumericAddressedBackend, which is also
+     *  the case for push-type accessors. Accessors of multiplexed 2D registers are scheduled as well, but always with
+     *  TransferPriority::normal.
+     */
+    static void setTransferPriority(TransferElementAbstractor& accessor, TransferPriority priority);
+
    protected:
     /*
      * Register catalogue. A reference is used here which is filled from _registerMapPointer in the constructor to allow
      * backend implementations to provide their own type based on the NumericAddressedRegisterCatalogue.
+     *
+     * The catalogue is shared with the RegisterCatalogue objects returned by getRegisterCatalogue(), hence it must not
+     * be modified after the constructor has completed.
      */
-    std::unique_ptr<NumericAddressedRegisterCatalogue> _registerMapPointer;
+    std::shared_ptr<NumericAddressedRegisterCatalogue> _registerMapPointer;
     NumericAddressedRegisterCatalogue& _registerMap;
 
     /// metadata catalogue
@@ -139,6 +210,29 @@ namespace ChimeraTK {
     /// mutex for protecting unaligned access
     std::mutex _unalignedAccess;
 
+    /// Length of the data transport queues of push-type accessors, if not specified per register in _asyncQueueSizes
+    size_t _defaultAsyncQueueSize;
+
+    /// Register specific lengths of the data transport queues of push-type accessors
+    std::map<RegisterPath, size_t> _asyncQueueSizes;
+
+    /// Scheduler used for all transfers if _isTransferSchedulingEnabled
+    TransferScheduler _transferScheduler;
+
+    std::atomic<bool> _isTransferSchedulingEnabled{false};
+
+    /// Maximum size of a scheduled transfer in bytes, 0 means unlimited
+    std::atomic<size_t> _transferChunkSize{0};
+
+    /** Read or write through the TransferScheduler, if enabled. Otherwise read() resp. write() is called directly.
+     *  Used by the NumericAddressedLowLevelTransferElement and the NumericAddressedBackendMuxedRegisterAccessor. */
+    void scheduledRead(uint64_t bar, uint64_t address, int32_t* data, size_t sizeInBytes, TransferPriority priority);
+    void scheduledWrite(
+        uint64_t bar, uint64_t address, int32_t const* data, size_t sizeInBytes, TransferPriority priority);
+
+    /** Return the size of the chunks a scheduled transfer of the given size on the given bar is split into. */
+    size_t getTransferChunkSize(uint64_t bar, size_t sizeInBytes) const;
+
     template<typename UserType>
     boost::shared_ptr<NDRegisterAccessor<UserType>> getRegisterAccessor_impl(
         const RegisterPath& registerPathName, size_t numberOfWords, size_t wordOffsetInRegister, AccessModeFlags flags);
@@ -161,6 +255,12 @@ namespace ChimeraTK {
      *
      *  Throws std::out_of_range if an invalid interruptNumber is given as parameter.
      *
+     *  The time stamp of the version number is taken from the system clock, unless the map file names a time stamp
+     *  register for the interrupt with "@INTERRUPT_TIMESTAMP:<interrupt> <register>[;scale=<s>][;offset=<s>]". The
+     *  register is read together with the data and holds a counter (one or two 32 bit words, least significant word
+     *  first) which is converted to seconds since the epoch as counter * scale + offset. The default scale is 1e-9
+     *  (nanoseconds), the default offset 0. A TAI counter is converted to UTC with a negative offset.
+     *
      *   @returns The version number that was send with all data in this interrupt.
      */
     VersionNumber dispatchInterrupt(uint32_t interruptNumber);
@@ -178,6 +278,17 @@ namespace ChimeraTK {
      */
     std::map<uint32_t, boost::shared_ptr<NumericAddressedInterruptDispatcher>> const& _primaryInterruptDispatchers{
         _primaryInterruptDispatchersNonConst};
+
+    /** Return the dispatcher for the given interrupt, which is the list of nested interrupt numbers starting with the
+     *  primary interrupt. With create == true missing dispatchers are created, which is only allowed in the
+     *  constructor. Throws ChimeraTK::logic_error if a nested interrupt is not served by an interrupt controller.
+     */
+    boost::shared_ptr<NumericAddressedInterruptDispatcher> getInterruptDispatcher(
+        const std::vector<uint32_t>& interruptId, bool create = false);
+
+    /** Timers of the timer interrupts. Declared after the dispatchers, so the timers are stopped before the
+     *  dispatchers are destroyed. */
+    std::map<uint32_t, std::unique_ptr<TimerInterruptSource>> _timerInterruptSources;
   };
 
 } // namespace ChimeraTK
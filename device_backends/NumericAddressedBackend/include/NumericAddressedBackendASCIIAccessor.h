@@ -207,6 +207,7 @@ namespace ChimeraTK {
             casted->_startAddress + casted->_numberOfBytes, _rawAccessor->_startAddress + _rawAccessor->_numberOfBytes);
         size_t newNumberOfBytes = newStopAddress - newStartAddress;
         casted->changeAddress(newStartAddress, newNumberOfBytes);
+        casted->mergePriority(*_rawAccessor);
         _rawAccessor = casted;
       }
       _rawAccessor->setExceptionBackend(this->_exceptionBackend);
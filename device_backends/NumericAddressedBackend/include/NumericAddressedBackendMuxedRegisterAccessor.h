@@ -203,7 +203,8 @@ namespace ChimeraTK {
     auto nbt = _registerInfo.elementPitchBits / 8 * _registerInfo.nElements;
     nbt = ((nbt - 1) / 4 + 1) * 4; // round up to multiple of 4 bytes
 
-    _ioDevice->read(_registerInfo.bar, _registerInfo.address, _ioBuffer.data(), nbt);
+    _ioDevice->scheduledRead(
+        _registerInfo.bar, _registerInfo.address, _ioBuffer.data(), nbt, TransferPriority::normal);
   }
 
   /********************************************************************************************************************/
@@ -233,7 +234,8 @@ namespace ChimeraTK {
     auto nbt = _registerInfo.elementPitchBits / 8 * _registerInfo.nElements;
     nbt = ((nbt - 1) / 4 + 1) * 4; // round up to multiple of 4 bytes
 
-    _ioDevice->write(_registerInfo.bar, _registerInfo.address, &(_ioBuffer[0]), nbt);
+    _ioDevice->scheduledWrite(
+        _registerInfo.bar, _registerInfo.address, &(_ioBuffer[0]), nbt, TransferPriority::normal);
     return false;
   }
 
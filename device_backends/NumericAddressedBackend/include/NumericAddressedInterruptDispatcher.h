@@ -4,11 +4,14 @@
 
 #include "AsyncAccessorManager.h"
 #include "AsyncNDRegisterAccessor.h"
+#include "InterruptControllerHandler.h"
 #include "NumericAddressedBackendRegisterAccessor.h"
 #include "TransferGroup.h"
 
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 namespace ChimeraTK {
   /** Typeless base class. The implementations will have a list of all asynchronous
@@ -29,6 +32,15 @@ namespace ChimeraTK {
    *  This is done in a single class because the container with the fluctuating number of
    *  subscribed variables is not thread safe. This class has implements a lock so
    *  dispatching an interrupt is safe against concurrent subscription/unsubscription.
+   *
+   *  The _variablesMutex is only held while taking a snapshot of the subscribed variables. Reading the TransferGroup
+   *  and distributing the data is done under the _dispatchMutex, which only serialises trigger() and activate().
+   *  Synchronous accessors of new subscriptions are not added to the TransferGroup directly, but are put on a list of
+   *  pending accessors, which are added to the TransferGroup by the next trigger() or activate().
+   *
+   *  If an interrupt controller is connected to the interrupt, the dispatcher owns its InterruptControllerHandler.
+   *  trigger(), activate(), deactivate() and sendException() are forwarded to the handler, which in turn calls them on
+   *  the dispatchers of the sub-interrupts.
    */
   class NumericAddressedInterruptDispatcher : public AsyncAccessorManager {
    public:
@@ -46,17 +58,71 @@ namespace ChimeraTK {
     // bool prepareActivate(VersionNumber const& v) override;
     VersionNumber activate() override;
 
+    void deactivate() override;
+    void sendException(const std::exception_ptr& e) override;
+
+    /** Set the handler of the interrupt controller connected to this interrupt. Must only be called while the backend
+     *  is constructed.
+     */
+    void setInterruptControllerHandler(std::unique_ptr<InterruptControllerHandler> handler) {
+      _controllerHandler = std::move(handler);
+    }
+
+    /** Return the handler of the connected interrupt controller, or nullptr if there is none. */
+    [[nodiscard]] InterruptControllerHandler* getInterruptControllerHandler() { return _controllerHandler.get(); }
+
+    /** Take the time stamps of the VersionNumbers created by trigger() from the given register instead of the system
+     *  clock. The register is read in the same transfer as the data. It contains a counter with one or two 32 bit
+     *  words (least significant word first), which is converted into seconds since the epoch as
+     *  counter * scale + offset. Must only be called while the backend is constructed.
+     */
+    void setTimestampRegister(const RegisterPath& name, long double scale, long double offset);
+
    protected:
     void asyncVariableMapChanged() override {
       if(_asyncVariables.empty()) {
         // all asyncVariables have been unsubscribed - we can finally remove the TransferGroup
         // This is important since it's elements still keep shared pointers to the backend, creating a shared-ptr loop
-        // replace it by a new TransferGroup just in case another async variable would be created later
-        _transferGroup = std::make_unique<TransferGroup>();
+        // replace it by a new TransferGroup just in case another async variable would be created later.
+        // A trigger() which is currently running still holds its own shared pointer to the old group.
+        _transferGroup = std::make_shared<TransferGroup>();
+        _pendingAccessors.clear();
+        _timestampAccessor.reset();
       }
     }
-    // unique_ptr because we want to delete it manually
-    std::unique_ptr<TransferGroup> _transferGroup{new TransferGroup};
+
+    /** Add the pending accessors to the TransferGroup and return the group. The _dispatchMutex must be locked. The
+     *  _variablesMutex is only locked internally while taking the group and the pending accessors.
+     */
+    std::shared_ptr<TransferGroup> getUpdatedTransferGroup();
+
+    /// Serialises trigger() and activate(). It protects the content of the TransferGroup and the send buffers of the
+    /// variables. Lock order: Always lock the _dispatchMutex before the _variablesMutex.
+    std::mutex _dispatchMutex;
+
+    /// The pointer is protected by _variablesMutex, the content of the TransferGroup by _dispatchMutex.
+    /// shared_ptr because we want to delete it manually while a trigger() might still be using it.
+    std::shared_ptr<TransferGroup> _transferGroup{std::make_shared<TransferGroup>()};
+
+    /// Synchronous accessors of new subscriptions which still have to be added to the _transferGroup.
+    /// Protected by _variablesMutex.
+    std::vector<boost::shared_ptr<TransferElement>> _pendingAccessors;
+
+    /// Handler of the interrupt controller connected to this interrupt. Only set during construction of the backend.
+    std::unique_ptr<InterruptControllerHandler> _controllerHandler;
+
+    /// Convert the content of the timestamp accessor into a time stamp. The _dispatchMutex must be locked.
+    [[nodiscard]] std::chrono::system_clock::time_point getTimestamp(NDRegisterAccessor<int32_t>& accessor) const;
+
+    /// Configuration of the timestamp register. Only set during construction of the backend.
+    std::optional<RegisterPath> _timestampRegister;
+    // long double, since a nanosecond counter since the epoch exceeds the precision of a double
+    long double _timestampScale{1e-9L};
+    long double _timestampOffset{0.L};
+
+    /// Raw accessor to the timestamp register. It is created with the first subscription and added to the
+    /// _transferGroup like the synchronous accessors of the variables. The pointer is protected by _variablesMutex.
+    boost::shared_ptr<NDRegisterAccessor<int32_t>> _timestampAccessor;
   };
 
   /** Implementation of the NumericAddressedAsyncVariable for the concrete UserType.
@@ -102,7 +168,14 @@ namespace ChimeraTK {
       }
     }
 
-    _transferGroup->addAccessor(syncAccessor);
+    // The TransferGroup might currently be read by trigger(). The accessor is added there before the next read.
+    _pendingAccessors.push_back(syncAccessor);
+
+    if(_timestampRegister && !_timestampAccessor) {
+      _timestampAccessor = backend->getRegisterAccessor<int32_t>(*_timestampRegister, 0, 0, {AccessMode::raw});
+      _pendingAccessors.push_back(_timestampAccessor);
+    }
+
     return std::make_unique<NumericAddressedAsyncVariableImpl<UserType>>(syncAccessor);
   }
 
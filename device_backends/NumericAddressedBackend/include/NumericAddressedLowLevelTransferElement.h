@@ -5,6 +5,8 @@
 #include "NumericAddressedBackend.h"
 #include "TransferElement.h"
 
+#include <algorithm>
+
 namespace ChimeraTK {
 
   template<typename UserType, typename DataConverterType, bool isRaw>
@@ -46,13 +48,15 @@ namespace ChimeraTK {
     void doReadTransferSynchronously() override {
       // There is nothing we can do about reinterpet_casting with the C-style interface
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      _dev->read(_bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes);
+      _dev->scheduledRead(
+          _bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes, _priority);
     }
 
     bool doWriteTransfer(ChimeraTK::VersionNumber) override {
       // There is nothing we can do about reinterpet_casting with the C-style interface
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-      _dev->write(_bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes);
+      _dev->scheduledWrite(
+          _bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes, _priority);
       return false;
     }
 
@@ -69,7 +73,8 @@ namespace ChimeraTK {
         _unalignedAccess.lock();
         // There is nothing we can do about reinterpet_casting with the C-style interface
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
-        _dev->read(_bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes);
+        _dev->scheduledRead(
+            _bar, _startAddress, reinterpret_cast<int32_t*>(rawDataBuffer.data()), _numberOfBytes, _priority);
       }
     }
 
@@ -131,6 +136,17 @@ namespace ChimeraTK {
       isShared = true;
     }
 
+    /** Set the priority class used for the transfers, see NumericAddressedBackend::setTransferPriority(). */
+    void setPriority(TransferPriority priority) { _priority = priority; }
+
+    /** Return the priority class used for the transfers. */
+    [[nodiscard]] TransferPriority getPriority() const { return _priority; }
+
+    /** Take over the priority of another element merged into this one, if it is higher. */
+    void mergePriority(const NumericAddressedLowLevelTransferElement& other) {
+      _priority = std::max(_priority, other._priority);
+    }
+
     boost::shared_ptr<TransferElement> makeCopyRegisterDecorator() override { // LCOV_EXCL_LINE
       throw ChimeraTK::logic_error("NumericAddressedLowLevelTransferElement::makeCopyRegisterDecorator() "
                                    "is not implemented"); // LCOV_EXCL_LINE
@@ -184,6 +200,9 @@ namespace ChimeraTK {
     /** flag whether access is unaligned */
     bool _isUnaligned{false};
 
+    /** priority class of the transfers */
+    TransferPriority _priority{TransferPriority::normal};
+
     /** Lock to protect unaligned access (with mutex from backend) */
     std::unique_lock<std::mutex> _unalignedAccess;
 
@@ -4,8 +4,10 @@
 
 #include "BackendRegisterCatalogue.h"
 #include "BackendRegisterInfoBase.h"
+#include "LazyIndex.h"
 
 #include <cstdint>
+#include <map>
 #include <string>
 
 namespace ChimeraTK {
@@ -131,23 +133,95 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  /**
+   * Index over the address ranges occupied by numeric addressed registers, to find the registers covering a given
+   * address or overlapping a given address range. For each bar, the registers are sorted by their start address and
+   * arranged as an implicit binary tree, in which each node stores the maximum end address of its subtree (an
+   * augmented interval tree). A query takes O(log(n) + k) time for k results, instead of scanning all n registers.
+   *
+   * A register occupies the bytes [address, address + nElements * elementPitchBits / 8). Registers without data
+   * (e.g. interrupt registers of type VOID) are considered to occupy the byte at their address.
+   *
+   * The index only stores pointers to the register information, so it must not outlive the catalogue and must be
+   * rebuilt when the catalogue is modified.
+   */
+  class RegisterAddressIndex {
+   public:
+    /** Build the index from the given registers. */
+    explicit RegisterAddressIndex(const std::vector<const NumericAddressedRegisterInfo*>& registers);
+
+    /**
+     * Return all registers in the given bar overlapping the address range [address, address + nBytes), sorted by
+     * address and in the order of the catalogue for equal addresses. An empty range does not overlap any register.
+     */
+    [[nodiscard]] std::vector<const NumericAddressedRegisterInfo*> getRegistersInRange(
+        uint64_t bar, uint64_t address, uint64_t nBytes) const;
+
+   private:
+    struct Interval {
+      uint64_t begin;
+      uint64_t end;
+      const NumericAddressedRegisterInfo* info;
+    };
+
+    struct Bar {
+      std::vector<Interval> intervals; // sorted by begin
+      std::vector<uint64_t> maxEnd;    // maximum end in the subtree whose root is the interval with the same index
+    };
+
+    /** Compute maxEnd for the subtree spanning [first, last) and return it. */
+    static uint64_t build(Bar& bar, size_t first, size_t last);
+
+    /** Append all intervals in the subtree spanning [first, last) which overlap [begin, end) to the result. */
+    static void collect(const Bar& bar, size_t first, size_t last, uint64_t begin, uint64_t end,
+        std::vector<const NumericAddressedRegisterInfo*>& result);
+
+    std::map<uint64_t, Bar> _bars;
+  };
+
+  /********************************************************************************************************************/
+
   class NumericAddressedRegisterCatalogue : public BackendRegisterCatalogue<NumericAddressedRegisterInfo> {
    public:
     [[nodiscard]] NumericAddressedRegisterInfo getBackendRegister(const RegisterPath& registerPathName) const override;
 
     [[nodiscard]] bool hasRegister(const RegisterPath& registerPathName) const override;
 
+    [[nodiscard]] const BackendRegisterInfoBase* findRegister(const RegisterPath& registerPathName) const override;
+
     [[nodiscard]] const std::set<std::vector<uint32_t>>& getListOfInterrupts() const;
 
+    /**
+     * Return all registers covering the given address in the given bar, e.g. to find out which registers are affected
+     * by a write. See RegisterAddressIndex for details. The index is built on first use.
+     *
+     * The returned pointers are valid until the catalogue is modified or destroyed. Numeric addresses (see
+     * numeric_address::BAR()) are not part of the catalogue and hence never returned.
+     */
+    [[nodiscard]] std::vector<const NumericAddressedRegisterInfo*> getRegistersAtAddress(
+        uint64_t bar, uint64_t address) const;
+
+    /**
+     * Return all registers overlapping the address range [address, address + nBytes) in the given bar. See
+     * getRegistersAtAddress() for details.
+     */
+    [[nodiscard]] std::vector<const NumericAddressedRegisterInfo*> getRegistersInAddressRange(
+        uint64_t bar, uint64_t address, uint64_t nBytes) const;
+
     void addRegister(const NumericAddressedRegisterInfo& registerInfo);
     [[nodiscard]] std::unique_ptr<BackendRegisterCatalogueBase> clone() const override;
 
    protected:
+    void invalidateIndices() override;
+
     /**
      *  set of interrupt ID. Each interrupt ID is a vector of (nested) interrupt numbers.
      *  (Use a vector because it's the easiest container, and set because it ensures that each entry is there only once).
      */
     std::set<std::vector<uint32_t>> _listOfInterrupts;
+
+   private:
+    LazyIndex<RegisterAddressIndex> _addressIndex;
   };
 
   /********************************************************************************************************************/
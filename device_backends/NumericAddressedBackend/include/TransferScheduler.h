@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace ChimeraTK {
+
+  /** Priority class of the transfers of an accessor, see NumericAddressedBackend::setTransferPriority(). */
+  enum class TransferPriority : uint8_t { low = 0, normal = 1, high = 2 };
+
+  /** The TransferScheduler serialises the transfers of a NumericAddressedBackend and grants access to the transport by
+   *  priority. Whenever the transport becomes free, the waiting transfer with the highest priority class proceeds. The
+   *  order within a priority class is not defined.
+   *
+   *  Large transfers are split into chunks by the NumericAddressedBackend, and each chunk acquires the transport
+   *  separately. Hence a small high-priority transfer only waits for the current chunk instead of the whole large
+   *  transfer. Note that transfers of a lower priority class are starved as long as the transport is saturated by
+   *  transfers of a higher priority class.
+   */
+  class TransferScheduler {
+   public:
+    /** Wait until the transport is free and no transfer with a higher priority is waiting, then occupy it. */
+    void acquire(TransferPriority priority);
+
+    /** Free the transport again. */
+    void release();
+
+    /** Return the number of transfers currently waiting for the transport. */
+    [[nodiscard]] size_t getNumberOfWaitingTransfers();
+
+    /** RAII helper which occupies the transport for its lifetime. */
+    class Slot {
+     public:
+      Slot(TransferScheduler& scheduler, TransferPriority priority) : _scheduler(scheduler) {
+        _scheduler.acquire(priority);
+      }
+      ~Slot() { _scheduler.release(); }
+      Slot(const Slot&) = delete;
+      Slot& operator=(const Slot&) = delete;
+
+     protected:
+      TransferScheduler& _scheduler;
+    };
+
+   protected:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _isBusy{false};
+
+    /// Number of waiting transfers per priority class
+    std::array<size_t, 3> _nWaiting{};
+  };
+
+} // namespace ChimeraTK
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "InterruptControllerHandler.h"
+
+#include "Exception.h"
+#include "NumericAddressedBackend.h"
+#include "NumericAddressedInterruptDispatcher.h"
+#include "NumericAddressedRegisterCatalogue.h"
+
+#include <sstream>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  InterruptControllerHandler::InterruptControllerHandler(NumericAddressedBackend& backend,
+      const NumericAddressedRegisterCatalogue& catalogue, std::vector<uint32_t> controllerId,
+      const std::string& description)
+  : _backend(backend), _controllerId(std::move(controllerId)) {
+    // split the description into the style and the key=value pairs
+    std::stringstream stream(description);
+    std::string style;
+    std::getline(stream, style, ';');
+    std::map<std::string, std::string> options;
+    std::string option;
+    while(std::getline(stream, option, ';')) {
+      auto pos = option.find('=');
+      if(pos == std::string::npos || pos == 0) {
+        throw ChimeraTK::logic_error(getName() + ": Invalid option '" + option + "', expected <key>=<value>.");
+      }
+      options[option.substr(0, pos)] = option.substr(pos + 1);
+    }
+
+    auto takeOption = [&](const std::string& key) {
+      auto it = options.find(key);
+      if(it == options.end()) {
+        return std::string();
+      }
+      auto value = it->second;
+      options.erase(it);
+      return value;
+    };
+
+    if(style == "INTC") {
+      auto module = takeOption("module");
+      if(module.empty()) {
+        throw ChimeraTK::logic_error(getName() + ": Style INTC requires the option 'module'.");
+      }
+      _status = findRegister(catalogue, module + ".ISR");
+      // the other registers are optional
+      auto findOptionalRegister = [&](const std::string& name) {
+        RegisterPath path(module + "." + name);
+        path.setAltSeparator(".");
+        return catalogue.hasRegister(path) ? findRegister(catalogue, module + "." + name) : Register();
+      };
+      _acknowledge = findOptionalRegister("IAR");
+      _mask = findOptionalRegister("IER");
+      _enable = findOptionalRegister("MER");
+      _enableValue = 3; // master enable and hardware interrupt enable
+    }
+    else if(style == "FLAT") {
+      auto status = takeOption("status");
+      if(status.empty()) {
+        throw ChimeraTK::logic_error(getName() + ": Style FLAT requires the option 'status'.");
+      }
+      _status = findRegister(catalogue, status);
+      for(auto [reg, key] : {std::make_pair(&_acknowledge, "acknowledge"), std::make_pair(&_mask, "mask"),
+              std::make_pair(&_enable, "enable")}) {
+        auto name = takeOption(key);
+        if(!name.empty()) {
+          *reg = findRegister(catalogue, name);
+        }
+      }
+    }
+    else {
+      throw ChimeraTK::logic_error(getName() + ": Unknown style '" + style + "'. Supported styles are INTC and FLAT.");
+    }
+
+    if(!options.empty()) {
+      throw ChimeraTK::logic_error(
+          getName() + ": Unknown option '" + options.begin()->first + "' for style " + style + ".");
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  InterruptControllerHandler::Register InterruptControllerHandler::findRegister(
+      const NumericAddressedRegisterCatalogue& catalogue, const std::string& name) const {
+    RegisterPath path(name);
+    path.setAltSeparator(".");
+    if(!catalogue.hasRegister(path)) {
+      throw ChimeraTK::logic_error(getName() + ": Unknown register '" + name + "'.");
+    }
+    auto info = catalogue.getBackendRegister(path);
+    return {info.bar, info.address, true};
+  }
+
+  /********************************************************************************************************************/
+
+  std::string InterruptControllerHandler::getName() const {
+    std::string name = "Interrupt controller ";
+    for(size_t i = 0; i < _controllerId.size(); ++i) {
+      name += (i > 0 ? ":" : "") + std::to_string(_controllerId[i]);
+    }
+    return name;
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<NumericAddressedInterruptDispatcher> InterruptControllerHandler::addSubInterrupt(
+      uint32_t subInterrupt) {
+    if(subInterrupt >= 32) {
+      throw ChimeraTK::logic_error(getName() + ": Sub-interrupt " + std::to_string(subInterrupt) +
+          " out of range. Only 32 sub-interrupts are supported.");
+    }
+    auto [it, isNew] = _dispatchers.try_emplace(subInterrupt);
+    if(isNew) {
+      it->second = boost::make_shared<NumericAddressedInterruptDispatcher>();
+    }
+    return it->second;
+  }
+
+  /********************************************************************************************************************/
+
+  boost::shared_ptr<NumericAddressedInterruptDispatcher> InterruptControllerHandler::getSubInterrupt(
+      uint32_t subInterrupt) const {
+    auto it = _dispatchers.find(subInterrupt);
+    if(it == _dispatchers.end()) {
+      throw ChimeraTK::logic_error(getName() + ": Unknown sub-interrupt " + std::to_string(subInterrupt) + ".");
+    }
+    return it->second;
+  }
+
+  /********************************************************************************************************************/
+
+  void InterruptControllerHandler::writeRegister(const Register& reg, uint32_t value) {
+    auto word = static_cast<int32_t>(value);
+    _backend.write(reg.bar, reg.address, &word, sizeof(word));
+  }
+
+  /********************************************************************************************************************/
+
+  void InterruptControllerHandler::handle() {
+    uint32_t asserted;
+    try {
+      // one read for all sub-interrupts, and one write to acknowledge all of them
+      int32_t word;
+      _backend.read(_status.bar, _status.address, &word, sizeof(word));
+      asserted = static_cast<uint32_t>(word);
+      if(asserted == 0) {
+        return;
+      }
+      if(_acknowledge.isUsed) {
+        writeRegister(_acknowledge, asserted);
+      }
+    }
+    catch(ChimeraTK::runtime_error& e) {
+      _backend.setException(e.what());
+      return;
+    }
+
+    for(auto& [subInterrupt, dispatcher] : _dispatchers) {
+      if(asserted & (1U << subInterrupt)) {
+        dispatcher->trigger();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void InterruptControllerHandler::activate() {
+    try {
+      if(_mask.isUsed) {
+        uint32_t mask = 0;
+        for(auto& dispatcher : _dispatchers) {
+          mask |= 1U << dispatcher.first;
+        }
+        writeRegister(_mask, mask);
+      }
+      if(_enable.isUsed) {
+        writeRegister(_enable, _enableValue);
+      }
+    }
+    catch(ChimeraTK::runtime_error& e) {
+      _backend.setException(e.what());
+      return;
+    }
+
+    for(auto& dispatcher : _dispatchers) {
+      dispatcher.second->activate();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void InterruptControllerHandler::deactivate() {
+    for(auto& dispatcher : _dispatchers) {
+      dispatcher.second->deactivate();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void InterruptControllerHandler::sendException(const std::exception_ptr& e) {
+    for(auto& dispatcher : _dispatchers) {
+      dispatcher.second->sendException(e);
+    }
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
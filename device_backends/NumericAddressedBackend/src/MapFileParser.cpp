@@ -3,40 +3,144 @@
 
 #include "MapFileParser.h"
 
+#include "CatalogueCache.h"
 #include "NumericAddressedBackendMuxedRegisterAccessor.h" // for the MULTIPLEXED_SEQUENCE_PREFIX constant
+#include "parserUtilities.h"
 
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
+#include <array>
+#include <charconv>
 #include <iostream>
-#include <sstream>
+#include <limits>
 #include <string>
 
 namespace ChimeraTK {
 
+  namespace {
+
+    /******************************************************************************************************************/
+
+    bool isSpace(char c) {
+      return std::isspace(static_cast<unsigned char>(c));
+    }
+
+    /******************************************************************************************************************/
+
+    /** Remove whitespace from the beginning of the string */
+    std::string_view trimLeft(std::string_view str) {
+      auto pos = std::find_if(str.begin(), str.end(), [](char c) { return !isSpace(c); });
+      str.remove_prefix(static_cast<size_t>(pos - str.begin()));
+      return str;
+    }
+
+    /******************************************************************************************************************/
+
+    /** Split the line at whitespace into at most tokens.size() tokens. Returns the number of tokens found. */
+    template<size_t N>
+    size_t tokenise(std::string_view line, std::array<std::string_view, N>& tokens) {
+      size_t nTokens = 0;
+      line = trimLeft(line);
+      while(!line.empty() && nTokens < N) {
+        auto end = std::find_if(line.begin(), line.end(), isSpace);
+        auto length = static_cast<size_t>(end - line.begin());
+        tokens[nTokens++] = line.substr(0, length);
+        line = trimLeft(line.substr(length));
+      }
+      return nTokens;
+    }
+
+    /******************************************************************************************************************/
+
+    /**
+     * Parse an integer from the beginning of the string. The base is determined from the prefix like with
+     * std::setbase(0) (0x: hexadecimal, 0: octal, otherwise decimal). Returns the number of characters used, which
+     * is 0 if no valid number was found or it does not fit into the type.
+     */
+    template<typename T>
+    size_t parseInteger(std::string_view str, T& value) {
+      size_t pos = 0;
+      bool negative = false;
+      if(!str.empty() && (str[0] == '-' || str[0] == '+')) {
+        negative = (str[0] == '-');
+        pos = 1;
+      }
+      int base = 10;
+      if(str.size() > pos + 2 && str[pos] == '0' && (str[pos + 1] == 'x' || str[pos + 1] == 'X')) {
+        base = 16;
+        pos += 2;
+      }
+      else if(str.size() > pos + 1 && str[pos] == '0') {
+        base = 8;
+      }
+
+      uint64_t magnitude = 0;
+      auto result = std::from_chars(str.data() + pos, str.data() + str.size(), magnitude, base);
+      if(result.ec != std::errc()) return 0;
+
+      auto maximum = static_cast<uint64_t>(std::numeric_limits<T>::max());
+      if(!negative) {
+        if(magnitude > maximum) return 0;
+        value = static_cast<T>(magnitude);
+      }
+      else {
+        if constexpr(std::is_unsigned_v<T>) {
+          return 0;
+        }
+        else {
+          if(magnitude > maximum + 1) return 0;
+          value = static_cast<T>(-static_cast<int64_t>(magnitude));
+        }
+      }
+      return static_cast<size_t>(result.ptr - str.data());
+    }
+
+    /******************************************************************************************************************/
+
+    /** Parse a token which must consist of an integer only */
+    template<typename T>
+    bool parseIntegerToken(std::string_view token, T& value) {
+      return !token.empty() && parseInteger(token, value) == token.size();
+    }
+
+    /******************************************************************************************************************/
+
+  } // namespace
+
   /********************************************************************************************************************/
 
   std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> MapFileParser::parse(const std::string& file_name_) {
     file_name = file_name_;
-    std::ifstream file;
-
-    file.open(file_name.c_str());
-    if(!file) {
-      throw ChimeraTK::logic_error("Cannot open file \"" + file_name + "\"");
+    parserUtilities::MappedFile file(file_name);
+    auto content = file.getContent();
+
+    // use the catalogue cache if enabled and up to date
+    std::string cacheFileName;
+    uint64_t contentHash = 0;
+    if(CatalogueCache::isEnabled()) {
+      contentHash = CatalogueCache::hash(content);
+      cacheFileName = CatalogueCache::getCacheFileName(file_name, contentHash, "mapcache");
+      auto cached = readCache(cacheFileName, contentHash);
+      if(cached) {
+        return std::move(*cached);
+      }
     }
 
-    std::string line;
-    while(std::getline(file, line)) {
+    // Each line contains at most one register, so the number of lines is an upper limit for the number of registers.
+    parsedLines.reserve(static_cast<size_t>(std::count(content.begin(), content.end(), '\n')) + 1);
+
+    while(!content.empty()) {
+      auto endOfLine = content.find('\n');
+      auto line = content.substr(0, endOfLine);
+      content.remove_prefix(endOfLine == std::string_view::npos ? content.size() : endOfLine + 1);
       line_nr++;
 
       // Remove whitespace from beginning of line
-      line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](int c) { return !isspace(c); }));
+      line = trimLeft(line);
 
       // Remove comments from the end of the line
-      auto pos = line.find('#');
-      if(pos != std::string::npos) {
-        line.erase(pos, std::string::npos);
-      }
+      line = line.substr(0, line.find('#'));
 
       // Ignore empty lines (including all-comment lines)
       if(line.empty()) {
@@ -53,13 +157,123 @@ namespace ChimeraTK {
       parsedLines.push_back(parseLine(line));
     }
 
+    auto result = makeCatalogue();
+    if(!cacheFileName.empty()) {
+      writeCache(cacheFileName, contentHash, result);
+    }
+    return result;
+  }
+
+  /********************************************************************************************************************/
+
+  std::optional<std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>> MapFileParser::readCache(
+      const std::string& cacheFileName, uint64_t contentHash) {
+    try {
+      CatalogueCache::Reader reader(cacheFileName, cacheKind, cacheVersion, contentHash);
+      std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> result;
+
+      auto nRegisters = reader.read<uint64_t>();
+      result.first.reserve(nRegisters);
+      for(uint64_t i = 0; i < nRegisters; ++i) {
+        RegisterPath pathName(std::string(reader.readString()));
+        auto bar = reader.read<uint64_t>();
+        auto address = reader.read<uint64_t>();
+        auto nElements = reader.read<uint32_t>();
+        auto elementPitchBits = reader.read<uint32_t>();
+        auto registerAccess = reader.read<NumericAddressedRegisterInfo::Access>();
+        if(registerAccess > NumericAddressedRegisterInfo::Access::INTERRUPT) {
+          throw ChimeraTK::runtime_error("Invalid access mode in catalogue cache file.");
+        }
+        std::vector<uint32_t> interruptId(reader.read<uint64_t>());
+        for(auto& id : interruptId) {
+          id = reader.read<uint32_t>();
+        }
+        std::vector<NumericAddressedRegisterInfo::ChannelInfo> channels(reader.read<uint64_t>());
+        for(auto& channel : channels) {
+          channel.bitOffset = reader.read<uint32_t>();
+          channel.dataType = reader.read<NumericAddressedRegisterInfo::Type>();
+          if(channel.dataType > NumericAddressedRegisterInfo::Type::ASCII) {
+            throw ChimeraTK::runtime_error("Invalid data type in catalogue cache file.");
+          }
+          channel.width = reader.read<uint32_t>();
+          channel.nFractionalBits = reader.read<int32_t>();
+          channel.signedFlag = reader.read<uint8_t>();
+        }
+        if(channels.empty()) {
+          throw ChimeraTK::runtime_error("Register without channels in catalogue cache file.");
+        }
+        result.first.addRegister(NumericAddressedRegisterInfo(pathName, bar, address, nElements, elementPitchBits,
+            std::move(channels), registerAccess, std::move(interruptId)));
+      }
+
+      auto nMetadata = reader.read<uint64_t>();
+      for(uint64_t i = 0; i < nMetadata; ++i) {
+        std::string key(reader.readString());
+        result.second.addMetadata(key, std::string(reader.readString()));
+      }
+
+      if(!reader.atEnd()) {
+        throw ChimeraTK::runtime_error("Unexpected data at the end of the catalogue cache file.");
+      }
+      return result;
+    }
+    catch(ChimeraTK::runtime_error&) {
+      // cache miss or unusable cache file: the map file will be parsed
+    }
+    catch(ChimeraTK::logic_error&) {
+      // inconsistent register information (e.g. a corrupt cache file): the map file will be parsed
+    }
+    return std::nullopt;
+  }
+
+  /********************************************************************************************************************/
+
+  void MapFileParser::writeCache(const std::string& cacheFileName, uint64_t contentHash,
+      const std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>& catalogues) {
+    CatalogueCache::Writer writer(cacheKind, cacheVersion, contentHash);
+
+    writer.write(uint64_t(catalogues.first.getNumberOfRegisters()));
+    for(const auto& info : catalogues.first) {
+      writer.writeString(std::string(info.pathName));
+      writer.write(info.bar);
+      writer.write(info.address);
+      writer.write(info.nElements);
+      writer.write(info.elementPitchBits);
+      writer.write(info.registerAccess);
+      writer.write(uint64_t(info.interruptId.size()));
+      for(auto id : info.interruptId) {
+        writer.write(id);
+      }
+      writer.write(uint64_t(info.channels.size()));
+      for(const auto& channel : info.channels) {
+        writer.write(channel.bitOffset);
+        writer.write(channel.dataType);
+        writer.write(channel.width);
+        writer.write(channel.nFractionalBits);
+        writer.write(uint8_t(channel.signedFlag));
+      }
+    }
+
+    writer.write(uint64_t(catalogues.second.getNumberOfMetadata()));
+    for(auto it = catalogues.second.cbegin(); it != catalogues.second.cend(); ++it) {
+      writer.writeString(it->first);
+      writer.writeString(it->second);
+    }
+
+    writer.store(cacheFileName);
+  }
+
+  /********************************************************************************************************************/
+
+  std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> MapFileParser::makeCatalogue() {
     // create map of register names to parsed lines
     // This cannot be done in the above parsing loop, as the vector might get resized which invalidates the references
     for(const auto& pl : parsedLines) {
-      parsedLinesMap.emplace(pl.pathName, pl);
+      parsedLinesMap.emplace(std::string(pl.pathName), pl);
     }
 
     // add registers to the catalogue
+    pmap.reserve(parsedLines.size());
     for(const auto& pl : parsedLines) {
       if(isScalarOr1D(pl.pathName)) {
         auto registerInfo = NumericAddressedRegisterInfo(pl.pathName, pl.nElements, pl.address, pl.nBytes, pl.bar,
@@ -89,54 +303,48 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   std::pair<NumericAddressedRegisterInfo::Type, int> MapFileParser::getTypeAndNFractionalBits(
-      const std::string& bitInterpretation, unsigned int width) {
+      std::string_view bitInterpretation, unsigned int width) {
     if(width == 0) return {NumericAddressedRegisterInfo::Type::VOID, 0};
     if(bitInterpretation == "IEEE754") return {NumericAddressedRegisterInfo::Type::IEEE754, 0};
     if(bitInterpretation == "ASCII") return {NumericAddressedRegisterInfo::Type::ASCII, 0};
 
-    // If it is a digit the implicit interpretation is FixedPoint
-    try {
-      int nBits = std::stoi(bitInterpretation, nullptr,
-          0); // base 0 = auto, hex or dec or oct
-      return {NumericAddressedRegisterInfo::Type::FIXED_POINT, nBits};
-    }
-    catch(std::exception& e) {
-      throw ChimeraTK::logic_error(std::string("Map file error in bitInterpretation: wrong argument '") +
-          bitInterpretation + "', caught exception: " + e.what());
+    // If it is a digit the implicit interpretation is FixedPoint. Like std::stoi(), trailing characters are ignored.
+    int nBits = 0;
+    if(parseInteger(bitInterpretation, nBits) == 0) {
+      throw ChimeraTK::logic_error(
+          "Map file error in bitInterpretation: wrong argument '" + std::string(bitInterpretation) + "'");
     }
+    return {NumericAddressedRegisterInfo::Type::FIXED_POINT, nBits};
   }
 
   /********************************************************************************************************************/
-  // FIXME: This funtion does a lot of string copying. This can be optimised, for instance by using a string_view.
-  std::vector<uint32_t> MapFileParser::getInterruptId(std::string accessTypeStr) {
-    std::string strToFind("INTERRUPT");
+
+  std::vector<uint32_t> MapFileParser::getInterruptId(std::string_view accessTypeStr) {
+    std::string_view strToFind("INTERRUPT");
     auto pos = accessTypeStr.find(strToFind);
-    if(pos == std::string::npos) return {};
+    if(pos == std::string_view::npos) return {};
     std::vector<uint32_t> retVal;
 
-    accessTypeStr.erase(pos, strToFind.length());
+    // Everything before the keyword is ignored, everything after it is the colon-separated list of interrupt numbers
+    accessTypeStr.remove_prefix(pos + strToFind.size());
 
     size_t delimiterPos;
     do {
       delimiterPos = accessTypeStr.find(':');
-      std::string interruptStr = accessTypeStr.substr(0, delimiterPos);
+      auto interruptStr = accessTypeStr.substr(0, delimiterPos);
       uint32_t interruptNumber = 0;
-      try {
-        interruptNumber =
-            static_cast<uint32_t>(std::stoul(interruptStr, nullptr, 0)); // base 0 = auto, hex or dec or oct
-      }
-      catch(std::exception& e) {
+      if(parseInteger(interruptStr, interruptNumber) == 0) {
         throw ChimeraTK::logic_error(
-            std::string("Map file error in accessString: wrong argument in interrupt controller number. Argument: '") +
-            interruptStr + "', caught exception: " + e.what());
+            "Map file error in accessString: wrong argument in interrupt controller number. Argument: '" +
+            std::string(interruptStr) + "'");
       }
       retVal.push_back(interruptNumber);
 
       // cut off the already processed part and process the rest
-      if(delimiterPos != std::string::npos) {
-        accessTypeStr = accessTypeStr.substr(delimiterPos + 1);
+      if(delimiterPos != std::string_view::npos) {
+        accessTypeStr.remove_prefix(delimiterPos + 1);
       }
-    } while(delimiterPos != std::string::npos);
+    } while(delimiterPos != std::string_view::npos);
 
     return retVal;
   }
@@ -165,59 +373,62 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
-  void MapFileParser::parseMetaData(std::string line) {
-    std::string metadata_name, metadata_value;
-
-    // Remove the '@' character...
-    line.erase(line.begin(), line.begin() + 1);
+  void MapFileParser::parseMetaData(std::string_view line) {
+    // Remove the '@' character and all the whitespace after it
+    line = trimLeft(line.substr(1));
 
-    // ... and remove all the whitespace after it
-    line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](int c) { return !isspace(c); }));
-
-    std::istringstream is;
-    is.str(line);
-    is >> metadata_name;
-    if(!is) {
+    // the name is the first word, the value is the rest with all whitespace removed
+    auto endOfName = std::find_if(line.begin(), line.end(), isSpace);
+    auto nameLength = static_cast<size_t>(endOfName - line.begin());
+    if(nameLength == 0) {
       throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " + std::to_string(line_nr));
     }
-    // remove name from the string
-    line.erase(line.begin(), line.begin() + static_cast<std::string::difference_type>(metadata_name.length()));
-
-    line.erase(std::remove_if(line.begin(), line.end(), [](unsigned char x) { return std::isspace(x); }),
-        line.end()); // remove whitespaces from rest of the string (before and after the value)
-    metadata_value = line;
+    std::string metadata_name(line.substr(0, nameLength));
+    std::string metadata_value;
+    std::copy_if(endOfName, line.end(), std::back_inserter(metadata_value), [](char c) { return !isSpace(c); });
     metadataCatalogue.addMetadata(metadata_name, metadata_value);
-    is.clear();
   }
 
   /********************************************************************************************************************/
 
-  MapFileParser::ParsedLine MapFileParser::parseLine(const std::string& line) {
+  MapFileParser::ParsedLine MapFileParser::parseLine(std::string_view line) {
     ParsedLine pl;
 
-    std::istringstream is;
-    is.str(line);
+    // name, 3 mandatory and 5 optional fields. Further tokens are ignored.
+    std::array<std::string_view, 9> tokens;
+    auto nTokens = tokenise(line, tokens);
 
     // extract register name
-    std::string name;
-    is >> name;
-    pl.pathName = name;
+    pl.pathName = std::string(tokens[0]);
     pl.pathName.setAltSeparator(".");
 
     // extract mandatory address information
-    is >> std::setbase(0) >> pl.nElements >> std::setbase(0) >> pl.address >> std::setbase(0) >> pl.nBytes;
-    if(!is) {
+    if(nTokens < 4 || !parseIntegerToken(tokens[1], pl.nElements) || !parseIntegerToken(tokens[2], pl.address) ||
+        !parseIntegerToken(tokens[3], pl.nBytes)) {
       throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " + std::to_string(line_nr));
     }
 
-    // Note: default values for optional information are set in ParsedLine declaration
+    // Note: default values for optional information are set in ParsedLine declaration. Like with the stream based
+    // implementation, optional fields are only evaluated up to the first missing or malformed one, and a malformed
+    // numeric field is set to 0.
+    size_t iToken = 4;
+    bool good = true;
+    auto parseOptional = [&](auto& value) {
+      if(iToken >= nTokens) {
+        good = false;
+      }
+      else if(!parseIntegerToken(tokens[iToken++], value)) {
+        value = 0;
+        good = false;
+      }
+    };
 
     // extract bar
-    is >> std::setbase(0) >> pl.bar;
+    parseOptional(pl.bar);
 
     // extract width
-    if(!is.fail()) {
-      is >> std::setbase(0) >> pl.width;
+    if(good) {
+      parseOptional(pl.width);
       if(pl.width > 32) {
         throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
             std::to_string(line_nr) + ": register width too big");
@@ -225,53 +436,52 @@ namespace ChimeraTK {
     }
 
     // extract bit interpretation field (nb. of fractional bits, IEEE754, VOID, ...)
-    if(!is.fail()) {
-      std::string bitInterpretation;
-      is >> bitInterpretation;
-      if(!is.fail()) {
-        // width is needed to determine whether type is VOID
-        std::tie(pl.type, pl.nFractionalBits) = getTypeAndNFractionalBits(bitInterpretation, pl.width);
-        if(pl.nFractionalBits > 1023 || pl.nFractionalBits < -1024) {
-          throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
-              std::to_string(line_nr) + ": too many fractional bits");
-        }
+    if(good && iToken < nTokens) {
+      // width is needed to determine whether type is VOID
+      std::tie(pl.type, pl.nFractionalBits) = getTypeAndNFractionalBits(tokens[iToken++], pl.width);
+      if(pl.nFractionalBits > 1023 || pl.nFractionalBits < -1024) {
+        throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
+            std::to_string(line_nr) + ": too many fractional bits");
       }
     }
+    else {
+      good = false;
+    }
 
-    // extract signed flag
-    if(!is.fail()) {
-      is >> std::setbase(0) >> pl.signedFlag;
+    // extract signed flag (only 0 and 1 are valid, other numbers are taken as true)
+    if(good) {
+      uint64_t signedFlag = 1;
+      parseOptional(signedFlag);
+      if(signedFlag > 1) good = false;
+      pl.signedFlag = (signedFlag != 0);
     }
 
     // extract access mode string (RO, RW, WO, INTERRUPT)
-    if(!is.fail()) {
-      std::string accessString;
-      is >> accessString;
-      if(!is.fail()) {
-        // first transform to uppercase
-        std::transform(accessString.begin(), accessString.end(), accessString.begin(),
-            [](unsigned char c) { return std::toupper(c); });
-
-        // first check if access mode is INTERRUPT
-        auto interruptId = getInterruptId(accessString);
-
-        if(!interruptId.empty()) {
-          pl.registerAccess = NumericAddressedRegisterInfo::Access::INTERRUPT;
-          pl.interruptID = interruptId;
-        }
-        else if(accessString == "RO") {
-          pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_ONLY;
-        }
-        else if(accessString == "RW") {
-          pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_WRITE;
-        }
-        else if(accessString == "WO") {
-          pl.registerAccess = NumericAddressedRegisterInfo::Access::WRITE_ONLY;
-        }
-        else {
-          throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
-              std::to_string(line_nr) + ": invalid data access");
-        }
+    if(good && iToken < nTokens) {
+      // first transform to uppercase
+      std::string accessString(tokens[iToken]);
+      std::transform(accessString.begin(), accessString.end(), accessString.begin(),
+          [](unsigned char c) { return std::toupper(c); });
+
+      // first check if access mode is INTERRUPT
+      auto interruptId = getInterruptId(accessString);
+
+      if(!interruptId.empty()) {
+        pl.registerAccess = NumericAddressedRegisterInfo::Access::INTERRUPT;
+        pl.interruptID = interruptId;
+      }
+      else if(accessString == "RO") {
+        pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_ONLY;
+      }
+      else if(accessString == "RW") {
+        pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_WRITE;
+      }
+      else if(accessString == "WO") {
+        pl.registerAccess = NumericAddressedRegisterInfo::Access::WRITE_ONLY;
+      }
+      else {
+        throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
+            std::to_string(line_nr) + ": invalid data access");
       }
     }
 
@@ -335,9 +545,13 @@ namespace ChimeraTK {
     // search for sequence entries matching the given register, create ChannelInfos from them
 
     // Find all channels associated with the area
+    // The map is sorted, so all names starting with the name of the 2D register follow each other.
     std::list<ParsedLine> channelLines;
-    for(auto& [key, value] : parsedLinesMap) {
-      if(key.startsWith(pl.pathName) and pl.pathName.length() < key.length()) {
+    std::string prefix(pl.pathName);
+    for(auto it = parsedLinesMap.lower_bound(prefix); it != parsedLinesMap.end(); ++it) {
+      const auto& [key, value] = *it;
+      if(key.compare(0, prefix.size(), prefix) != 0) break;
+      if(prefix.size() < key.size()) {
         // First sanity check, address must not be smaller than start address
         if(value.address < pl.address) {
           throw ChimeraTK::logic_error(
@@ -407,7 +621,7 @@ namespace ChimeraTK {
     // search for sequence entries matching the given register, create ChannelInfos from them
     std::list<ParsedLine> channelLines;
     while(true) {
-      auto it = parsedLinesMap.find(makeSequenceName(pl.pathName, channelLines.size()));
+      auto it = parsedLinesMap.find(std::string(makeSequenceName(pl.pathName, channelLines.size())));
       if(it == parsedLinesMap.end()) break;
       if(it->second.address < pl.address) {
         throw ChimeraTK::logic_error(
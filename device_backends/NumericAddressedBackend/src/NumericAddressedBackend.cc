@@ -10,28 +10,212 @@
 #include "NumericAddressedBackendMuxedRegisterAccessor.h"
 #include "NumericAddressedBackendRegisterAccessor.h"
 #include "NumericAddressedInterruptDispatcher.h"
+#include "NumericAddressedLowLevelTransferElement.h"
+#include "TransferElementAbstractor.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
 
 namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  namespace {
+    /** Parse the interrupt given in a metadata key like "INTERRUPT_CONTROLLER:3:1", starting at the given position. */
+    std::vector<uint32_t> parseInterruptId(const std::string& key, size_t start) {
+      std::vector<uint32_t> interruptId;
+      try {
+        std::stringstream stream(key.substr(start));
+        std::string component;
+        while(std::getline(stream, component, ':')) {
+          size_t end;
+          interruptId.push_back(static_cast<uint32_t>(std::stoul(component, &end)));
+          if(end != component.size() || component[0] == '-') {
+            throw std::invalid_argument("'" + component + "' is not an interrupt number");
+          }
+        }
+      }
+      catch(std::exception& e) {
+        throw ChimeraTK::logic_error(
+            "Map file error in metadata '" + key + "': Invalid interrupt, caught exception: " + e.what());
+      }
+      if(interruptId.empty()) {
+        throw ChimeraTK::logic_error("Map file error in metadata '" + key + "': Missing interrupt.");
+      }
+      return interruptId;
+    }
+  } // namespace
+
+  /********************************************************************************************************************/
+
   NumericAddressedBackend::NumericAddressedBackend(
       const std::string& mapFileName, std::unique_ptr<NumericAddressedRegisterCatalogue> registerMapPointer)
-  : _registerMapPointer(std::move(registerMapPointer)), _registerMap(*_registerMapPointer) {
+  : _registerMapPointer(std::move(registerMapPointer)), _registerMap(*_registerMapPointer),
+    _defaultAsyncQueueSize(AsyncQueueStatistics::defaultQueueSize) {
     FILL_VIRTUAL_FUNCTION_TEMPLATE_VTABLE(getRegisterAccessor_impl);
     if(!mapFileName.empty()) {
       MapFileParser parser;
       std::tie(_registerMap, _metadataCatalogue) = parser.parse(mapFileName);
 
+      // extract the queue lengths for push-type accessors from the metadata
+      const std::string queueSizeKey{"ASYNC_QUEUE_SIZE"};
+      for(auto it = _metadataCatalogue.cbegin(); it != _metadataCatalogue.cend(); ++it) {
+        if(it->first.compare(0, queueSizeKey.size(), queueSizeKey) != 0) continue;
+        if(it->first != queueSizeKey && it->first[queueSizeKey.size()] != ':') {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Unknown key, expected '" +
+              queueSizeKey + "' or '" + queueSizeKey + ":<register>'.");
+        }
+        size_t queueSize = 0;
+        try {
+          // std::stoul accepts a sign and wraps negative numbers around
+          if(it->second.find('-') != std::string::npos) {
+            throw std::invalid_argument("negative queue size");
+          }
+          size_t end;
+          queueSize = std::stoul(it->second, &end, 0);
+          if(it->second.find_first_not_of(" \t", end) != std::string::npos) {
+            throw std::invalid_argument("trailing characters");
+          }
+        }
+        catch(std::exception& e) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Invalid value '" + it->second +
+              "', caught exception: " + e.what());
+        }
+        if(queueSize == 0 || queueSize > AsyncQueueStatistics::maxQueueSize) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first +
+              "': Queue size must be between 1 and " + std::to_string(AsyncQueueStatistics::maxQueueSize) + ".");
+        }
+        if(it->first == queueSizeKey) {
+          _defaultAsyncQueueSize = queueSize;
+        }
+        else {
+          RegisterPath registerName(it->first.substr(queueSizeKey.size() + 1));
+          registerName.setAltSeparator(".");
+          if(!_registerMap.hasRegister(registerName)) {
+            throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Unknown register.");
+          }
+          // store without alternative separator, so the key can be compared to any RegisterPath
+          _asyncQueueSizes[std::string(registerName)] = queueSize;
+        }
+      }
+
+      // collect the interrupt controller descriptions. The std::map is sorted such that controllers come before the
+      // controllers of their sub-interrupts.
+      const std::string controllerKey{"INTERRUPT_CONTROLLER:"};
+      std::map<std::vector<uint32_t>, std::string> controllerDescriptions;
+      for(auto it = _metadataCatalogue.cbegin(); it != _metadataCatalogue.cend(); ++it) {
+        if(it->first.compare(0, controllerKey.size(), controllerKey) != 0) continue;
+        controllerDescriptions[parseInterruptId(it->first, controllerKey.size())] = it->second;
+      }
+
+      // create the interrupt controller handlers, including the dispatchers of the interrupts they are connected to
+      for(const auto& [controllerId, description] : controllerDescriptions) {
+        getInterruptDispatcher(controllerId, true)
+            ->setInterruptControllerHandler(
+                std::make_unique<InterruptControllerHandler>(*this, _registerMap, controllerId, description));
+      }
+
       // create all the interrupt dispatchers that are described in the map file
       for(const auto& interruptID : _registerMap.getListOfInterrupts()) {
         // interrupt is a vector of nested interrupts
-        _primaryInterruptDispatchersNonConst.try_emplace(
-            interruptID.front(), boost::make_shared<NumericAddressedInterruptDispatcher>());
-        // FIXME: Put nested interrupt dispatchers
-        if(interruptID.size() > 1) {
-          throw ChimeraTK::logic_error("Nested interrupts are not supported yet!");
+        getInterruptDispatcher(interruptID, true);
+      }
+
+      // configure the time stamp registers of the interrupts
+      const std::string timestampKey{"INTERRUPT_TIMESTAMP:"};
+      for(auto it = _metadataCatalogue.cbegin(); it != _metadataCatalogue.cend(); ++it) {
+        if(it->first.compare(0, timestampKey.size(), timestampKey) != 0) continue;
+        auto interruptId = parseInterruptId(it->first, timestampKey.size());
+        if(!_registerMap.getListOfInterrupts().count(interruptId)) {
+          throw ChimeraTK::logic_error(
+              "Map file error in metadata '" + it->first + "': No register uses this interrupt.");
         }
+
+        // the value is <register>[;scale=<seconds per tick>][;offset=<seconds>]
+        std::stringstream stream(it->second);
+        std::string registerName, option;
+        std::getline(stream, registerName, ';');
+        long double scale = 1e-9L, offset = 0.L;
+        while(std::getline(stream, option, ';')) {
+          auto pos = option.find('=');
+          auto key = option.substr(0, pos);
+          if(pos == std::string::npos || (key != "scale" && key != "offset")) {
+            throw ChimeraTK::logic_error(
+                "Map file error in metadata '" + it->first + "': Invalid option '" + option + "'.");
+          }
+          try {
+            (key == "scale" ? scale : offset) = std::stold(option.substr(pos + 1));
+          }
+          catch(std::exception& e) {
+            throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Invalid value in '" +
+                option + "', caught exception: " + e.what());
+          }
+        }
+
+        RegisterPath timestampRegister(registerName);
+        timestampRegister.setAltSeparator(".");
+        if(!_registerMap.hasRegister(timestampRegister)) {
+          throw ChimeraTK::logic_error(
+              "Map file error in metadata '" + it->first + "': Unknown register '" + registerName + "'.");
+        }
+        auto nElements = _registerMap.getBackendRegister(timestampRegister).nElements;
+        if(nElements != 1 && nElements != 2) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first +
+              "': The time stamp register must have one or two elements.");
+        }
+        getInterruptDispatcher(interruptId)->setTimestampRegister(
+            std::string(timestampRegister), scale, offset);
+      }
+
+      // create the timers of the timer interrupts
+      const std::string timerKey{"TIMER_INTERRUPT:"};
+      for(auto it = _metadataCatalogue.cbegin(); it != _metadataCatalogue.cend(); ++it) {
+        if(it->first.compare(0, timerKey.size(), timerKey) != 0) continue;
+        auto interruptId = parseInterruptId(it->first, timerKey.size());
+        if(interruptId.size() != 1) {
+          throw ChimeraTK::logic_error(
+              "Map file error in metadata '" + it->first + "': A timer interrupt must be a primary interrupt.");
+        }
+        auto interruptNumber = interruptId.front();
+        if(!_primaryInterruptDispatchers.count(interruptNumber)) {
+          throw ChimeraTK::logic_error(
+              "Map file error in metadata '" + it->first + "': No register uses this interrupt.");
+        }
+        double periodMs = 0;
+        try {
+          periodMs = std::stod(it->second);
+        }
+        catch(std::exception& e) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Invalid period '" + it->second +
+              "', caught exception: " + e.what());
+        }
+        auto period = std::chrono::duration_cast<TimerInterruptSource::Duration>(
+            std::chrono::duration<double, std::milli>(periodMs));
+        if(period <= TimerInterruptSource::Duration::zero()) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': The period must be positive.");
+        }
+        _timerInterruptSources[interruptNumber] =
+            std::make_unique<TimerInterruptSource>(period, [this, interruptNumber] { dispatchInterrupt(interruptNumber); });
+      }
+
+      // enable the scheduling of transfers
+      const std::string schedulingKey{"TRANSFER_SCHEDULING"};
+      auto it = std::find_if(_metadataCatalogue.cbegin(), _metadataCatalogue.cend(),
+          [&](const auto& entry) { return entry.first == schedulingKey; });
+      if(it != _metadataCatalogue.cend()) {
+        size_t chunkSize = 0;
+        try {
+          if(it->second.find('-') != std::string::npos) {
+            throw std::invalid_argument("negative chunk size");
+          }
+          chunkSize = std::stoul(it->second, nullptr, 0);
+        }
+        catch(std::exception& e) {
+          throw ChimeraTK::logic_error("Map file error in metadata '" + it->first + "': Invalid chunk size '" +
+              it->second + "', caught exception: " + e.what());
+        }
+        enableTransferScheduling(chunkSize);
       }
     }
   }
@@ -101,6 +285,82 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  void NumericAddressedBackend::enableTransferScheduling(size_t chunkSizeInBytes) {
+    _transferChunkSize = chunkSizeInBytes;
+    _isTransferSchedulingEnabled = true;
+  }
+
+  /********************************************************************************************************************/
+
+  void NumericAddressedBackend::setTransferPriority(TransferElementAbstractor& accessor, TransferPriority priority) {
+    bool found = false;
+    for(auto& element : accessor.getHardwareAccessingElements()) {
+      auto lowLevelElement = boost::dynamic_pointer_cast<NumericAddressedLowLevelTransferElement>(element);
+      if(!lowLevelElement) continue;
+      lowLevelElement->setPriority(priority);
+      found = true;
+    }
+    if(!found) {
+      throw ChimeraTK::logic_error("NumericAddressedBackend::setTransferPriority(): Accessor '" + accessor.getName() +
+          "' does not directly access a NumericAddressedBackend.");
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  size_t NumericAddressedBackend::getTransferChunkSize(uint64_t bar, size_t sizeInBytes) const {
+    size_t chunkSize = _transferChunkSize;
+    if(chunkSize == 0) {
+      return sizeInBytes;
+    }
+    // chunks must start at a word boundary which also fulfils the alignment requirements of the backend
+    auto granularity = std::lcm(sizeof(int32_t), minimumTransferAlignment(bar));
+    return std::max(granularity, chunkSize / granularity * granularity);
+  }
+
+  /********************************************************************************************************************/
+
+  void NumericAddressedBackend::scheduledRead(
+      uint64_t bar, uint64_t address, int32_t* data, size_t sizeInBytes, TransferPriority priority) {
+    if(!_isTransferSchedulingEnabled) {
+      read(bar, address, data, sizeInBytes);
+      return;
+    }
+    auto chunkSize = getTransferChunkSize(bar, sizeInBytes);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    auto* bytes = reinterpret_cast<uint8_t*>(data);
+    size_t offset = 0;
+    do {
+      TransferScheduler::Slot slot(_transferScheduler, priority);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      read(bar, address + offset, reinterpret_cast<int32_t*>(bytes + offset), std::min(chunkSize, sizeInBytes - offset));
+      offset += chunkSize;
+    } while(offset < sizeInBytes);
+  }
+
+  /********************************************************************************************************************/
+
+  void NumericAddressedBackend::scheduledWrite(
+      uint64_t bar, uint64_t address, int32_t const* data, size_t sizeInBytes, TransferPriority priority) {
+    if(!_isTransferSchedulingEnabled) {
+      write(bar, address, data, sizeInBytes);
+      return;
+    }
+    auto chunkSize = getTransferChunkSize(bar, sizeInBytes);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+    size_t offset = 0;
+    do {
+      TransferScheduler::Slot slot(_transferScheduler, priority);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      write(bar, address + offset, reinterpret_cast<const int32_t*>(bytes + offset),
+          std::min(chunkSize, sizeInBytes - offset));
+      offset += chunkSize;
+    } while(offset < sizeInBytes);
+  }
+
+  /********************************************************************************************************************/
+
   // Default range of valid BARs
   bool NumericAddressedBackend::barIndexValid(uint64_t bar) {
     return bar <= 5 || bar == 13;
@@ -119,29 +379,17 @@ namespace ChimeraTK {
             "Register " + registerPathName + " does not support AccessMode::wait_for_new_data.");
       }
 
-      auto getNestedInterruptDispatcher =
-          [](std::vector<uint32_t> interruptID,
-              std::map<uint32_t, boost::shared_ptr<NumericAddressedInterruptDispatcher>> dispatchers,
-              [[maybe_unused]] auto&& _getNestedInterruptDispatcher)
-          -> boost::shared_ptr<NumericAddressedInterruptDispatcher> {
-        auto dispatcher = dispatchers[interruptID.front()];
-        if(interruptID.size() == 1) {
-          return dispatcher;
-        }
-        throw ChimeraTK::logic_error("Nested interrupts are not supported yet!");
-        // return _getNestedInterruptDispatcher({++interruptID.begin(), interruptID.end(),
-        // dispatcher->getInterruptControllerHandler()->dispatchers});
-      };
-
-      auto interruptDispatcher = getNestedInterruptDispatcher(
-          registerInfo.interruptId, _primaryInterruptDispatchers, getNestedInterruptDispatcher);
+      auto interruptDispatcher = getInterruptDispatcher(registerInfo.interruptId);
       assert(interruptDispatcher);
       auto newSubscriber = interruptDispatcher->template subscribe<UserType>(
           boost::dynamic_pointer_cast<NumericAddressedBackend>(shared_from_this()), registerPathName, numberOfWords,
-          wordOffsetInRegister, flags);
+          wordOffsetInRegister, flags, getAsyncQueueSize(registerPathName));
       // The new subscriber might already be activated. Hence the exception backend is already set by the interrupt
       // dispatcher.
-      startInterruptHandlingThread(registerInfo.interruptId.front());
+      // Timer interrupts are triggered by the backend itself, so the implementation must not wait for them.
+      if(!_timerInterruptSources.count(registerInfo.interruptId.front())) {
+        startInterruptHandlingThread(registerInfo.interruptId.front());
+      }
       return newSubscriber;
     }
     return getSyncRegisterAccessor<UserType>(registerPathName, numberOfWords, wordOffsetInRegister, flags);
@@ -217,22 +465,32 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  size_t NumericAddressedBackend::getAsyncQueueSize(const RegisterPath& registerPathName) const {
+    auto it = _asyncQueueSizes.find(registerPathName);
+    if(it != _asyncQueueSizes.end()) {
+      return it->second;
+    }
+    return _defaultAsyncQueueSize;
+  }
+
+  /********************************************************************************************************************/
+
   void NumericAddressedBackend::activateAsyncRead() noexcept {
+    DeviceBackendImpl::activateAsyncRead();
     for(const auto& it : _primaryInterruptDispatchers) {
       it.second->activate();
     }
+    for(auto& it : _timerInterruptSources) {
+      it.second->start();
+    }
   }
 
   /********************************************************************************************************************/
 
   void NumericAddressedBackend::setExceptionImpl() noexcept {
-    try {
-      throw ChimeraTK::runtime_error(getActiveExceptionMessage());
-    }
-    catch(...) {
-      for(const auto& it : _primaryInterruptDispatchers) {
-        it.second->sendException(std::current_exception());
-      }
+    auto exception = getActiveException();
+    for(const auto& it : _primaryInterruptDispatchers) {
+      it.second->sendException(exception);
     }
   }
 
@@ -244,6 +502,9 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   void NumericAddressedBackend::close() {
+    for(auto& it : _timerInterruptSources) {
+      it.second->stop();
+    }
     for(const auto& it : _primaryInterruptDispatchers) {
       it.second->deactivate();
     }
@@ -252,6 +513,54 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  boost::shared_ptr<NumericAddressedInterruptDispatcher> NumericAddressedBackend::getInterruptDispatcher(
+      const std::vector<uint32_t>& interruptId, bool create) {
+    assert(!interruptId.empty());
+    boost::shared_ptr<NumericAddressedInterruptDispatcher> dispatcher;
+    if(create) {
+      auto [it, isNew] = _primaryInterruptDispatchersNonConst.try_emplace(interruptId.front());
+      if(isNew) {
+        it->second = boost::make_shared<NumericAddressedInterruptDispatcher>();
+      }
+      dispatcher = it->second;
+    }
+    else {
+      dispatcher = _primaryInterruptDispatchers.at(interruptId.front());
+    }
+
+    for(size_t level = 1; level < interruptId.size(); ++level) {
+      auto* handler = dispatcher->getInterruptControllerHandler();
+      if(!handler) {
+        std::string name;
+        for(size_t i = 0; i < level; ++i) {
+          name += (i > 0 ? ":" : "") + std::to_string(interruptId[i]);
+        }
+        throw ChimeraTK::logic_error("Map file error: Nested interrupt " + name + ":" +
+            std::to_string(interruptId[level]) + " requires an interrupt controller, but there is no metadata "
+            "@INTERRUPT_CONTROLLER:" + name + ".");
+      }
+      dispatcher = create ? handler->addSubInterrupt(interruptId[level]) : handler->getSubInterrupt(interruptId[level]);
+    }
+    return dispatcher;
+  }
+
+  /********************************************************************************************************************/
+
+  TimerInterruptSource* NumericAddressedBackend::getTimerInterruptSource(uint32_t interruptNumber) {
+    auto it = _timerInterruptSources.find(interruptNumber);
+    return it != _timerInterruptSources.end() ? it->second.get() : nullptr;
+  }
+
+  /********************************************************************************************************************/
+
+  void NumericAddressedBackend::setTimerInterruptClock(const std::shared_ptr<TimerInterruptSource::Clock>& clock) {
+    for(auto& it : _timerInterruptSources) {
+      it.second->setClock(clock);
+    }
+  }
+
+  /********************************************************************************************************************/
+
   VersionNumber NumericAddressedBackend::dispatchInterrupt(uint32_t interruptNumber) {
     // This function just makes sure that at() is used to access the _interruptDispatchers map,
     // which guarantees that the map is not altered.
@@ -261,7 +570,7 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   RegisterCatalogue NumericAddressedBackend::getRegisterCatalogue() const {
-    return RegisterCatalogue(_registerMap.clone());
+    return RegisterCatalogue(std::shared_ptr<const BackendRegisterCatalogueBase>(_registerMapPointer));
   }
 
   /********************************************************************************************************************/
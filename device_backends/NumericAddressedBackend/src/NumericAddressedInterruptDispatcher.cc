@@ -3,6 +3,8 @@
 
 #include "NumericAddressedInterruptDispatcher.h"
 
+#include <cmath>
+
 namespace ChimeraTK {
 
   NumericAddressedInterruptDispatcher::NumericAddressedInterruptDispatcher() {
@@ -11,23 +13,43 @@ namespace ChimeraTK {
 
   //*********************************************************************************************************************/
   VersionNumber NumericAddressedInterruptDispatcher::trigger() {
-    std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+    std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
     VersionNumber ver; // a common VersionNumber for this trigger. Must be generated under mutex
-    if(!_isActive) return ver;
+
+    // Only take the snapshot of the subscribed variables under the _variablesMutex. The transfer and the distribution
+    // of the data are done without it, so subscriptions and unsubscriptions are not blocked by them.
+    std::shared_ptr<const AsyncVariableList> asyncVariables;
+    boost::shared_ptr<NDRegisterAccessor<int32_t>> timestampAccessor;
+    {
+      std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+      if(!_isActive) return ver;
+      asyncVariables = _asyncVariableList;
+      timestampAccessor = _timestampAccessor;
+    }
 
     try {
-      _transferGroup->read();
+      getUpdatedTransferGroup()->read();
 
-      for(auto& var : _asyncVariables) {
-        auto* numericAddressAsyncVariable = dynamic_cast<NumericAddressedAsyncVariable*>(var.second.get());
+      if(timestampAccessor) {
+        // the time stamp has been read in the same transfer as the data
+        ver = VersionNumber(getTimestamp(*timestampAccessor));
+      }
+
+      for(const auto& var : *asyncVariables) {
+        auto* numericAddressAsyncVariable = dynamic_cast<NumericAddressedAsyncVariable*>(var.get());
         assert(numericAddressAsyncVariable);
         numericAddressAsyncVariable->fillSendBuffer(ver);
-        var.second->send(); // send function from  the AsyncVariable base class
+        var->send(); // send function from  the AsyncVariable base class
       }
     }
     catch(ChimeraTK::runtime_error&) {
       // Nothing to do. Backend's set exception has already been called by the accessor in the transfer group that
       // raised it.
+      return ver;
+    }
+
+    if(_controllerHandler) {
+      _controllerHandler->handle();
     }
 
     return ver;
@@ -35,25 +57,92 @@ namespace ChimeraTK {
 
   //*********************************************************************************************************************/
   VersionNumber NumericAddressedInterruptDispatcher::activate() {
+    std::lock_guard<std::mutex> dispatchLock(_dispatchMutex);
+    // Activation has to be atomic w.r.t. subscriptions, which check the _isActive flag. Hence we hold the
+    // _variablesMutex for the whole time.
     std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
     VersionNumber ver; // a common VersionNumber for this trigger. Must be generated under mutex
     try {
-      _transferGroup->read();
+      getUpdatedTransferGroup()->read();
 
-      for(auto& var : _asyncVariables) {
-        auto* numericAddressAsyncVariable = dynamic_cast<NumericAddressedAsyncVariable*>(var.second.get());
+      // iterate the immutable list, since read notification listeners called in activateAndSend() might unsubscribe
+      auto asyncVariables = _asyncVariableList;
+      for(const auto& var : *asyncVariables) {
+        auto* numericAddressAsyncVariable = dynamic_cast<NumericAddressedAsyncVariable*>(var.get());
         assert(numericAddressAsyncVariable);
         numericAddressAsyncVariable->fillSendBuffer(ver);
-        var.second->activateAndSend(); // function from  the AsyncVariable base class
+        var->activateAndSend(); // function from  the AsyncVariable base class
       }
       _isActive = true;
     }
     catch(ChimeraTK::runtime_error&) {
       // Nothing to do. Backend's set exception has already been called by the accessor in the transfer group that
       // raised it.
+      return ver;
+    }
+
+    if(_controllerHandler) {
+      _controllerHandler->activate();
     }
 
     return ver;
   }
 
+  //*********************************************************************************************************************/
+  void NumericAddressedInterruptDispatcher::deactivate() {
+    AsyncAccessorManager::deactivate();
+    if(_controllerHandler) {
+      _controllerHandler->deactivate();
+    }
+  }
+
+  //*********************************************************************************************************************/
+  void NumericAddressedInterruptDispatcher::sendException(const std::exception_ptr& e) {
+    AsyncAccessorManager::sendException(e);
+    if(_controllerHandler) {
+      _controllerHandler->sendException(e);
+    }
+  }
+
+  //*********************************************************************************************************************/
+  void NumericAddressedInterruptDispatcher::setTimestampRegister(
+      const RegisterPath& name, long double scale, long double offset) {
+    _timestampRegister = name;
+    _timestampScale = scale;
+    _timestampOffset = offset;
+  }
+
+  //*********************************************************************************************************************/
+  std::chrono::system_clock::time_point NumericAddressedInterruptDispatcher::getTimestamp(
+      NDRegisterAccessor<int32_t>& accessor) const {
+    auto& words = accessor.accessChannel(0);
+    uint64_t counter = static_cast<uint32_t>(words[0]);
+    if(words.size() > 1) {
+      counter |= static_cast<uint64_t>(static_cast<uint32_t>(words[1])) << 32;
+    }
+    long double seconds = static_cast<long double>(counter) * _timestampScale + _timestampOffset;
+    long double wholeSeconds = std::floor(seconds);
+    auto sinceEpoch = std::chrono::seconds(static_cast<int64_t>(wholeSeconds)) +
+        std::chrono::nanoseconds(static_cast<int64_t>(std::round((seconds - wholeSeconds) * 1e9L)));
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(sinceEpoch));
+  }
+
+  //*********************************************************************************************************************/
+  std::shared_ptr<TransferGroup> NumericAddressedInterruptDispatcher::getUpdatedTransferGroup() {
+    std::shared_ptr<TransferGroup> transferGroup;
+    std::vector<boost::shared_ptr<TransferElement>> pendingAccessors;
+    {
+      std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
+      transferGroup = _transferGroup;
+      pendingAccessors.swap(_pendingAccessors);
+    }
+
+    // Adding to the TransferGroup might be expensive as it tries to merge transfers. Do it without the _variablesMutex.
+    for(auto& accessor : pendingAccessors) {
+      transferGroup->addAccessor(accessor);
+    }
+    return transferGroup;
+  }
+
 } // namespace ChimeraTK
@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
 #include <utility>
 
@@ -199,6 +200,79 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
   /********************************************************************************************************************/
 
+  namespace {
+    /** Return a + b, limited to the largest possible address instead of wrapping around. */
+    uint64_t saturatingAdd(uint64_t a, uint64_t b) {
+      return a + b < a ? std::numeric_limits<uint64_t>::max() : a + b;
+    }
+  } // namespace
+
+  /********************************************************************************************************************/
+
+  RegisterAddressIndex::RegisterAddressIndex(const std::vector<const NumericAddressedRegisterInfo*>& registers) {
+    for(const auto* info : registers) {
+      auto nBytes = std::max<uint64_t>(uint64_t(info->nElements) * info->elementPitchBits / 8, 1);
+      _bars[info->bar].intervals.push_back({info->address, saturatingAdd(info->address, nBytes), info});
+    }
+    for(auto& [barNumber, bar] : _bars) {
+      std::stable_sort(bar.intervals.begin(), bar.intervals.end(),
+          [](const Interval& a, const Interval& b) { return a.begin < b.begin; });
+      bar.maxEnd.resize(bar.intervals.size());
+      build(bar, 0, bar.intervals.size());
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  uint64_t RegisterAddressIndex::build(Bar& bar, size_t first, size_t last) {
+    if(first == last) {
+      return 0;
+    }
+    auto middle = first + (last - first) / 2;
+    bar.maxEnd[middle] =
+        std::max({bar.intervals[middle].end, build(bar, first, middle), build(bar, middle + 1, last)});
+    return bar.maxEnd[middle];
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<const NumericAddressedRegisterInfo*> RegisterAddressIndex::getRegistersInRange(
+      uint64_t bar, uint64_t address, uint64_t nBytes) const {
+    std::vector<const NumericAddressedRegisterInfo*> result;
+    auto it = _bars.find(bar);
+    if(it != _bars.end() && nBytes > 0) {
+      collect(it->second, 0, it->second.intervals.size(), address, saturatingAdd(address, nBytes), result);
+    }
+    return result;
+  }
+
+  /********************************************************************************************************************/
+
+  void RegisterAddressIndex::collect(const Bar& bar, size_t first, size_t last, uint64_t begin, uint64_t end,
+      std::vector<const NumericAddressedRegisterInfo*>& result) {
+    if(first == last) {
+      return;
+    }
+    auto middle = first + (last - first) / 2;
+    // no interval in this subtree reaches into the range
+    if(bar.maxEnd[middle] <= begin) {
+      return;
+    }
+    collect(bar, first, middle, begin, end, result);
+    const auto& interval = bar.intervals[middle];
+    // all intervals in the right subtree start at or after this one
+    if(interval.begin >= end) {
+      return;
+    }
+    if(interval.end > begin) {
+      result.push_back(interval.info);
+    }
+    collect(bar, middle + 1, last, begin, end, result);
+  }
+
+  /********************************************************************************************************************/
+  /********************************************************************************************************************/
+
   NumericAddressedRegisterInfo NumericAddressedRegisterCatalogue::getBackendRegister(
       const RegisterPath& registerPathName) const {
     auto path = registerPathName;
@@ -241,12 +315,52 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  const BackendRegisterInfoBase* NumericAddressedRegisterCatalogue::findRegister(
+      const RegisterPath& registerPathName) const {
+    // numeric addresses are synthesised by getBackendRegister()
+    if(registerPathName.startsWith(numeric_address::BAR())) {
+      return nullptr;
+    }
+    return BackendRegisterCatalogue::findRegister(registerPathName);
+  }
+
+  /********************************************************************************************************************/
+
   const std::set<std::vector<uint32_t>>& NumericAddressedRegisterCatalogue::getListOfInterrupts() const {
     return _listOfInterrupts;
   }
 
   /********************************************************************************************************************/
 
+  std::vector<const NumericAddressedRegisterInfo*> NumericAddressedRegisterCatalogue::getRegistersAtAddress(
+      uint64_t bar, uint64_t address) const {
+    return getRegistersInAddressRange(bar, address, 1);
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<const NumericAddressedRegisterInfo*> NumericAddressedRegisterCatalogue::getRegistersInAddressRange(
+      uint64_t bar, uint64_t address, uint64_t nBytes) const {
+    const auto& index = _addressIndex.get([&] {
+      std::vector<const NumericAddressedRegisterInfo*> registers;
+      registers.reserve(getNumberOfRegisters());
+      for(const auto& info : *this) {
+        registers.push_back(&info);
+      }
+      return registers;
+    });
+    return index.getRegistersInRange(bar, address, nBytes);
+  }
+
+  /********************************************************************************************************************/
+
+  void NumericAddressedRegisterCatalogue::invalidateIndices() {
+    BackendRegisterCatalogue<NumericAddressedRegisterInfo>::invalidateIndices();
+    _addressIndex.reset();
+  }
+
+  /********************************************************************************************************************/
+
   void NumericAddressedRegisterCatalogue::addRegister(const NumericAddressedRegisterInfo& registerInfo) {
     if(registerInfo.registerAccess == NumericAddressedRegisterInfo::Access::INTERRUPT) {
       _listOfInterrupts.insert(registerInfo.interruptId);
@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "TransferScheduler.h"
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  void TransferScheduler::acquire(TransferPriority priority) {
+    auto level = static_cast<size_t>(priority);
+    std::unique_lock<std::mutex> lock(_mutex);
+    ++_nWaiting[level];
+    _condition.wait(lock, [&] {
+      if(_isBusy) return false;
+      for(size_t higher = level + 1; higher < _nWaiting.size(); ++higher) {
+        if(_nWaiting[higher] > 0) return false;
+      }
+      return true;
+    });
+    --_nWaiting[level];
+    _isBusy = true;
+  }
+
+  /********************************************************************************************************************/
+
+  void TransferScheduler::release() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _isBusy = false;
+    }
+    _condition.notify_all();
+  }
+
+  /********************************************************************************************************************/
+
+  size_t TransferScheduler::getNumberOfWaitingTransfers() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nWaiting[0] + _nWaiting[1] + _nWaiting[2];
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -112,8 +112,11 @@ namespace ChimeraTK {
     /// for type == threeRegisters or twoRegisters: sleep time between address and data write
     size_t addressToDataDelay{0};
 
-    /// map from register names to addresses
-    NumericAddressedRegisterCatalogue _registerMap;
+    /// map from register names to addresses. It is shared with the RegisterCatalogue objects returned by
+    /// getRegisterCatalogue(), hence it must not be modified after the constructor has completed.
+    std::shared_ptr<NumericAddressedRegisterCatalogue> _registerMapPointer{
+        std::make_shared<NumericAddressedRegisterCatalogue>()};
+    NumericAddressedRegisterCatalogue& _registerMap{*_registerMapPointer};
     MetadataCatalogue _metadataCatalogue;
 
     /// Check consistency of the passed sizes and offsets against the information in the map file
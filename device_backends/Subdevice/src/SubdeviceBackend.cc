@@ -195,7 +195,7 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   RegisterCatalogue SubdeviceBackend::getRegisterCatalogue() const {
-    return RegisterCatalogue(_registerMap.clone());
+    return RegisterCatalogue(std::shared_ptr<const BackendRegisterCatalogueBase>(_registerMapPointer));
   }
 
   /********************************************************************************************************************/
@@ -527,6 +527,7 @@ namespace ChimeraTK {
   /********************************************************************************************************************/
 
   void SubdeviceBackend::activateAsyncRead() noexcept {
+    DeviceBackendImpl::activateAsyncRead();
     obtainTargetBackend();
     targetDevice->activateAsyncRead();
   }
@@ -4,8 +4,10 @@
 
 #include "AsyncNDRegisterAccessor.h"
 
+#include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace ChimeraTK {
 
@@ -74,6 +76,11 @@ namespace ChimeraTK {
    *  subscribed variables is not thread safe. This class implements a lock so
    *  dispatching an interrupt is safe against concurrent subscriptions/unsubscriptions.
    *
+   *  In addition to the map of subscribed variables, an immutable list of the variables is kept (copy-on-write). It is
+   *  re-created on each subscription/unsubscription. Code distributing data only takes the lock to obtain the current
+   *  list, and iterates it without holding the lock. Hence, subscribing and unsubscribing is not blocked by the
+   *  distribution of data.
+   *
    *  The AsyncAccessorManager has some pure virtual functions. The implementation is backend
    *  specific and must be provided by a derived version of the AsyncAccessorManager.
    */
@@ -84,10 +91,13 @@ namespace ChimeraTK {
     /** Request a new subscription. This function internally creates the correct asynchronous accessor and a matching
      * AsyncVariable. A weak pointer to the AsyncNDRegisterAccessor is registered in the AsyncVariable, and a shared
      * pointer is returned to the calling code.
+     *
+     * The queueSize is the length of the data transport queue of the created AsyncNDRegisterAccessor.
      */
     template<typename UserType>
     boost::shared_ptr<AsyncNDRegisterAccessor<UserType>> subscribe(boost::shared_ptr<DeviceBackend> backend,
-        RegisterPath name, size_t numberOfWords, size_t wordOffsetInRegister, AccessModeFlags flags);
+        RegisterPath name, size_t numberOfWords, size_t wordOffsetInRegister, AccessModeFlags flags,
+        size_t queueSize = AsyncQueueStatistics::defaultQueueSize);
 
     /** This function must only be called from the destructor of the AsyncNDRegisterAccessor which is created in the
      * subscribe function!
@@ -96,7 +106,7 @@ namespace ChimeraTK {
 
     /** Send an exception to all accessors. This automatically de-activates them.
      */
-    void sendException(const std::exception_ptr& e);
+    virtual void sendException(const std::exception_ptr& e);
 
     /** Activate all accessors and send the initial value. Generates a new version number which is used for
      *  all initial values and  which can be read out with getLastVersion().
@@ -107,7 +117,7 @@ namespace ChimeraTK {
     /** Deactivate all subscribers without throwing an exception.
      *  This has to happen when a backend is closed.
      */
-    void deactivate();
+    virtual void deactivate();
 
    protected:
     /*** Each implementation must provide a function to create specific AsyncVariables.
@@ -127,12 +137,22 @@ namespace ChimeraTK {
     // holding the lock.
     // 2. The elements in the container are not thread-safe as well. We use the same lock as it is needed for 1. anyway.
     std::recursive_mutex _variablesMutex;
-    std::map<TransferElementID, std::unique_ptr<AsyncVariable>> _asyncVariables; ///< protected by _variablesMutex
+    std::map<TransferElementID, std::shared_ptr<AsyncVariable>> _asyncVariables; ///< protected by _variablesMutex
     bool _isActive{false};                                                       ///< protected by _variablesMutex
 
+    /// Immutable snapshot of the variables in _asyncVariables. A new list is created each time _asyncVariables is
+    /// modified, so holders of an old list can safely keep iterating it without holding the _variablesMutex. The
+    /// pointer itself is protected by _variablesMutex.
+    using AsyncVariableList = std::vector<std::shared_ptr<AsyncVariable>>;
+    std::shared_ptr<const AsyncVariableList> _asyncVariableList{std::make_shared<AsyncVariableList>()};
+
     /// this virtual function lets derived classes react on subscribe / unsubscribe
     /// _variablesMutex locked during call
     virtual void asyncVariableMapChanged() {}
+
+   private:
+    /// Re-create the _asyncVariableList from _asyncVariables. _variablesMutex must be locked.
+    void updateAsyncVariableList();
   };
 
   /** AsyncVariableImpl contains a weak pointer to an AsyncNDRegisterAccessor<UserType> and a send buffer
@@ -163,6 +183,11 @@ namespace ChimeraTK {
    protected:
     typename NDRegisterAccessor<UserType>::Buffer _sendBuffer;
     std::atomic<bool> _isActive{false};
+
+    // Data is distributed without holding the AsyncAccessorManager::_variablesMutex. This mutex protects the transfer
+    // into the accessor against a concurrent activation/deactivation or exception, so the sequence in the queue stays
+    // consistent.
+    std::mutex _transportMutex;
   };
 
   //*********************************************************************************************************************/
@@ -173,21 +198,33 @@ namespace ChimeraTK {
   template<typename UserType>
   void AsyncVariableImpl<UserType>::activateAndSend() {
     // The initial value must have been set before calling this function. We can just send it.
-    auto subscriber = _asyncAccessor.lock();
-    if(subscriber.get() != nullptr) { // Possible race condition: The subscriber is being destructed.
+    boost::shared_ptr<AsyncNDRegisterAccessor<UserType>> subscriber;
+    {
+      std::lock_guard<std::mutex> transportLock(_transportMutex);
+      subscriber = _asyncAccessor.lock();
+      if(subscriber.get() == nullptr) { // Possible race condition: The subscriber is being destructed.
+        return;
+      }
       subscriber->activate(_sendBuffer);
       _isActive = true;
     }
+    subscriber->notifyReadListener();
   }
 
   //*********************************************************************************************************************/
   template<typename UserType>
   void AsyncVariableImpl<UserType>::sendException(std::exception_ptr e) {
-    _isActive = false;
-    auto subscriber = _asyncAccessor.lock();
-    if(subscriber.get() != nullptr) { // Possible race condition: The subscriber is being destructed.
+    boost::shared_ptr<AsyncNDRegisterAccessor<UserType>> subscriber;
+    {
+      std::lock_guard<std::mutex> transportLock(_transportMutex);
+      _isActive = false;
+      subscriber = _asyncAccessor.lock();
+      if(subscriber.get() == nullptr) { // Possible race condition: The subscriber is being destructed.
+        return;
+      }
       subscriber->sendException(e);
     }
+    subscriber->notifyReadListener();
   }
 
   //*********************************************************************************************************************/
@@ -202,6 +239,7 @@ namespace ChimeraTK {
   //*********************************************************************************************************************/
   template<typename UserType>
   void AsyncVariableImpl<UserType>::deactivate() {
+    std::lock_guard<std::mutex> transportLock(_transportMutex);
     auto subscriber = _asyncAccessor.lock();
     if(subscriber.get() != nullptr) { // Possible race condition: The subscriber is being destructed.
       subscriber->deactivate();
@@ -212,17 +250,24 @@ namespace ChimeraTK {
   //*********************************************************************************************************************/
   template<typename UserType>
   void AsyncVariableImpl<UserType>::send() {
-    auto subscriber = _asyncAccessor.lock();
-    if(subscriber.get() != nullptr) { // Possible race condition: The subscriber is being destructed.
+    boost::shared_ptr<AsyncNDRegisterAccessor<UserType>> subscriber;
+    {
+      std::lock_guard<std::mutex> transportLock(_transportMutex);
+      subscriber = _asyncAccessor.lock();
+      if(subscriber.get() == nullptr) { // Possible race condition: The subscriber is being destructed.
+        return;
+      }
       subscriber->sendDestructively(_sendBuffer);
     }
+    // outside of the lock, since the listener may resume application code
+    subscriber->notifyReadListener();
   }
 
   //*********************************************************************************************************************/
   template<typename UserType>
   boost::shared_ptr<AsyncNDRegisterAccessor<UserType>> AsyncAccessorManager::subscribe(
       boost::shared_ptr<DeviceBackend> backend, RegisterPath name, size_t numberOfWords, size_t wordOffsetInRegister,
-      AccessModeFlags flags) {
+      AccessModeFlags flags, size_t queueSize) {
     std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
 
     AccessorInstanceDescriptor descriptor(name, typeid(UserType), numberOfWords, wordOffsetInRegister, flags);
@@ -234,7 +279,7 @@ namespace ChimeraTK {
     // here
     auto newSubscriber = boost::make_shared<AsyncNDRegisterAccessor<UserType>>(backend, shared_from_this(), name,
         asyncVariable->getNumberOfChannels(), asyncVariable->getNumberOfSamples(), flags, asyncVariable->getUnit(),
-        asyncVariable->getDescription());
+        asyncVariable->getDescription(), queueSize);
     // Set the exception backend here. It might be that the accessor is already activated during subscription, and the
     // backend should be set at that point
     newSubscriber->setExceptionBackend(backend);
@@ -252,6 +297,7 @@ namespace ChimeraTK {
       asyncVariable->activateAndSend();
     }
     _asyncVariables[newSubscriber->getId()] = std::move(untypedAsyncVariable);
+    updateAsyncVariableList();
     asyncVariableMapChanged();
     return newSubscriber;
   }
@@ -8,29 +8,93 @@
 #include <ChimeraTK/cppext/finally.hpp>
 #include <ChimeraTK/cppext/future_queue.hpp>
 
+#include <atomic>
+
 namespace ChimeraTK {
 
   class AsyncAccessorManager;
 
+  /** Statistics about the data transport queue of an AsyncNDRegisterAccessor. They allow to size the queues and to
+   *  find out whether data has been lost because a consumer did not keep up with the producer.
+   *
+   *  The application obtains the statistics through findAsyncQueueStatistics().
+   */
+  class AsyncQueueStatistics {
+   public:
+    virtual ~AsyncQueueStatistics() = default;
+
+    /** Length of the data transport queue if nothing else is specified. */
+    static constexpr size_t defaultQueueSize{3};
+
+    /** Largest length of the data transport queue which can be configured through the map file metadata. The queue
+     *  buffers are allocated in advance, so a mistyped value must not lead to a huge allocation. */
+    static constexpr size_t maxQueueSize{65536};
+
+    /** Return the length of the data transport queue. */
+    [[nodiscard]] size_t getQueueSize() const { return _queueSize; }
+
+    /** Return the number of elements which have been overwritten, because the queue was full when new data arrived. */
+    [[nodiscard]] size_t getNumberOfOverwrittenElements() const { return _nOverwrittenElements; }
+
+    /** Return the maximum number of elements which have been waiting in the queue at the same time. */
+    [[nodiscard]] size_t getQueueHighWaterMark() const { return _queueHighWaterMark; }
+
+    /** Reset the number of overwritten elements and the high-water mark to 0. */
+    void resetQueueStatistics() {
+      _nOverwrittenElements = 0;
+      _queueHighWaterMark = 0;
+    }
+
+   protected:
+    explicit AsyncQueueStatistics(size_t queueSize) : _queueSize(queueSize) {}
+
+    /** To be called by the sending thread after each push into the queue. */
+    void updateQueueStatistics(bool hasOverwritten, size_t nElementsInQueue) {
+      if(hasOverwritten) {
+        ++_nOverwrittenElements;
+      }
+      // only the sending thread is writing, so there is no race between loading and storing
+      if(nElementsInQueue > _queueHighWaterMark) {
+        _queueHighWaterMark = nElementsInQueue;
+      }
+    }
+
+    const size_t _queueSize;
+    std::atomic<size_t> _nOverwrittenElements{0};
+    std::atomic<size_t> _queueHighWaterMark{0};
+  };
+
+  /** Search the AsyncQueueStatistics in the hardware accessing elements of the given accessor. Returns nullptr if the
+   *  accessor does not have an AsyncNDRegisterAccessor underneath (e.g. because it does not have
+   *  AccessMode::wait_for_new_data).
+   */
+  boost::shared_ptr<AsyncQueueStatistics> findAsyncQueueStatistics(const boost::shared_ptr<TransferElement>& accessor);
+
   /** The AsyncNDRegisterAccessor implements a data transport queue with typed data
    *  as continuation of the void queue in TransferElement. This allows to
    *  receive the content of the buffer_2D, the version number and the data validity flag.
    *  The implementation is complete. The interrupt handling thread in the backend implementation
    *  can write to the queues through the member functions, and activate and deactivate the accessor.
+   *
+   *  Data is never copied on its way to the application. The buffers are swapped into the queue, and the buffer which
+   *  is taken out of the queue in exchange is handed back to the sender for the next value. With a queue size of 1 the
+   *  accessor works as a mailbox: a new value overwrites the value which has not been read yet, and the application
+   *  always receives the latest value. Together with the buffer of the sender and the buffer of the application this
+   *  is a lock-free triple buffer.
    */
   template<typename UserType>
-  class AsyncNDRegisterAccessor : public NDRegisterAccessor<UserType> {
-    static constexpr size_t _queueSize{3};
-
+  class AsyncNDRegisterAccessor : public NDRegisterAccessor<UserType>, public AsyncQueueStatistics {
    public:
     /** In addition to the arguments of the NDRegisterAccessor constructor, you need
      *  an AsyncAccessorManager where you can unsubscribe. As the AsyncAccessorManager is
      *  the factory for AsyncNDRegisterAccessor, this is only an implementation detail.
+     *
+     *  The queueSize is the length of the data transport queue. It must be at least 1.
      */
     AsyncNDRegisterAccessor(boost::shared_ptr<DeviceBackend> backend, boost::shared_ptr<AsyncAccessorManager> manager,
         std::string const& name, size_t nChannels, size_t nElements, AccessModeFlags accessModeFlags,
         std::string const& unit = std::string(TransferElement::unitNotSet),
-        std::string const& description = std::string());
+        std::string const& description = std::string(), size_t queueSize = defaultQueueSize);
 
     ~AsyncNDRegisterAccessor() override;
 
@@ -52,7 +116,8 @@ namespace ChimeraTK {
         return;
       }
 
-      _dataTransportQueue.push_overwrite(std::move(data));
+      bool hasOverwritten = !_dataTransportQueue.push_overwrite(std::move(data));
+      updateQueueStatistics(hasOverwritten, _dataTransportQueue.read_available());
     }
 
     /** Activate the accessor and send the initial value.
@@ -67,6 +132,11 @@ namespace ChimeraTK {
      */
     void deactivate() { _isActive = false; }
 
+    /** Call the listener set with setReadNotificationListener(). To be called by the sending thread after
+     *  sendDestructively(), sendException() or activate(), once it does not hold any locks anymore.
+     */
+    void notifyReadListener() { _readNotifier.notify(); }
+
     ////////////////////////////////////////////////////
     // implementation of inherited, virtual functions //
     ////////////////////////////////////////////////////
@@ -118,6 +188,12 @@ namespace ChimeraTK {
 
     void interrupt() override { this->interrupt_impl(this->_dataTransportQueue); }
 
+    void wakeUpRead() override { this->wakeUpRead_impl(this->_dataTransportQueue); }
+
+    void setReadNotificationListener(std::function<void()> listener) override {
+      _readNotifier.set(std::move(listener));
+    }
+
    protected:
     boost::shared_ptr<DeviceBackend> _backend;
     boost::shared_ptr<AsyncAccessorManager> _accessorManager;
@@ -125,6 +201,8 @@ namespace ChimeraTK {
     using NDRegisterAccessor<UserType>::buffer_2D;
     Buffer _receiveBuffer;
 
+    detail::ReadNotifier _readNotifier;
+
     // variables to simplify the bookkeeping and only send to the queue when it is allowed
     bool _isActive{false};
     // FIXME: This was taken from ExceptionDummyPushDecorator but I think it does not add any value unless there is
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /**
+   * Small pool of worker threads which executes the transfers started with TransferElement::readAsyncTransfer(),
+   * TransferElement::writeAsyncTransfer() and the corresponding functions of the TransferGroup. Each backend has its
+   * own pool (see DeviceBackend::getAsyncTransferPool()), so a slow device does not delay the transfers of other
+   * devices. Transfers of elements without backend use the default pool.
+   *
+   * The threads are started with the first job. Jobs are executed in the order of submission.
+   */
+  class AsyncTransferPool {
+   public:
+    /** Create a pool with the given number of worker threads. */
+    explicit AsyncTransferPool(size_t nThreads = 2);
+
+    /** Stops the threads after the pending jobs have been executed. */
+    ~AsyncTransferPool();
+
+    AsyncTransferPool(const AsyncTransferPool&) = delete;
+    AsyncTransferPool& operator=(const AsyncTransferPool&) = delete;
+
+    /** Execute the given job in one of the worker threads. The job must not throw. */
+    void submit(std::function<void()> job);
+
+    /** Return the number of worker threads. */
+    [[nodiscard]] size_t getNumberOfThreads() const { return _nThreads; }
+
+    /** Return the pool used for transfers of elements without backend. */
+    static AsyncTransferPool& getDefault();
+
+   protected:
+    /** State shared with the worker threads. A worker thread might destroy the pool itself, by releasing the last
+     *  reference to the backend owning it. It then has to outlive the pool. */
+    struct State {
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::deque<std::function<void()>> jobs;
+      bool stop{false};
+    };
+
+    static void run(const std::shared_ptr<State>& state);
+
+    size_t _nThreads;
+    std::shared_ptr<State> _state{std::make_shared<State>()};
+
+    /// Protected by _state->mutex
+    std::vector<std::thread> _threads;
+  };
+
+} // namespace ChimeraTK
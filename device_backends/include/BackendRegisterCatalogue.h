@@ -2,10 +2,16 @@
 // SPDX-License-Identifier: LGPL-3.0-or-later
 #pragma once
 
+#include "LazyIndex.h"
 #include "RegisterCatalogue.h"
+#include "RegisterPathTree.h"
 
 #include <boost/make_shared.hpp>
 
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
 namespace ChimeraTK {
 
   template<typename BackendRegisterInfo>
@@ -41,6 +47,17 @@ namespace ChimeraTK {
      */
     [[nodiscard]] virtual RegisterInfo getRegister(const RegisterPath& registerPathName) const = 0;
 
+    /**
+     * Get a pointer to the register information stored in the catalogue, without copying it. Returns nullptr if the
+     * register is not stored in the catalogue, which includes registers which are provided by an overridden
+     * getBackendRegister() only, e.g. numeric addresses. The pointer stays valid as long as the catalogue is not
+     * modified. The default implementation always returns nullptr, so getRegister() is used instead.
+     */
+    [[nodiscard]] virtual const BackendRegisterInfoBase* findRegister(
+        [[maybe_unused]] const RegisterPath& registerPathName) const {
+      return nullptr;
+    }
+
     /** Check if register with the given path name exists. */
     [[nodiscard]] virtual bool hasRegister(const RegisterPath& registerPathName) const = 0;
 
@@ -55,6 +72,54 @@ namespace ChimeraTK {
 
     /** Create deep copy of the catalogue */
     [[nodiscard]] virtual std::unique_ptr<BackendRegisterCatalogueBase> clone() const = 0;
+
+    /**
+     * Return all registers in the given module, including all submodules. See RegisterPathTree::getRegistersInModule()
+     * for details. Only registers which appear when iterating the catalogue are considered.
+     */
+    [[nodiscard]] std::vector<const BackendRegisterInfoBase*> getRegistersInModule(
+        const RegisterPath& moduleName) const {
+      return getRegisterPathTree().getRegistersInModule(moduleName);
+    }
+
+    /**
+     * Return the names of the direct children (registers and submodules) of the given module. See
+     * RegisterPathTree::getChildNames() for details.
+     */
+    [[nodiscard]] std::vector<std::string> getChildNames(const RegisterPath& moduleName) const {
+      return getRegisterPathTree().getChildNames(moduleName);
+    }
+
+    /**
+     * Return all registers matching the given glob pattern. See RegisterPathTree::getRegistersMatching() for details.
+     * Only registers which appear when iterating the catalogue are considered.
+     */
+    [[nodiscard]] std::vector<const BackendRegisterInfoBase*> getRegistersMatching(const std::string& pattern) const {
+      return getRegisterPathTree().getRegistersMatching(pattern);
+    }
+
+   protected:
+    /** Return the prefix tree over the names of the registers in the catalogue. It is built on first use. */
+    [[nodiscard]] const RegisterPathTree& getRegisterPathTree() const {
+      return _registerPathTree.get([&] {
+        std::vector<const BackendRegisterInfoBase*> registers;
+        registers.reserve(getNumberOfRegisters());
+        for(auto it = getConstIteratorBegin(), end = getConstIteratorEnd(); !it->isEqual(end); it->increment()) {
+          registers.push_back(it->get());
+        }
+        return registers;
+      });
+    }
+
+    /**
+     * Discard all indices which are built on first use, like the prefix tree. Implementations must call this whenever
+     * registers are added, removed or modified. Implementations with additional indices must override this function
+     * and call the base class implementation.
+     */
+    virtual void invalidateIndices() { _registerPathTree.reset(); }
+
+   private:
+    LazyIndex<RegisterPathTree> _registerPathTree;
   };
 
   /*******************************************************************************************************************/
@@ -70,9 +135,21 @@ namespace ChimeraTK {
   class BackendRegisterCatalogue : public BackendRegisterCatalogueBase {
    public:
     /// Note: Override this function if backend has "hidden" registers which are not added to the map and hence do not
-    /// appear when iterating. Do not forget to also override hasRegister() in this case.
+    /// appear when iterating. Do not forget to also override hasRegister() in this case. If the override returns
+    /// different information for registers which are stored in the map, findRegister() must be overridden as well.
     [[nodiscard]] virtual BackendRegisterInfo getBackendRegister(const RegisterPath& registerPathName) const;
 
+    /**
+     * Get a pointer to the register information stored in the catalogue, or nullptr if the register is not stored in
+     * the catalogue. In contrast to getBackendRegister(), the information is not copied and "hidden" registers are
+     * not found.
+     */
+    [[nodiscard]] const BackendRegisterInfo* findBackendRegister(const RegisterPath& registerPathName) const;
+
+    [[nodiscard]] const BackendRegisterInfoBase* findRegister(const RegisterPath& registerPathName) const override {
+      return findBackendRegister(registerPathName);
+    }
+
     [[nodiscard]] bool hasRegister(const RegisterPath& registerPathName) const override;
 
     /// Note: Implementation internally uses getBackendRegister(), so no need to override
@@ -92,6 +169,15 @@ namespace ChimeraTK {
      */
     void addRegister(const BackendRegisterInfo& registerInfo);
 
+    /**
+     * Reserve memory for the given total number of registers. This is only an optimisation for catalogues which are
+     * filled with a known (or estimated) number of registers, e.g. by a map file parser.
+     */
+    void reserve(size_t nRegisters) {
+      catalogue.reserve(nRegisters);
+      insertionOrderedCatalogue.reserve(nRegisters);
+    }
+
     /**
      * Remove register as identified by the given name from the catalogue. Throws ChimeraTK::logic_error if register
      * does not exist in the catalogue.
@@ -145,10 +231,29 @@ namespace ChimeraTK {
     void fillFromThis(BackendRegisterCatalogue<BackendRegisterInfo>* target) const;
 
    private:
-    // Always access the catalogue through the member functions. Modifications need special care to keep the two
+    /**
+     * Find the entry for the given name in the catalogue. Returns catalogue.end() if not found.
+     *
+     * RegisterPath applies an alternative separator set on either side of a comparison to both sides. The catalogue is
+     * indexed by the canonical path of the registers, so this is replicated by looking up the name with each
+     * alternative separator used by the registers in the catalogue (if the name has none), and without the
+     * alternative separator of the name (if it has one). Typically the first lookup succeeds.
+     */
+    [[nodiscard]] typename std::unordered_map<std::string, BackendRegisterInfo>::const_iterator find(
+        const RegisterPath& name) const;
+    [[nodiscard]] typename std::unordered_map<std::string, BackendRegisterInfo>::iterator find(
+        const RegisterPath& name);
+
+    // Always access the catalogue through the member functions. Modifications need special care to keep the
     // containers synchronised, hence these members are made private.
-    std::map<RegisterPath, BackendRegisterInfo> catalogue;
+    // The register information is stored in a hash map with the canonical path (see RegisterPath::getCanonicalPath())
+    // as key, so lookups do not need to compare paths. Elements of an unordered_map are never moved, so pointers to
+    // them stay valid.
+    std::unordered_map<std::string, BackendRegisterInfo> catalogue;
     std::vector<BackendRegisterInfo*> insertionOrderedCatalogue;
+
+    // Distinct alternative separators of the register names in the catalogue (usually none or just one)
+    std::vector<std::string> altSeparators;
   };
 
   /*******************************************************************************************************************/
@@ -260,19 +365,65 @@ namespace ChimeraTK {
   template<typename BackendRegisterInfo>
   BackendRegisterInfo BackendRegisterCatalogue<BackendRegisterInfo>::getBackendRegister(
       const RegisterPath& name) const {
-    try {
-      return catalogue.at(name);
-    }
-    catch(std::out_of_range&) {
+    auto it = find(name);
+    if(it == catalogue.end()) {
       throw ChimeraTK::logic_error("BackendRegisterCatalogue::getRegister(): Register '" + name + "' does not exist.");
     }
+    return it->second;
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename BackendRegisterInfo>
+  typename std::unordered_map<std::string, BackendRegisterInfo>::const_iterator BackendRegisterCatalogue<
+      BackendRegisterInfo>::find(const RegisterPath& name) const {
+    if(name.getAltSeparator().empty()) {
+      for(const auto& altSeparator : altSeparators) {
+        auto nameWithAltSeparator = name;
+        nameWithAltSeparator.setAltSeparator(altSeparator);
+        auto it = catalogue.find(nameWithAltSeparator.getCanonicalPath());
+        if(it != catalogue.end()) {
+          return it;
+        }
+      }
+      return catalogue.find(name.getCanonicalPath());
+    }
+    auto it = catalogue.find(name.getCanonicalPath());
+    if(it != catalogue.end()) {
+      return it;
+    }
+    auto nameWithoutAltSeparator = name;
+    nameWithoutAltSeparator.setAltSeparator("");
+    return catalogue.find(nameWithoutAltSeparator.getCanonicalPath());
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename BackendRegisterInfo>
+  typename std::unordered_map<std::string, BackendRegisterInfo>::iterator BackendRegisterCatalogue<
+      BackendRegisterInfo>::find(const RegisterPath& name) {
+    auto it = std::as_const(*this).find(name);
+    // convert into non-const iterator
+    return catalogue.erase(it, it);
+  }
+
+  /********************************************************************************************************************/
+
+  template<typename BackendRegisterInfo>
+  const BackendRegisterInfo* BackendRegisterCatalogue<BackendRegisterInfo>::findBackendRegister(
+      const RegisterPath& name) const {
+    auto it = find(name);
+    if(it == catalogue.end()) {
+      return nullptr;
+    }
+    return &it->second;
   }
 
   /********************************************************************************************************************/
 
   template<typename BackendRegisterInfo>
   bool BackendRegisterCatalogue<BackendRegisterInfo>::hasRegister(const RegisterPath& registerPathName) const {
-    return catalogue.find(registerPathName) != catalogue.end();
+    return find(registerPathName) != catalogue.end();
   }
 
   /********************************************************************************************************************/
@@ -327,13 +478,13 @@ namespace ChimeraTK {
   template<typename BackendRegisterInfo>
   void BackendRegisterCatalogue<BackendRegisterInfo>::fillFromThis(
       BackendRegisterCatalogue<BackendRegisterInfo>* target) const {
-    // FIXME: change this to a single loop which is just filling the new catalogue through the public API
-    for(auto& p : catalogue) {
-      target->catalogue[p.first] = getBackendRegister(p.first);
-    }
+    target->reserve(insertionOrderedCatalogue.size());
     for(auto& ptr : insertionOrderedCatalogue) {
-      target->insertionOrderedCatalogue.push_back(&target->catalogue[ptr->getRegisterName()]);
+      auto name = ptr->getRegisterName();
+      auto inserted = target->catalogue.emplace(name.getCanonicalPath(), getBackendRegister(name));
+      target->insertionOrderedCatalogue.push_back(&inserted.first->second);
     }
+    target->altSeparators = altSeparators;
   }
 
   /********************************************************************************************************************/
@@ -344,8 +495,15 @@ namespace ChimeraTK {
       throw ChimeraTK::logic_error("BackendRegisterCatalogue::addRegister(): Register with the name " +
           registerInfo.getRegisterName() + " already exists!");
     }
-    catalogue[registerInfo.getRegisterName()] = registerInfo;
-    insertionOrderedCatalogue.push_back(&catalogue[registerInfo.getRegisterName()]);
+    invalidateIndices();
+    auto name = registerInfo.getRegisterName();
+    auto inserted = catalogue.emplace(name.getCanonicalPath(), registerInfo);
+    insertionOrderedCatalogue.push_back(&inserted.first->second);
+    const auto& altSeparator = name.getAltSeparator();
+    if(!altSeparator.empty() &&
+        std::find(altSeparators.begin(), altSeparators.end(), altSeparator) == altSeparators.end()) {
+      altSeparators.push_back(altSeparator);
+    }
   }
 
   /********************************************************************************************************************/
@@ -353,31 +511,34 @@ namespace ChimeraTK {
   template<typename BackendRegisterInfo>
   void BackendRegisterCatalogue<BackendRegisterInfo>::removeRegister(const RegisterPath& name) {
     // check existence
-    if(!hasRegister(name)) {
+    auto entry = find(name);
+    if(entry == catalogue.end()) {
       throw ChimeraTK::logic_error(
           "BackendRegisterCatalogue::removeRegister(): Register '" + name + "' does not exist.");
     }
 
+    invalidateIndices();
+
     // remove from insertion-ordered vector
-    auto it = std::find_if(insertionOrderedCatalogue.begin(), insertionOrderedCatalogue.end(),
-        [&](auto reg) { return reg->getRegisterName() == name; });
+    auto it = std::find(insertionOrderedCatalogue.begin(), insertionOrderedCatalogue.end(), &entry->second);
     assert(it != insertionOrderedCatalogue.end());
     insertionOrderedCatalogue.erase(it);
 
     // remove from catalogue map
-    auto removed = catalogue.erase(name);
-    assert(removed == 1);
+    catalogue.erase(entry);
   }
 
   /********************************************************************************************************************/
 
   template<typename BackendRegisterInfo>
   void BackendRegisterCatalogue<BackendRegisterInfo>::modifyRegister(const BackendRegisterInfo& registerInfo) {
-    if(!hasRegister(registerInfo.getRegisterName())) {
+    auto entry = find(registerInfo.getRegisterName());
+    if(entry == catalogue.end()) {
       throw ChimeraTK::logic_error("BackendRegisterCatalogue::modifyRegister(): Register '" +
           registerInfo.getRegisterName() + "' cannot be modified because it does not exist!");
     }
-    catalogue[registerInfo.getRegisterName()] = registerInfo;
+    invalidateIndices();
+    entry->second = registerInfo;
     // We don't have to touch the insertionOrderedCatalogue because is stores references, and this has not changed.
   }
 
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace ChimeraTK {
+
+  /**
+   * Process-wide thread which calls functions at given deadlines. The future_queue has no timed wait, so the read
+   * functions with a deadline (e.g. TransferElement::readUntil()) wait without timeout and schedule a function here
+   * which wakes them up when the deadline is reached (see TransferElement::wakeUpRead()).
+   *
+   * The functions are called from the timer thread, one after the other, so they must return quickly. They must not
+   * throw.
+   */
+  class DeadlineTimer {
+   public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /** Handle of a scheduled function. Destroying the handle cancels the call, unless it has already been made. */
+    class Handle {
+     public:
+      Handle() = default;
+      Handle(Handle&& other) noexcept;
+      Handle& operator=(Handle&& other) noexcept;
+      Handle(const Handle&) = delete;
+      Handle& operator=(const Handle&) = delete;
+      ~Handle() { cancel(); }
+
+      /** Cancel the call. Does nothing if it has already been made or cancelled. Does not wait for a call which is
+       *  currently running. */
+      void cancel();
+
+     protected:
+      friend class DeadlineTimer;
+      Handle(DeadlineTimer* timer, uint64_t id) : _timer(timer), _id(id) {}
+
+      DeadlineTimer* _timer{nullptr};
+      uint64_t _id{0};
+    };
+
+    /** Return the process-wide instance. */
+    static DeadlineTimer& getInstance();
+
+    /** Stops the thread. Functions which have not been called yet are dropped. */
+    ~DeadlineTimer();
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    /** Call the given function from the timer thread once the deadline has been reached. */
+    [[nodiscard]] Handle schedule(TimePoint deadline, std::function<void()> function);
+
+   protected:
+    DeadlineTimer() = default;
+
+    void cancel(uint64_t id);
+
+    void run();
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+
+    /// Scheduled functions, ordered by deadline. The ID makes the key unique. Protected by _mutex.
+    std::map<std::pair<TimePoint, uint64_t>, std::function<void()>> _scheduled;
+
+    /// Deadline of each scheduled function by ID, to find it again in cancel(). Protected by _mutex.
+    std::unordered_map<uint64_t, TimePoint> _deadlines;
+
+    uint64_t _nextId{1};
+    bool _stop{false};
+
+    /// Started with the first call to schedule(). Protected by _mutex.
+    std::thread _thread;
+  };
+
+} // namespace ChimeraTK
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "AccessMode.h"
+#include "AsyncTransferPool.h"
 #include "Exception.h"
 #include "ForwardDeclarations.h"
 #include "MetadataCatalogue.h"
@@ -11,6 +12,7 @@
 
 #include <boost/enable_shared_from_this.hpp>
 
+#include <exception>
 #include <string>
 
 namespace ChimeraTK {
@@ -96,6 +98,20 @@ namespace ChimeraTK {
      * the appropriate ChimeraTK::runtime_error is thrown by this function.
      */
     virtual void checkActiveException() = 0;
+
+    /**
+     * Return the ChimeraTK::runtime_error which would be thrown by checkActiveException(), without throwing it. Returns
+     * nullptr if the backend is not in an exception state. Used by the non-throwing transfer functions like
+     * TransferElement::tryRead() to fail fast while the device is unavailable. The default implementation always returns
+     * nullptr, hence the transfers are attempted.
+     */
+    virtual std::exception_ptr getActiveException() noexcept { return nullptr; }
+
+    /**
+     *  Return the pool of worker threads which executes the asynchronous transfers of the accessors of this backend
+     *  (see TransferElement::readAsyncTransfer()). The default implementation returns AsyncTransferPool::getDefault().
+     */
+    virtual AsyncTransferPool& getAsyncTransferPool() { return AsyncTransferPool::getDefault(); }
   };
 
   /********************************************************************************************************************/
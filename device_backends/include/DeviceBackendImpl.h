@@ -5,9 +5,15 @@
 #include "DeviceBackend.h"
 #include "Exception.h"
 
+#include <boost/weak_ptr.hpp>
+
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
 
 namespace ChimeraTK {
 
@@ -45,8 +51,52 @@ namespace ChimeraTK {
 
     bool isFunctional() const noexcept final;
 
+    std::exception_ptr getActiveException() noexcept final;
+
     std::string getActiveExceptionMessage() noexcept;
 
+    /** Return the pool of the backend, which is created with the first call. */
+    AsyncTransferPool& getAsyncTransferPool() override;
+
+    /**
+     * Remember that asynchronous read has been activated, so the reconnect supervisor can activate it again after
+     * reopening the backend. Backends overriding this function must call it.
+     */
+    void activateAsyncRead() noexcept override;
+
+    /**
+     * Enable the reconnect supervisor. After setException(), a background thread tries to open() the backend again,
+     * first after initialDelay. The delay is doubled after each failed attempt, up to maxDelay. If asynchronous read had
+     * been activated before the exception, activateAsyncRead() is called after the successful open(), so the push-type
+     * accessors receive their initial values again.
+     *
+     * The application can observe the state with isFunctional() and isReconnecting(), and wait for the recovery with
+     * waitUntilFunctional() instead of calling open() in a loop. It should not call open() itself for recovery while
+     * the supervisor is enabled. Calling close() stops the retries.
+     *
+     * If open() throws a logic_error, retrying cannot help and the supervisor gives up. The backend stays in the
+     * exception state, and its active exception (see getActiveExceptionMessage()) reports the logic error.
+     *
+     * The backend must be owned by a boost::shared_ptr, which is the case for all backends created by the
+     * BackendFactory. Calling this function again only changes the delays.
+     */
+    void enableReconnect(std::chrono::milliseconds initialDelay = std::chrono::milliseconds(100),
+        std::chrono::milliseconds maxDelay = std::chrono::seconds(10));
+
+    /** Return whether the reconnect supervisor is currently trying to open the backend again. */
+    bool isReconnecting();
+
+    /**
+     * Wait until the backend is functional (see isFunctional()), at most for the given timeout. Returns whether the
+     * backend is functional. The waiting threads are woken by each successful open(), whether it is done by the
+     * reconnect supervisor or not. If the reconnect supervisor gives up (see enableReconnect()), false is returned
+     * without waiting for the timeout.
+     */
+    bool waitUntilFunctional(std::chrono::steady_clock::duration timeout);
+
+    /** Stops the reconnect supervisor. */
+    ~DeviceBackendImpl() override;
+
    protected:
     /** Backends should call this function at the end of a (successful) open() call.*/
     void setOpenedAndClearException() noexcept;
@@ -64,8 +114,51 @@ namespace ChimeraTK {
      */
     std::string _activeExceptionMessage;
 
-    /** mutex to protect access to _activeExceptionMessage */
+    /**
+     *  exception matching _activeExceptionMessage, created once in setException() so getActiveException() does not
+     *  need to create it on each call. Access is protected by _mx_activeExceptionMessage
+     */
+    std::exception_ptr _activeException;
+
+    /** mutex to protect access to _activeExceptionMessage and _activeException */
     std::mutex _mx_activeExceptionMessage;
+
+    /** pool for the asynchronous transfers, created on first use */
+    std::unique_ptr<AsyncTransferPool> _asyncTransferPool;
+
+    /** flag to create the _asyncTransferPool only once */
+    std::once_flag _asyncTransferPoolCreated;
+
+    /** flag if activateAsyncRead() has been called since the last successful open() */
+    std::atomic<bool> _asyncReadActivated{false};
+
+    /** State of the reconnect supervisor, shared with its thread. The thread might destroy the backend itself by
+     *  releasing the last reference to it, so the state has to outlive the backend. */
+    struct ReconnectState {
+      std::mutex mutex;
+      /// wakes the supervisor thread
+      std::condition_variable condition;
+      /// wakes the threads in waitUntilFunctional()
+      std::condition_variable functionalCondition;
+      bool requested{false};
+      bool reconnecting{false};
+      /// the last reconnect attempt failed with a logic_error, reset by setException()
+      bool gaveUp{false};
+      bool stop{false};
+      std::chrono::milliseconds initialDelay{0};
+      std::chrono::milliseconds maxDelay{0};
+    };
+    std::shared_ptr<ReconnectState> _reconnectState{std::make_shared<ReconnectState>()};
+
+    /** Thread of the reconnect supervisor, started by enableReconnect(). Protected by _reconnectState->mutex */
+    std::thread _reconnectThread;
+
+    /** Main loop of the reconnect supervisor thread */
+    static void runReconnect(
+        const std::shared_ptr<ReconnectState>& state, const boost::weak_ptr<DeviceBackend>& weakBackend);
+
+    /** Single reconnect attempt. Returns false if it should be retried. */
+    bool attemptReconnect();
   };
 
   /********************************************************************************************************************/
@@ -89,4 +182,13 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  // This function is called for each failing TransferElement::tryRead() and hence implemented as inline in the header.
+  inline std::exception_ptr DeviceBackendImpl::getActiveException() noexcept {
+    if(!_hasActiveException) return nullptr;
+    std::lock_guard<std::mutex> lk(_mx_activeExceptionMessage);
+    return _activeException;
+  }
+
+  /********************************************************************************************************************/
+
 } // namespace ChimeraTK
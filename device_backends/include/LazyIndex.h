@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <memory>
+#include <mutex>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  /**
+   * Holder for an index over the content of a register catalogue (e.g. RegisterPathTree), which is built on first use.
+   * Building is thread safe, so catalogues which are shared between threads can build their indices lazily. Moving
+   * the holder does not move the index, it is built again when needed.
+   */
+  template<typename INDEX>
+  class LazyIndex {
+   public:
+    LazyIndex() = default;
+    LazyIndex(LazyIndex&&) noexcept {}
+    LazyIndex& operator=(LazyIndex&&) noexcept {
+      reset();
+      return *this;
+    }
+
+    /**
+     * Return the index. If not yet built, the index is constructed from the value returned by the given function,
+     * e.g. the list of registers to index.
+     */
+    template<typename GET_CONTENT>
+    const INDEX& get(GET_CONTENT getContent) const {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if(!_index) {
+        _index = std::make_unique<INDEX>(getContent());
+      }
+      return *_index;
+    }
+
+    /** Discard the index, e.g. because the catalogue has been modified. */
+    void reset() noexcept {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _index.reset();
+    }
+
+   private:
+    mutable std::mutex _mutex;
+    mutable std::unique_ptr<INDEX> _index;
+  };
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
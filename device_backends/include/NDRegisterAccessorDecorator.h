@@ -179,6 +179,12 @@ namespace ChimeraTK {
 
     void interrupt() override { _target->interrupt(); }
 
+    void wakeUpRead() override { _target->wakeUpRead(); }
+
+    void setReadNotificationListener(std::function<void()> listener) override {
+      _target->setReadNotificationListener(std::move(listener));
+    }
+
    protected:
     using ChimeraTK::NDRegisterAccessor<UserType>::buffer_2D;
 
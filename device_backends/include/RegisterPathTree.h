@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "BackendRegisterInfoBase.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  /**
+   * Prefix tree over the names of the registers in a catalogue, organised by path components. It answers hierarchical
+   * queries (all registers in a module, the direct children of a module, glob patterns) in time proportional to the
+   * size of the result, instead of scanning the entire catalogue.
+   *
+   * Register names are split into components at the standard separator "/" and at their alternative separator (if
+   * set). Query paths are split the same way. If a query path has no alternative separator set, the alternative
+   * separator of the registers is used for it, like when comparing RegisterPath objects.
+   *
+   * The tree only stores pointers to the register information, so it must not outlive the catalogue and must be
+   * rebuilt when the catalogue is modified.
+   */
+  class RegisterPathTree {
+   public:
+    /** Build the tree from the given registers. */
+    explicit RegisterPathTree(const std::vector<const BackendRegisterInfoBase*>& registers);
+
+    /**
+     * Return all registers in the given module, including all submodules. If the module name itself is the name of a
+     * register, that register is included as well. Registers are sorted by module (depth first), and in the order of
+     * the catalogue within a module. Returns an empty list if no such module exists.
+     */
+    [[nodiscard]] std::vector<const BackendRegisterInfoBase*> getRegistersInModule(
+        const RegisterPath& moduleName) const;
+
+    /**
+     * Return the names of the direct children (registers and submodules) of the given module, in the order of their
+     * first appearance in the catalogue. Returns an empty list if no such module exists.
+     */
+    [[nodiscard]] std::vector<std::string> getChildNames(const RegisterPath& moduleName) const;
+
+    /**
+     * Return all registers matching the given glob pattern. The pattern is matched component by component: "*"
+     * matches any number of characters and "?" matches a single character within a component, while a component
+     * "**" matches any number of components (including none). Registers are sorted like in getRegistersInModule().
+     */
+    [[nodiscard]] std::vector<const BackendRegisterInfoBase*> getRegistersMatching(const std::string& pattern) const;
+
+    /** Check whether a name component matches a glob pattern component with the wildcards "*" and "?". */
+    [[nodiscard]] static bool matchComponent(const std::string& pattern, const std::string& name);
+
+   private:
+    struct Node {
+      std::string name;
+      std::unordered_map<std::string, size_t> children; // name to index in _nodes
+      std::vector<size_t> childrenInOrder;
+      std::vector<const BackendRegisterInfoBase*> registers; // registers with exactly this path (usually one or none)
+      // range of all registers in this subtree inside _registersDepthFirst
+      size_t subtreeBegin{0}, subtreeEnd{0};
+    };
+
+    /** Split the path into components, see class description. */
+    [[nodiscard]] std::vector<std::string> split(RegisterPath path) const;
+
+    /** Find the node for the given path. Returns nullptr if not found. */
+    [[nodiscard]] const Node* findNode(const RegisterPath& path) const;
+
+    /** Recursive helper for getRegistersMatching(). */
+    void match(const Node& node, const std::vector<std::string>& pattern, size_t component,
+        std::vector<const BackendRegisterInfoBase*>& result) const;
+
+    std::vector<Node> _nodes; // _nodes[0] is the root
+    std::vector<const BackendRegisterInfoBase*> _registersDepthFirst;
+    std::string _altSeparator; // alternative separator of the registers (first one found)
+  };
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace ChimeraTK {
+
+  /** The TimerInterruptSource periodically calls a function from its own thread. The NumericAddressedBackend uses it
+   *  to trigger virtual interrupts for registers which have no hardware interrupt, so push-type accessors can be used
+   *  for polled registers (see "@TIMER_INTERRUPT" in NumericAddressedBackend). The PollScheduler uses it to generate
+   *  its ticks for any backend.
+   *
+   *  The period is measured on a steady clock. If the function takes longer than the period, the missed periods are
+   *  skipped instead of being triggered in a burst afterwards. The clock can be replaced, e.g. by a SimulatedClock in
+   *  tests.
+   */
+  class TimerInterruptSource {
+   public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+
+    /** Clock used by the TimerInterruptSource to measure the period and to wait. */
+    class Clock {
+     public:
+      virtual ~Clock() = default;
+
+      /** Return the current time. */
+      virtual TimePoint now() = 0;
+
+      /** Wait until the given time has been reached or wakeUp() has been called. A call to wakeUp() before the call to
+       *  waitUntil() is not lost. */
+      virtual void waitUntil(TimePoint deadline) = 0;
+
+      /** Wake up a thread waiting in waitUntil(). */
+      virtual void wakeUp() = 0;
+    };
+
+    /** Clock implementation based on std::chrono::steady_clock. This is the default. */
+    class SteadyClock : public Clock {
+     public:
+      TimePoint now() override { return std::chrono::steady_clock::now(); }
+      void waitUntil(TimePoint deadline) override;
+      void wakeUp() override;
+
+     protected:
+      std::mutex _mutex;
+      std::condition_variable _condition;
+      bool _wokenUp{false};
+    };
+
+    /** Clock implementation for tests. The time only advances when advance() is called. */
+    class SimulatedClock : public Clock {
+     public:
+      TimePoint now() override;
+      void waitUntil(TimePoint deadline) override;
+      void wakeUp() override;
+
+      /** Advance the time by the given duration, waking up a thread waiting for a deadline which has been reached. */
+      void advance(Duration duration);
+
+      /** Return whether a thread is currently waiting in waitUntil(). */
+      [[nodiscard]] bool hasWaitingThread();
+
+     protected:
+      std::mutex _mutex;
+      std::condition_variable _condition;
+      TimePoint _now{};
+      bool _wokenUp{false};
+      size_t _nWaiting{0};
+    };
+
+    /** Create a timer calling the given function with the given period. The timer is not started yet. */
+    TimerInterruptSource(Duration period, std::function<void()> function,
+        std::shared_ptr<Clock> clock = std::make_shared<SteadyClock>());
+
+    /** Stops the timer. */
+    ~TimerInterruptSource();
+
+    /** Start the thread. The function is called for the first time one period after this call. Does nothing if the
+     *  timer is already running. */
+    void start();
+
+    /** Stop the thread and wait until it has terminated. Does nothing if the timer is not running. Must not be called
+     *  from the function. */
+    void stop();
+
+    /** Return whether the thread is running. */
+    [[nodiscard]] bool isRunning() const { return _thread.joinable(); }
+
+    /** Return the period. */
+    [[nodiscard]] Duration getPeriod() const { return _period; }
+
+    /** Replace the clock, e.g. by a SimulatedClock in tests. Throws ChimeraTK::logic_error if the timer is running. */
+    void setClock(std::shared_ptr<Clock> clock);
+
+    /** Return the number of periods which have been skipped because the function took too long. */
+    [[nodiscard]] size_t getNumberOfSkippedPeriods() const { return _nSkippedPeriods; }
+
+   protected:
+    void run();
+
+    Duration _period;
+    std::function<void()> _function;
+    std::shared_ptr<Clock> _clock;
+    std::thread _thread;
+    std::atomic<bool> _stop{false};
+    std::atomic<size_t> _nSkippedPeriods{0};
+  };
+
+} // namespace ChimeraTK
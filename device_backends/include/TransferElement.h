@@ -3,9 +3,11 @@
 #pragma once
 
 #include "AccessMode.h"
+#include "DeadlineTimer.h"
 #include "DeviceBackend.h"
 #include "Exception.h"
 #include "TransferElementID.h"
+#include "TransferResult.h"
 #include "VersionNumber.h"
 
 #include <ChimeraTK/cppext/future_queue.hpp>
@@ -16,10 +18,14 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 #include <boost/thread/future.hpp>
+#include <boost/weak_ptr.hpp>
 
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <typeinfo>
 #include <utility>
@@ -59,6 +65,40 @@ namespace ChimeraTK {
      */
     class DiscardValueException {};
 
+    /**
+     * Holds the listener of TransferElement::setReadNotificationListener() for the implementations which support it.
+     * The sending code calls notify() after it has placed an update on the queue.
+     */
+    class ReadNotifier {
+     public:
+      /** Set the listener. An empty function removes it. */
+      void set(std::function<void()> listener) {
+        std::shared_ptr<const std::function<void()>> newListener;
+        if(listener) {
+          newListener = std::make_shared<const std::function<void()>>(std::move(listener));
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::swap(_listener, newListener);
+      }
+
+      /** Call the listener, if set. It is called without holding the lock, so it may call set() itself. As a
+       *  consequence, a listener may still be called shortly after it has been removed. */
+      void notify() {
+        std::shared_ptr<const std::function<void()>> listener;
+        {
+          std::lock_guard<std::mutex> lock(_mutex);
+          listener = _listener;
+        }
+        if(listener) {
+          (*listener)();
+        }
+      }
+
+     private:
+      std::mutex _mutex;
+      std::shared_ptr<const std::function<void()>> _listener;
+    };
+
   } /* namespace detail */
 
   /*******************************************************************************************************************/
@@ -170,6 +210,42 @@ namespace ChimeraTK {
       return retVal;
     }
 
+    /**
+     *  Read the next value like read(), but wait at most until the given deadline. Returns true if a value has been
+     *  read, and false if the deadline has passed without new data. No exception is thrown in that case.
+     *
+     *  If AccessMode::wait_for_new_data is not set, this function is identical to read() and always returns true.
+     */
+    bool readUntil(std::chrono::steady_clock::time_point deadline) {
+      if(!_accessModeFlags.has(AccessMode::wait_for_new_data)) {
+        read();
+        return true;
+      }
+      if(TransferElement::_isInTransferGroup) {
+        throw ChimeraTK::logic_error("Calling read() or write() on the TransferElement '" + _name +
+            "' which is part of a TransferGroup is not allowed.");
+      }
+      this->readTransactionInProgress = false;
+      preReadAndHandleExceptions(TransferType::read);
+      bool updateDataBuffer = false;
+      if(!_activeException) {
+        handleTransferException([&] { updateDataBuffer = readTransferAsyncWaitingUntilImpl(deadline); });
+      }
+
+      bool retVal = updateDataBuffer;
+      if(_activeException) {
+        // same as in readNonBlocking(): the return value depends on the meta data if the exception is suppressed
+        auto previousVersionNumber = _versionNumber;
+        auto previousDataValidity = _dataValidity;
+        postReadAndHandleExceptions(TransferType::read, false);
+        retVal = (previousVersionNumber != _versionNumber) || (previousDataValidity != _dataValidity);
+      }
+      else {
+        postReadAndHandleExceptions(TransferType::read, updateDataBuffer);
+      }
+      return retVal;
+    }
+
     /** Read the latest value, discarding any other update since the last read if
      * present. Otherwise this function is identical to readNonBlocking(), i.e. it
      * will never wait for new values and it will return whether a new value was
@@ -233,6 +309,166 @@ namespace ChimeraTK {
       return previousDataLost;
     }
 
+    /**
+     *  Like read(), but return runtime errors and interruptions as TransferResult instead of throwing them.
+     *  ChimeraTK::logic_error is still thrown.
+     *
+     *  While the backend is in an exception state, the error is returned right away without attempting the transfer,
+     *  so no exception is thrown at all. This avoids unwinding through the decorator chain on every read while a device
+     *  is unavailable. Elements with AccessMode::wait_for_new_data always wait on their read queue, since runtime errors
+     *  are delivered through it.
+     */
+    TransferResult<> tryRead() {
+      if(TransferElement::_isInTransferGroup) {
+        throw ChimeraTK::logic_error("Calling read() or write() on the TransferElement '" + _name +
+            "' which is part of a TransferGroup is not allowed.");
+      }
+      if(!_accessModeFlags.has(AccessMode::wait_for_new_data) && isReadable()) {
+        auto exception = getKnownBackendException();
+        if(exception) {
+          return {TransferStatus::runtimeError, exception};
+        }
+      }
+      this->readTransactionInProgress = false;
+
+      preReadAndHandleExceptions(TransferType::read);
+      if(!_activeException) {
+        handleTransferException([&] { readTransfer(); });
+      }
+
+      return returnTransferException([&] { postRead(TransferType::read, !_activeException); });
+    }
+
+    /**
+     *  Like write(), but return runtime errors and interruptions as TransferResult instead of throwing them. The value
+     *  of a successful result is the return value of write(). ChimeraTK::logic_error is still thrown.
+     *
+     *  While the backend is in an exception state, the error is returned right away without attempting the transfer,
+     *  see tryRead().
+     */
+    TransferResult<bool> tryWrite(ChimeraTK::VersionNumber versionNumber = {}) {
+      if(TransferElement::_isInTransferGroup) {
+        throw ChimeraTK::logic_error("Calling read() or write() on the TransferElement '" + _name +
+            "' which is part of a TransferGroup is not allowed.");
+      }
+      // an outdated version number is a logic error, which must not be hidden by the known runtime error
+      if(isWriteable() && versionNumber >= getVersionNumber()) {
+        auto exception = getKnownBackendException();
+        if(exception) {
+          return {TransferStatus::runtimeError, exception};
+        }
+      }
+      this->writeTransactionInProgress = false;
+      bool previousDataLost = true; // the value here does not matter, it is not returned in case of an exception
+
+      preWriteAndHandleExceptions(TransferType::write, versionNumber);
+      if(!_activeException) {
+        handleTransferException([&] { previousDataLost = writeTransfer(versionNumber); });
+      }
+
+      auto result = returnTransferException([&] { postWrite(TransferType::write, versionNumber); });
+      if(!result) {
+        return TransferResult<bool>(result);
+      }
+      return previousDataLost;
+    }
+
+    /**
+     *  Start a read() in a worker thread of the backend's AsyncTransferPool and return immediately. The returned queue
+     *  receives a single entry when the read is complete. pop_wait() on it rethrows exceptions thrown by read(). Many
+     *  transfers can be in flight at the same time without one thread per transfer, and their completion can be
+     *  awaited with cppext::when_any() or one by one.
+     *
+     *  The TransferElement, including its user buffer, must not be used until the read is complete.
+     *
+     *  AccessMode::wait_for_new_data is not supported, since those elements are already notified through their read
+     *  queue (see ReadAnyGroup). A ChimeraTK::logic_error is thrown in that case.
+     */
+    cppext::future_queue<void> readAsyncTransfer() {
+      cppext::future_queue<void> done(1);
+      readAsyncTransfer([done](const std::exception_ptr& exception) mutable {
+        if(exception) {
+          done.push_exception(exception);
+        }
+        else {
+          done.push();
+        }
+      });
+      return done;
+    }
+
+    /**
+     *  Like readAsyncTransfer(), but call the given function from the worker thread when the read is complete, instead
+     *  of returning a queue. The function receives the exception thrown by read(), or nullptr. It must not throw.
+     */
+    void readAsyncTransfer(std::function<void(std::exception_ptr)> onCompletion) {
+      if(_accessModeFlags.has(AccessMode::wait_for_new_data)) {
+        throw ChimeraTK::logic_error("readAsyncTransfer() is not supported for the TransferElement '" + _name +
+            "' with AccessMode::wait_for_new_data.");
+      }
+      if(TransferElement::_isInTransferGroup) {
+        throw ChimeraTK::logic_error("Calling read() or write() on the TransferElement '" + _name +
+            "' which is part of a TransferGroup is not allowed.");
+      }
+      getAsyncTransferPool().submit([self = shared_from_this(), onCompletion = std::move(onCompletion)] {
+        std::exception_ptr exception;
+        try {
+          self->read();
+        }
+        catch(...) {
+          exception = std::current_exception();
+        }
+        onCompletion(exception);
+      });
+    }
+
+    /**
+     *  Start a write() in a worker thread of the backend's AsyncTransferPool and return immediately. The returned queue
+     *  receives the return value of write() when the write is complete. pop_wait() on it rethrows exceptions thrown by
+     *  write().
+     *
+     *  The TransferElement, including its user buffer, must not be used until the write is complete.
+     */
+    cppext::future_queue<bool> writeAsyncTransfer(ChimeraTK::VersionNumber versionNumber = {}) {
+      cppext::future_queue<bool> done(1);
+      writeAsyncTransfer(
+          [done](bool previousDataLost, const std::exception_ptr& exception) mutable {
+            if(exception) {
+              done.push_exception(exception);
+            }
+            else {
+              done.push(previousDataLost);
+            }
+          },
+          versionNumber);
+      return done;
+    }
+
+    /**
+     *  Like writeAsyncTransfer(), but call the given function from the worker thread when the write is complete,
+     *  instead of returning a queue. The function receives the return value of write() and the exception thrown by
+     *  write(), or nullptr. It must not throw.
+     */
+    void writeAsyncTransfer(std::function<void(bool, std::exception_ptr)> onCompletion,
+        ChimeraTK::VersionNumber versionNumber = {}) {
+      if(TransferElement::_isInTransferGroup) {
+        throw ChimeraTK::logic_error("Calling read() or write() on the TransferElement '" + _name +
+            "' which is part of a TransferGroup is not allowed.");
+      }
+      getAsyncTransferPool().submit(
+          [self = shared_from_this(), versionNumber, onCompletion = std::move(onCompletion)] {
+            bool previousDataLost = false;
+            std::exception_ptr exception;
+            try {
+              previousDataLost = self->write(versionNumber);
+            }
+            catch(...) {
+              exception = std::current_exception();
+            }
+            onCompletion(previousDataLost, exception);
+          });
+    }
+
     /**
      *  Returns the version number that is associated with the last transfer (i.e.
      * last read or write). See ChimeraTK::VersionNumber for details. The
@@ -297,6 +533,15 @@ namespace ChimeraTK {
      */
     cppext::future_queue<void> getReadQueue() { return _readQueue; }
 
+    /** Return the pool used for the asynchronous transfers of this element. This is the pool of the exception backend,
+     *  or the default pool if the element has no backend. */
+    AsyncTransferPool& getAsyncTransferPool() {
+      if(_exceptionBackend) {
+        return _exceptionBackend->getAsyncTransferPool();
+      }
+      return AsyncTransferPool::getDefault();
+    }
+
    protected:
     /** The backend to which the runtime_errors are reported via DeviceBackend::setException().
      *  Creating backends set it in DeviceBackend::getRegisterAccessor(). Decorators have to set it in the constructor
@@ -321,6 +566,36 @@ namespace ChimeraTK {
       }
     }
 
+    /**
+     *  Helper for the non-throwing transfer functions: execute the post action (postRead() or postWrite()) and return
+     *  the rethrown active exception as TransferResult. Like in read() and write(), runtime errors are reported to the
+     *  backend.
+     */
+    template<typename Callable>
+    TransferResult<> returnTransferException(Callable postAction) {
+      try {
+        postAction();
+      }
+      catch(ChimeraTK::runtime_error& ex) {
+        if(_exceptionBackend) {
+          _exceptionBackend->setException(ex.what());
+        }
+        return {TransferStatus::runtimeError, std::current_exception()};
+      }
+      catch(boost::thread_interrupted&) {
+        return {TransferStatus::interrupted, std::current_exception()};
+      }
+      return {};
+    }
+
+    /** Return the active exception of the backend, if it is open and in an exception state. Otherwise nullptr. */
+    std::exception_ptr getKnownBackendException() {
+      if(!_exceptionBackend || !_exceptionBackend->isOpen()) {
+        return nullptr;
+      }
+      return _exceptionBackend->getActiveException();
+    }
+
     // helper function that just gets rid of the DiscardValueException and otherwise does a pop_wait on the _readQueue.
     // It does not deal with other exceptions. This is done in handleTransferException.
     void readTransferAsyncWaitingImpl() {
@@ -333,6 +608,28 @@ namespace ChimeraTK {
       }
     }
 
+    // helper function like readTransferAsyncWaitingImpl(), but waiting at most until the given deadline. Returns false
+    // if no data has arrived until then. The future_queue has no timed wait, hence the DeadlineTimer calls wakeUpRead()
+    // at the deadline, which places a DiscardValueException on the queue. Such an exception from an earlier call, which
+    // arrives before the deadline, is just discarded.
+    bool readTransferAsyncWaitingUntilImpl(std::chrono::steady_clock::time_point deadline) {
+      if(std::chrono::steady_clock::now() >= deadline) {
+        return readTransferAsyncNonWaitingImpl();
+      }
+      auto wakeUp = DeadlineTimer::getInstance().schedule(deadline, wakeUpReadFunction(shared_from_this()));
+      while(true) {
+        try {
+          _readQueue.pop_wait();
+          return true;
+        }
+        catch(detail::DiscardValueException&) {
+          if(std::chrono::steady_clock::now() >= deadline) {
+            return false;
+          }
+        }
+      }
+    }
+
    public:
     /**
      *  Read the data from the device but do not fill it into the user buffer of this TransferElement. This function
@@ -794,6 +1091,83 @@ namespace ChimeraTK {
       dataTransportQueue.push_overwrite_exception(std::make_exception_ptr(boost::thread_interrupted()));
     }
 
+    /**
+     * Wake up a read waiting for new data without delivering a value. A detail::DiscardValueException is placed on the
+     * _readQueue, which is discarded by all read functions. Unlike interrupt(), no data is overwritten: If the queue is
+     * full, nothing is placed on it, since a waiting read receives data anyway. This is used to implement the read
+     * functions with a deadline (see readUntil()).
+     *
+     * This function can only be used for TransferElements with AccessMode::wait_for_new_data. Otherwise it
+     * will throw a ChimeraTK::logic_error.
+     *
+     * Implementation notice: Like interrupt(), each TransferElement implementation that supports
+     * AccessMode::wait_for_new_data has to override it, like this:
+     *   void wakeUpRead() override { this->wakeUpRead_impl(this->_myDataTransportQueue); }
+     */
+    virtual void wakeUpRead() {
+      if(!this->_accessModeFlags.has(AccessMode::wait_for_new_data)) {
+        throw ChimeraTK::logic_error(
+            "TransferElement::wakeUpRead() called on '" + _name + "' but AccessMode::wait_for_new_data is not set.");
+      }
+      throw ChimeraTK::logic_error("TransferElement::wakeUpRead() must be overridden by all implementations with "
+                                   "AccessMode::wait_for_new_data. (TransferElement '" +
+          _name + "')");
+    }
+
+    /** Implementation of wakeUpRead() for TransferElements which support AccessMode::wait_for_new_data */
+    template<typename QUEUE_TYPE>
+    void wakeUpRead_impl(QUEUE_TYPE& dataTransportQueue) {
+      if(!this->_accessModeFlags.has(AccessMode::wait_for_new_data)) {
+        throw ChimeraTK::logic_error(
+            "TransferElement::wakeUpRead() called on '" + _name + "' but AccessMode::wait_for_new_data is not set.");
+      }
+
+      dataTransportQueue.push_exception(std::make_exception_ptr(detail::DiscardValueException()));
+    }
+
+    /**
+     * Return a function for the DeadlineTimer which calls wakeUpRead() on the given element, if it still exists. The
+     * function does not keep the element alive.
+     */
+    static std::function<void()> wakeUpReadFunction(const boost::shared_ptr<TransferElement>& element) {
+      return [weakElement = boost::weak_ptr<TransferElement>(element)] {
+        auto element = weakElement.lock();
+        if(!element) {
+          return;
+        }
+        try {
+          element->wakeUpRead();
+        }
+        catch(ChimeraTK::logic_error&) {
+          // Not supported by the implementation. The read then waits for the next value without deadline.
+        }
+      };
+    }
+
+    /**
+     * Set a function which is called each time after an update (new data or an exception) has been placed on the
+     * _readQueue. It is called from the thread which delivers the update, e.g. the interrupt dispatcher thread of the
+     * backend, after the backend has released its locks. This allows to react on updates without blocking a thread in
+     * read() (see CoroutineAwaitables.h). Only one listener can be set, an empty function removes it.
+     *
+     * The listener must not throw. It can be called spuriously, and it may still be called shortly after it has been
+     * removed. It delays the delivery of further updates, so it should return quickly.
+     *
+     * This function can only be used for TransferElements with AccessMode::wait_for_new_data. Otherwise, and if the
+     * implementation does not support the listener, it will throw a ChimeraTK::logic_error.
+     *
+     * Implementation notice: Implementations which support the listener override this function, hold a
+     * detail::ReadNotifier and call its notify() when sending. Decorators pass the listener on to their target.
+     */
+    virtual void setReadNotificationListener([[maybe_unused]] std::function<void()> listener) {
+      if(!this->_accessModeFlags.has(AccessMode::wait_for_new_data)) {
+        throw ChimeraTK::logic_error("TransferElement::setReadNotificationListener() called on '" + _name +
+            "' but AccessMode::wait_for_new_data is not set.");
+      }
+      throw ChimeraTK::logic_error(
+          "TransferElement::setReadNotificationListener() is not supported by '" + _name + "'.");
+    }
+
     /** Check whether a read transaction is in progress, i.e. preRead() has been called but not yet postRead(). */
     bool isReadTransactionInProgress() const { return readTransactionInProgress; }
 
@@ -10,15 +10,30 @@ namespace ChimeraTK {
     std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
     // The destructor of the AsyncVariable implementation must do all necessary clean-up
     _asyncVariables.erase(id);
+    updateAsyncVariableList();
     asyncVariableMapChanged();
   }
 
+  //*********************************************************************************************************************/
+  void AsyncAccessorManager::updateAsyncVariableList() {
+    auto newList = std::make_shared<AsyncVariableList>();
+    newList->reserve(_asyncVariables.size());
+    for(auto& var : _asyncVariables) {
+      newList->push_back(var.second);
+    }
+    _asyncVariableList = std::move(newList);
+  }
+
+
   //*********************************************************************************************************************/
   void AsyncAccessorManager::sendException(const std::exception_ptr& e) {
     std::lock_guard<std::recursive_mutex> variablesLock(_variablesMutex);
     _isActive = false;
-    for(auto& var : _asyncVariables) {
-      var.second->sendException(e);
+    // Iterate the immutable list: The read notification listeners are called in sendException(), and they might
+    // unsubscribe accessors in this thread (the mutex is recursive).
+    auto asyncVariables = _asyncVariableList;
+    for(const auto& var : *asyncVariables) {
+      var->sendException(e);
     }
   }
 
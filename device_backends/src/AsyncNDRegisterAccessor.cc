@@ -15,14 +15,15 @@ namespace ChimeraTK {
   template<typename UserType>
   AsyncNDRegisterAccessor<UserType>::AsyncNDRegisterAccessor(boost::shared_ptr<DeviceBackend> backend,
       boost::shared_ptr<AsyncAccessorManager> manager, std::string const& name, size_t nChannels, size_t nElements,
-      AccessModeFlags accessModeFlags, std::string const& unit, std::string const& description)
+      AccessModeFlags accessModeFlags, std::string const& unit, std::string const& description, size_t queueSize)
 
-  : NDRegisterAccessor<UserType>(name, accessModeFlags, unit, description), _backend(std::move(backend)),
-    _accessorManager(std::move(manager)), _receiveBuffer(nChannels, nElements) {
+  : NDRegisterAccessor<UserType>(name, accessModeFlags, unit, description), AsyncQueueStatistics(queueSize),
+    _backend(std::move(backend)), _accessorManager(std::move(manager)), _receiveBuffer(nChannels, nElements) {
     // Don't throw a ChimeraTK::logic_error here. They are for mistakes an application is doing when using DeviceAccess.
     // If an AsyncNDRegisterAccessor is created without wait_for_new_data it is a mistake in the backend, which is not
     // part of the application.
     assert(accessModeFlags.has(AccessMode::wait_for_new_data));
+    assert(_queueSize > 0);
     buffer_2D.resize(nChannels);
     for(auto& chan : buffer_2D) chan.resize(nElements);
 
@@ -59,5 +60,17 @@ namespace ChimeraTK {
     }
   }
 
+  /**********************************************************************************************************/
+  boost::shared_ptr<AsyncQueueStatistics> findAsyncQueueStatistics(const boost::shared_ptr<TransferElement>& accessor) {
+    for(auto& element : accessor->getHardwareAccessingElements()) {
+      auto statistics = boost::dynamic_pointer_cast<AsyncQueueStatistics>(element);
+      if(statistics) {
+        return statistics;
+      }
+    }
+    return {};
+  }
+
+  /**********************************************************************************************************/
   INSTANTIATE_TEMPLATE_FOR_CHIMERATK_USER_TYPES(AsyncNDRegisterAccessor);
 } // namespace ChimeraTK
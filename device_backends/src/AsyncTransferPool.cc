@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "AsyncTransferPool.h"
+
+#include "Exception.h"
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  AsyncTransferPool::AsyncTransferPool(size_t nThreads) : _nThreads(nThreads) {
+    if(_nThreads == 0) {
+      throw ChimeraTK::logic_error("AsyncTransferPool: The number of threads must not be 0.");
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  AsyncTransferPool::~AsyncTransferPool() {
+    std::vector<std::thread> threads;
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      _state->stop = true;
+      threads.swap(_threads);
+    }
+    _state->condition.notify_all();
+
+    for(auto& thread : threads) {
+      if(thread.get_id() == std::this_thread::get_id()) {
+        // The pool is destroyed by one of its own jobs. The thread terminates on its own, it keeps the state alive.
+        thread.detach();
+      }
+      else {
+        thread.join();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void AsyncTransferPool::submit(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(_state->mutex);
+      _state->jobs.push_back(std::move(job));
+      if(_threads.empty()) {
+        for(size_t i = 0; i < _nThreads; ++i) {
+          _threads.emplace_back([state = _state] { run(state); });
+        }
+      }
+    }
+    _state->condition.notify_one();
+  }
+
+  /********************************************************************************************************************/
+
+  void AsyncTransferPool::run(const std::shared_ptr<State>& state) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while(true) {
+      state->condition.wait(lock, [&] { return state->stop || !state->jobs.empty(); });
+      if(state->jobs.empty()) {
+        return; // stop requested and all jobs done
+      }
+      auto job = std::move(state->jobs.front());
+      state->jobs.pop_front();
+      lock.unlock();
+      job();
+      // Destroy the job before taking the lock, since the destruction might destroy the pool.
+      job = nullptr;
+      lock.lock();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  AsyncTransferPool& AsyncTransferPool::getDefault() {
+    static AsyncTransferPool defaultPool;
+    return defaultPool;
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "DeadlineTimer.h"
+
+#include <utility>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  DeadlineTimer::Handle::Handle(Handle&& other) noexcept
+  : _timer(std::exchange(other._timer, nullptr)), _id(other._id) {}
+
+  /********************************************************************************************************************/
+
+  DeadlineTimer::Handle& DeadlineTimer::Handle::operator=(Handle&& other) noexcept {
+    if(this != &other) {
+      cancel();
+      _timer = std::exchange(other._timer, nullptr);
+      _id = other._id;
+    }
+    return *this;
+  }
+
+  /********************************************************************************************************************/
+
+  void DeadlineTimer::Handle::cancel() {
+    if(_timer) {
+      _timer->cancel(_id);
+      _timer = nullptr;
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  DeadlineTimer& DeadlineTimer::getInstance() {
+    static DeadlineTimer instance;
+    return instance;
+  }
+
+  /********************************************************************************************************************/
+
+  DeadlineTimer::~DeadlineTimer() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _condition.notify_all();
+    if(_thread.joinable()) {
+      _thread.join();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  DeadlineTimer::Handle DeadlineTimer::schedule(TimePoint deadline, std::function<void()> function) {
+    uint64_t id;
+    bool isFirst;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      id = _nextId++;
+      _scheduled.emplace(std::make_pair(deadline, id), std::move(function));
+      _deadlines.emplace(id, deadline);
+      isFirst = (_scheduled.begin()->first.second == id);
+      if(!_thread.joinable()) {
+        _thread = std::thread([this] { run(); });
+      }
+    }
+    // only a new earliest deadline changes the wait of the thread
+    if(isFirst) {
+      _condition.notify_one();
+    }
+    return {this, id};
+  }
+
+  /********************************************************************************************************************/
+
+  void DeadlineTimer::cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _deadlines.find(id);
+    if(it == _deadlines.end()) {
+      return;
+    }
+    _scheduled.erase(std::make_pair(it->second, id));
+    _deadlines.erase(it);
+  }
+
+  /********************************************************************************************************************/
+
+  void DeadlineTimer::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(!_stop) {
+      if(_scheduled.empty()) {
+        _condition.wait(lock);
+        continue;
+      }
+      auto next = _scheduled.begin();
+      if(std::chrono::steady_clock::now() < next->first.first) {
+        _condition.wait_until(lock, next->first.first);
+        continue;
+      }
+      auto function = std::move(next->second);
+      _deadlines.erase(next->first.second);
+      _scheduled.erase(next);
+      lock.unlock();
+      function();
+      lock.lock();
+    }
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
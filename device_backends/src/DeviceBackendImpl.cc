@@ -3,15 +3,49 @@
 
 #include "DeviceBackendImpl.h"
 
+#include <algorithm>
+
 namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  DeviceBackendImpl::~DeviceBackendImpl() {
+    std::thread reconnectThread;
+    {
+      std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+      _reconnectState->stop = true;
+      reconnectThread.swap(_reconnectThread);
+    }
+    _reconnectState->condition.notify_all();
+
+    if(reconnectThread.joinable()) {
+      if(reconnectThread.get_id() == std::this_thread::get_id()) {
+        // The supervisor has released the last reference to the backend. The thread terminates on its own.
+        reconnectThread.detach();
+      }
+      else {
+        reconnectThread.join();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
   void DeviceBackendImpl::setOpenedAndClearException() noexcept {
+    _asyncReadActivated = false;
     _opened = true;
     _hasActiveException = false;
-    std::lock_guard<std::mutex> lk(_mx_activeExceptionMessage);
-    _activeExceptionMessage = "(exception cleared)";
+    {
+      std::lock_guard<std::mutex> lk(_mx_activeExceptionMessage);
+      _activeExceptionMessage = "(exception cleared)";
+      _activeException = nullptr;
+    }
+
+    // wake the threads in waitUntilFunctional()
+    {
+      std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+    }
+    _reconnectState->functionalCondition.notify_all();
   }
 
   /********************************************************************************************************************/
@@ -29,10 +63,19 @@ namespace ChimeraTK {
     {
       std::lock_guard<std::mutex> lk(_mx_activeExceptionMessage);
       _activeExceptionMessage = message;
+      _activeException = std::make_exception_ptr(ChimeraTK::runtime_error(message));
     }
 
     // execute backend-specific code
     setExceptionImpl();
+
+    // wake the reconnect supervisor, if enabled
+    {
+      std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+      _reconnectState->requested = true;
+      _reconnectState->gaveUp = false;
+    }
+    _reconnectState->condition.notify_all();
   }
 
   /********************************************************************************************************************/
@@ -44,4 +87,119 @@ namespace ChimeraTK {
 
   /********************************************************************************************************************/
 
+  AsyncTransferPool& DeviceBackendImpl::getAsyncTransferPool() {
+    std::call_once(_asyncTransferPoolCreated, [&] { _asyncTransferPool = std::make_unique<AsyncTransferPool>(); });
+    return *_asyncTransferPool;
+  }
+
+  /********************************************************************************************************************/
+
+  void DeviceBackendImpl::activateAsyncRead() noexcept {
+    if(isFunctional()) {
+      _asyncReadActivated = true;
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  void DeviceBackendImpl::enableReconnect(std::chrono::milliseconds initialDelay, std::chrono::milliseconds maxDelay) {
+    if(initialDelay.count() <= 0 || maxDelay < initialDelay) {
+      throw ChimeraTK::logic_error("DeviceBackendImpl::enableReconnect(): The initial delay must be positive and must "
+                                   "not exceed the maximum delay.");
+    }
+    boost::weak_ptr<DeviceBackend> weakBackend = shared_from_this();
+
+    std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+    _reconnectState->initialDelay = initialDelay;
+    _reconnectState->maxDelay = maxDelay;
+    if(!_reconnectThread.joinable()) {
+      _reconnectThread = std::thread([state = _reconnectState, weakBackend] { runReconnect(state, weakBackend); });
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  bool DeviceBackendImpl::isReconnecting() {
+    std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+    return _reconnectState->reconnecting;
+  }
+
+  /********************************************************************************************************************/
+
+  bool DeviceBackendImpl::waitUntilFunctional(std::chrono::steady_clock::duration timeout) {
+    std::unique_lock<std::mutex> lock(_reconnectState->mutex);
+    _reconnectState->functionalCondition.wait_for(
+        lock, timeout, [&] { return isFunctional() || _reconnectState->gaveUp; });
+    return isFunctional();
+  }
+
+  /********************************************************************************************************************/
+
+  void DeviceBackendImpl::runReconnect(
+      const std::shared_ptr<ReconnectState>& state, const boost::weak_ptr<DeviceBackend>& weakBackend) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    while(true) {
+      state->condition.wait(lock, [&] { return state->stop || state->requested; });
+      if(state->stop) {
+        return;
+      }
+      // An exception during this cycle sets the flag again and starts another cycle afterwards.
+      state->requested = false;
+      state->reconnecting = true;
+
+      auto delay = state->initialDelay;
+      bool done = false;
+      while(!done) {
+        if(state->condition.wait_for(lock, delay, [&] { return state->stop; })) {
+          return;
+        }
+        lock.unlock();
+        {
+          // Release the backend before taking the lock again: The destructor might run in this thread.
+          auto backend = boost::static_pointer_cast<DeviceBackendImpl>(weakBackend.lock());
+          done = !backend || backend->attemptReconnect();
+        }
+        lock.lock();
+        delay = std::min(delay * 2, state->maxDelay);
+      }
+      state->reconnecting = false;
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  bool DeviceBackendImpl::attemptReconnect() {
+    // Stop if the application has closed the backend or has already recovered it.
+    if(!_opened || !_hasActiveException) {
+      return true;
+    }
+    bool activateAsyncReadAgain = _asyncReadActivated;
+    try {
+      open();
+    }
+    catch(ChimeraTK::runtime_error&) {
+      return false;
+    }
+    catch(ChimeraTK::logic_error& e) {
+      // Retrying cannot help. The backend stays in the exception state, which now tells why it is not recovered.
+      {
+        std::lock_guard<std::mutex> lk(_mx_activeExceptionMessage);
+        _activeExceptionMessage = std::string("Giving up reconnecting, open() failed with a logic error: ") + e.what();
+        _activeException = std::make_exception_ptr(ChimeraTK::runtime_error(_activeExceptionMessage));
+      }
+      {
+        std::lock_guard<std::mutex> lock(_reconnectState->mutex);
+        _reconnectState->gaveUp = true;
+      }
+      _reconnectState->functionalCondition.notify_all();
+      return true;
+    }
+    if(activateAsyncReadAgain) {
+      activateAsyncRead();
+    }
+    return true;
+  }
+
+  /********************************************************************************************************************/
+
 } // namespace ChimeraTK
\ No newline at end of file
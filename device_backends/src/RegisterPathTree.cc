@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "RegisterPathTree.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  RegisterPathTree::RegisterPathTree(const std::vector<const BackendRegisterInfoBase*>& registers) {
+    // insert all registers, creating the nodes for their path components
+    _nodes.emplace_back();
+    for(const auto* info : registers) {
+      auto name = info->getRegisterName();
+      if(_altSeparator.empty()) {
+        _altSeparator = name.getAltSeparator();
+      }
+      size_t index = 0;
+      for(auto& component : name.getComponents()) {
+        auto it = _nodes[index].children.find(component);
+        if(it != _nodes[index].children.end()) {
+          index = it->second;
+          continue;
+        }
+        size_t child = _nodes.size();
+        _nodes[index].children.emplace(component, child);
+        _nodes[index].childrenInOrder.push_back(child);
+        _nodes.emplace_back();
+        _nodes.back().name = std::move(component);
+        index = child;
+      }
+      _nodes[index].registers.push_back(info);
+    }
+
+    // order the registers depth first, so each subtree is a contiguous range
+    _registersDepthFirst.reserve(registers.size());
+    _registersDepthFirst.insert(_registersDepthFirst.end(), _nodes[0].registers.begin(), _nodes[0].registers.end());
+    std::vector<std::pair<size_t, size_t>> stack{{0, 0}}; // node index and index of the next child to visit
+    while(!stack.empty()) {
+      auto& [index, nextChild] = stack.back();
+      auto& node = _nodes[index];
+      if(nextChild < node.childrenInOrder.size()) {
+        auto& child = _nodes[node.childrenInOrder[nextChild]];
+        child.subtreeBegin = _registersDepthFirst.size();
+        _registersDepthFirst.insert(_registersDepthFirst.end(), child.registers.begin(), child.registers.end());
+        // stack.back() is invalidated by emplace_back(), so do not use index and nextChild afterwards
+        auto childIndex = node.childrenInOrder[nextChild++];
+        stack.emplace_back(childIndex, 0);
+      }
+      else {
+        node.subtreeEnd = _registersDepthFirst.size();
+        stack.pop_back();
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<std::string> RegisterPathTree::split(RegisterPath path) const {
+    if(path.getAltSeparator().empty() && !_altSeparator.empty()) {
+      path.setAltSeparator(_altSeparator);
+    }
+    return path.getComponents();
+  }
+
+  /********************************************************************************************************************/
+
+  const RegisterPathTree::Node* RegisterPathTree::findNode(const RegisterPath& path) const {
+    const Node* node = &_nodes[0];
+    for(const auto& component : split(path)) {
+      auto it = node->children.find(component);
+      if(it == node->children.end()) {
+        return nullptr;
+      }
+      node = &_nodes[it->second];
+    }
+    return node;
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<const BackendRegisterInfoBase*> RegisterPathTree::getRegistersInModule(
+      const RegisterPath& moduleName) const {
+    const auto* node = findNode(moduleName);
+    if(!node) {
+      return {};
+    }
+    return {_registersDepthFirst.begin() + static_cast<std::ptrdiff_t>(node->subtreeBegin),
+        _registersDepthFirst.begin() + static_cast<std::ptrdiff_t>(node->subtreeEnd)};
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<std::string> RegisterPathTree::getChildNames(const RegisterPath& moduleName) const {
+    std::vector<std::string> names;
+    const auto* node = findNode(moduleName);
+    if(node) {
+      names.reserve(node->childrenInOrder.size());
+      for(auto child : node->childrenInOrder) {
+        names.push_back(_nodes[child].name);
+      }
+    }
+    return names;
+  }
+
+  /********************************************************************************************************************/
+
+  std::vector<const BackendRegisterInfoBase*> RegisterPathTree::getRegistersMatching(const std::string& pattern) const {
+    std::vector<const BackendRegisterInfoBase*> result;
+    auto components = split(pattern);
+    match(_nodes[0], components, 0, result);
+
+    // With more than one "**" the same register can be matched in different ways
+    if(std::count(components.begin(), components.end(), "**") > 1) {
+      std::unordered_set<const BackendRegisterInfoBase*> seen;
+      result.erase(std::remove_if(result.begin(), result.end(), [&](auto* info) { return !seen.insert(info).second; }),
+          result.end());
+    }
+    return result;
+  }
+
+  /********************************************************************************************************************/
+
+  void RegisterPathTree::match(const Node& node, const std::vector<std::string>& pattern, size_t component,
+      std::vector<const BackendRegisterInfoBase*>& result) const {
+    if(component == pattern.size()) {
+      result.insert(result.end(), node.registers.begin(), node.registers.end());
+      return;
+    }
+
+    const auto& componentPattern = pattern[component];
+    if(componentPattern == "**") {
+      if(component + 1 == pattern.size()) {
+        // trailing "**" matches the entire subtree
+        result.insert(result.end(), _registersDepthFirst.begin() + static_cast<std::ptrdiff_t>(node.subtreeBegin),
+            _registersDepthFirst.begin() + static_cast<std::ptrdiff_t>(node.subtreeEnd));
+        return;
+      }
+      match(node, pattern, component + 1, result);
+      for(auto child : node.childrenInOrder) {
+        match(_nodes[child], pattern, component, result);
+      }
+      return;
+    }
+
+    if(componentPattern.find_first_of("*?") == std::string::npos) {
+      // no wildcards: direct lookup
+      auto it = node.children.find(componentPattern);
+      if(it != node.children.end()) {
+        match(_nodes[it->second], pattern, component + 1, result);
+      }
+      return;
+    }
+
+    for(auto child : node.childrenInOrder) {
+      if(matchComponent(componentPattern, _nodes[child].name)) {
+        match(_nodes[child], pattern, component + 1, result);
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  bool RegisterPathTree::matchComponent(const std::string& pattern, const std::string& name) {
+    size_t p = 0, n = 0;
+    size_t starPattern = std::string::npos, starName = 0;
+    while(n < name.size()) {
+      if(p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+        ++p;
+        ++n;
+      }
+      else if(p < pattern.size() && pattern[p] == '*') {
+        // remember the position of the star, first try to match it with no characters
+        starPattern = p++;
+        starName = n;
+      }
+      else if(starPattern != std::string::npos) {
+        // backtrack: let the last star match one more character
+        p = starPattern + 1;
+        n = ++starName;
+      }
+      else {
+        return false;
+      }
+    }
+    while(p < pattern.size() && pattern[p] == '*') {
+      ++p;
+    }
+    return p == pattern.size();
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "TimerInterruptSource.h"
+
+#include "Exception.h"
+
+namespace ChimeraTK {
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::SteadyClock::waitUntil(TimePoint deadline) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _condition.wait_until(lock, deadline, [&] { return _wokenUp; });
+    _wokenUp = false;
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::SteadyClock::wakeUp() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _wokenUp = true;
+    }
+    _condition.notify_all();
+  }
+
+  /********************************************************************************************************************/
+
+  TimerInterruptSource::TimePoint TimerInterruptSource::SimulatedClock::now() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _now;
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::SimulatedClock::waitUntil(TimePoint deadline) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    ++_nWaiting;
+    _condition.wait(lock, [&] { return _wokenUp || _now >= deadline; });
+    --_nWaiting;
+    _wokenUp = false;
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::SimulatedClock::wakeUp() {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _wokenUp = true;
+    }
+    _condition.notify_all();
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::SimulatedClock::advance(Duration duration) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _now += duration;
+    }
+    _condition.notify_all();
+  }
+
+  /********************************************************************************************************************/
+
+  bool TimerInterruptSource::SimulatedClock::hasWaitingThread() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nWaiting > 0;
+  }
+
+  /********************************************************************************************************************/
+
+  TimerInterruptSource::TimerInterruptSource(
+      Duration period, std::function<void()> function, std::shared_ptr<Clock> clock)
+  : _period(period), _function(std::move(function)), _clock(std::move(clock)) {
+    if(_period <= Duration::zero()) {
+      throw ChimeraTK::logic_error("TimerInterruptSource: The period must be positive.");
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  TimerInterruptSource::~TimerInterruptSource() {
+    stop();
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::start() {
+    if(_thread.joinable()) {
+      return;
+    }
+    _stop = false;
+    _thread = std::thread([this] { run(); });
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::stop() {
+    if(!_thread.joinable()) {
+      return;
+    }
+    _stop = true;
+    _clock->wakeUp();
+    _thread.join();
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::setClock(std::shared_ptr<Clock> clock) {
+    if(_thread.joinable()) {
+      throw ChimeraTK::logic_error("TimerInterruptSource: The clock cannot be replaced while the timer is running.");
+    }
+    _clock = std::move(clock);
+  }
+
+  /********************************************************************************************************************/
+
+  void TimerInterruptSource::run() {
+    auto deadline = _clock->now() + _period;
+    while(true) {
+      // spurious wake-ups are possible, so wait in a loop
+      while(!_stop && _clock->now() < deadline) {
+        _clock->waitUntil(deadline);
+      }
+      if(_stop) {
+        return;
+      }
+
+      _function();
+
+      // skip the periods which have been missed
+      deadline += _period;
+      auto now = _clock->now();
+      if(deadline <= now) {
+        auto nMissed = (now - deadline) / _period + 1;
+        deadline += nMissed * _period;
+        _nSkippedPeriods += nMissed;
+      }
+    }
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "Exception.h"
+#include "parserUtilities.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ChimeraTK {
+
+  /**
+   * Persistent binary cache for register catalogues which are created by parsing a file, e.g. a map file or an xlmap
+   * file. The parsers store their result in a cache file and read it back instead of parsing again, as long as the
+   * content of the source file has not changed. The textual files remain the source of truth: A cache file is only
+   * used if its header matches the format version and the content hash of the source file, and if the content of the
+   * cache file matches the checksum in the header. Any problem with a cache file is treated as a cache miss, so the
+   * file is parsed and the cache file is written again.
+   *
+   * The cache is disabled by default. It can be enabled with setLocation(), or with the environment variable
+   * CHIMERATK_CATALOGUE_CACHE, which allows to enable it for existing tools without code changes:
+   * \li not set or empty: the cache is disabled
+   * \li "next-to-source": the cache file is stored next to the source file, see Location::sourceDirectory
+   * \li any other value: name of the directory to store the cache files in, see Location::cacheDirectory
+   *
+   * The cache files contain binary data in the native byte order of the machine which has written them. A cache file
+   * written on a machine with a different byte order is rejected.
+   */
+  class CatalogueCache {
+   public:
+    enum class Location {
+      disabled,        ///< Neither read nor write cache files
+      sourceDirectory, ///< Store the cache file as hidden file next to the source file. It is overwritten when the
+                       ///< source file has changed.
+      cacheDirectory   ///< Store the cache files in a common directory. The name of the cache file contains a hash
+                       ///< of the path of the source file and the content hash. Writing a cache file deletes the
+                       ///< cache files of previous contents of the same source file, so the directory does not grow
+                       ///< with each change of a source file.
+    };
+
+    /**
+     * Set the location of the cache files for the entire process. The cacheDirectory is only used with
+     * Location::cacheDirectory and is created if it does not exist. Overrides the environment variable.
+     */
+    static void setLocation(Location location, const std::string& cacheDirectory = {});
+
+    /** Get the location of the cache files. */
+    static Location getLocation();
+
+    /** Check whether the cache is enabled. */
+    static bool isEnabled() { return getLocation() != Location::disabled; }
+
+    /**
+     * Compute a 64 bit hash (FNV-1a) of the given data. To combine the hash of multiple pieces of data, pass the
+     * result of the previous call as seed.
+     */
+    static uint64_t hash(std::string_view data, uint64_t seed = 0xcbf29ce484222325ULL);
+
+    /**
+     * Return the name of the cache file for the given source file and content hash. The extension distinguishes the
+     * different kinds of cache files. The variant distinguishes cache files of the same source file which are needed at
+     * the same time, e.g. for an xlmap file used with different parameters. With Location::cacheDirectory, they are
+     * kept side by side. Returns an empty string if the cache is disabled.
+     */
+    static std::string getCacheFileName(const std::string& sourceFileName, uint64_t contentHash,
+        const std::string& extension, std::string_view variant = {});
+
+    /******************************************************************************************************************/
+
+    /**
+     * Serialise data into a cache file. The data is collected in memory and written by store().
+     */
+    class Writer {
+     public:
+      /** The kind identifies the type of the cache content, the version the format of the content. */
+      Writer(std::string_view kind, uint32_t version, uint64_t contentHash);
+
+      /** Write a trivially copyable value, e.g. an integer or an enum. */
+      template<typename T>
+      void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        _buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      /** Write a string, prefixed by its length. */
+      void writeString(std::string_view value);
+
+      /**
+       * Write the cache file. The file is first written under a temporary name and then renamed, so concurrent
+       * readers never see a partially written file. Afterwards, the cache files of previous contents of the same source
+       * file and variant are deleted (only with Location::cacheDirectory). Errors are ignored, since the cache is only
+       * an optimisation. Returns whether the file has been written.
+       */
+      bool store(const std::string& cacheFileName);
+
+     private:
+      std::string _buffer;
+      size_t _payloadSizeOffset;
+    };
+
+    /******************************************************************************************************************/
+
+    /**
+     * Read data from a cache file, which is mapped into memory read-only.
+     *
+     * Throws ChimeraTK::runtime_error if the file cannot be read, if the header does not match, if the checksum of the
+     * content is wrong or if more data is read than present. Callers should treat this as cache miss.
+     */
+    class Reader {
+     public:
+      Reader(const std::string& cacheFileName, std::string_view kind, uint32_t version, uint64_t contentHash);
+
+      /** Read a trivially copyable value, e.g. an integer or an enum. */
+      template<typename T>
+      T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+      }
+
+      /** Read a string which has been written with Writer::writeString(). The view points into the mapped file. */
+      std::string_view readString();
+
+      /** Check whether all data has been read. */
+      [[nodiscard]] bool atEnd() const { return _data.empty(); }
+
+     private:
+      std::string_view take(size_t nBytes);
+
+      std::string _fileName;
+      std::unique_ptr<parserUtilities::MappedFile> _file;
+      std::string_view _data;
+    };
+  };
+
+} // namespace ChimeraTK
@@ -4,6 +4,7 @@
 
 #include "Exception.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -43,6 +44,14 @@ namespace ChimeraTK {
       }
     }
 
+    /** get alternative separator. Returns an empty string if no alternative separator is set. */
+    [[nodiscard]] const std::string& getAltSeparator() const { return separator_alt; }
+
+    /** obtain path in standardised notation with the alternative separator (if set) replaced by "/". Paths with the
+     * same (or without) alternative separator compare equal exactly if their canonical paths are equal, so the
+     * canonical path can be used e.g. as key in hash maps. */
+    [[nodiscard]] std::string getCanonicalPath() const { return getWithOtherSeparatorReplaced(separator_alt); }
+
     /** obtain path with alternative separator character instead of "/". The
      * leading separator will be omitted */
     [[nodiscard]] std::string getWithAltSeparator() const {
@@ -71,6 +80,8 @@ namespace ChimeraTK {
 
     /** < operator: comparison used for sorting e.g.\ in std::map */
     bool operator<(const RegisterPath& rightHandSide) const {
+      // fast path without temporary strings if no alternative separator is involved
+      if(separator_alt.empty() && rightHandSide.separator_alt.empty()) return path < rightHandSide.path;
       std::string sepalt = getCommonAltSeparator(rightHandSide);
       return getWithOtherSeparatorReplaced(sepalt) < rightHandSide.getWithOtherSeparatorReplaced(sepalt);
     }
@@ -115,6 +126,8 @@ namespace ChimeraTK {
 
     /** comparison with other RegisterPath */
     bool operator==(const RegisterPath& rightHandSide) const {
+      // fast path without temporary strings if no alternative separator is involved
+      if(separator_alt.empty() && rightHandSide.separator_alt.empty()) return path == rightHandSide.path;
       std::string sepalt = getCommonAltSeparator(rightHandSide);
       return getWithOtherSeparatorReplaced(sepalt) == rightHandSide.getWithOtherSeparatorReplaced(sepalt);
     }
@@ -195,6 +208,14 @@ namespace ChimeraTK {
      * removes a trailing separator, if present. The second optional argument
      * allows to search for other separators instead of the default. */
     [[nodiscard]] static std::string removeExtraSeparators(std::string string, const std::string& sep = separator) {
+      if(sep.length() == 1) {
+        // single pass for the common case of a single-character separator
+        auto last = std::unique(
+            string.begin(), string.end(), [c = sep[0]](char a, char b) { return a == c && b == c; });
+        string.erase(last, string.end());
+        if(string.length() > 1 && string.back() == sep[0]) string.pop_back();
+        return string;
+      }
       std::size_t pos;
       while((pos = string.find(std::string(sep) + sep)) != std::string::npos) {
         string.erase(pos, 1);
@@ -210,9 +231,14 @@ namespace ChimeraTK {
       if(otherSeparator.length() == 0) return path;
       // replace all occurrences of otherSeparator with separator
       std::string path_other = path;
-      size_t pos = 0;
-      while((pos = path_other.find(otherSeparator)) != std::string::npos) {
-        path_other.replace(pos, 1, std::string(separator));
+      if(otherSeparator.length() == 1) {
+        std::replace(path_other.begin(), path_other.end(), otherSeparator[0], separator[0]);
+      }
+      else {
+        size_t pos = 0;
+        while((pos = path_other.find(otherSeparator)) != std::string::npos) {
+          path_other.replace(pos, 1, std::string(separator));
+        }
       }
       // replace duplicate separators and remove one of them. Also remove a
       // trailing separator, if present.
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace ChimeraTK::parserUtilities {
 
@@ -69,4 +70,33 @@ namespace ChimeraTK::parserUtilities {
    *        </ul>
    */
   std::string concatenatePaths(const std::string& path1, const std::string& path2);
+
+  /*!
+   * @brief Read-only memory mapping of an entire file.
+   *
+   * The content is valid as long as the object exists. An empty file results in an empty content. Files which cannot
+   * be mapped since they are not regular files (e.g. pipes or process substitutions) are read into memory instead.
+   *
+   * @throw ChimeraTK::logic_error if the file cannot be opened, read or mapped.
+   */
+  class MappedFile {
+   public:
+    explicit MappedFile(const std::string& fileName);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    [[nodiscard]] std::string_view getContent() const {
+      return _data ? std::string_view(static_cast<const char*>(_data), _size) : std::string_view(_buffer);
+    }
+
+   private:
+    void* _data{nullptr};
+    size_t _size{0};
+
+    /// content of files which are not mapped
+    std::string _buffer;
+  };
+
 } // namespace ChimeraTK::parserUtilities
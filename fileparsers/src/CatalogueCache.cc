@@ -0,0 +1,264 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "CatalogueCache.h"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace ChimeraTK {
+
+  namespace {
+
+    /******************************************************************************************************************/
+
+    /** Identifies cache files. The byte order mark rejects files written on a machine with a different byte order. */
+    constexpr std::string_view magic{"CTKCACHE"};
+    constexpr uint32_t byteOrderMark{0x01020304};
+
+    /******************************************************************************************************************/
+
+    struct LocationSetting {
+      std::mutex mutex;
+      CatalogueCache::Location location{CatalogueCache::Location::disabled};
+      std::string cacheDirectory;
+
+      /** Initialise from the environment variable. */
+      LocationSetting() {
+        const char* env = std::getenv("CHIMERATK_CATALOGUE_CACHE");
+        if(env == nullptr || std::string_view(env).empty()) {
+          return;
+        }
+        if(std::string_view(env) == "next-to-source") {
+          location = CatalogueCache::Location::sourceDirectory;
+          return;
+        }
+        location = CatalogueCache::Location::cacheDirectory;
+        cacheDirectory = env;
+      }
+    };
+
+    LocationSetting& getLocationSetting() {
+      static LocationSetting setting;
+      return setting;
+    }
+
+    /******************************************************************************************************************/
+
+    std::string toHex(uint64_t value) {
+      char hexString[17];
+      std::snprintf(hexString, sizeof(hexString), "%016llx", static_cast<unsigned long long>(value));
+      return hexString;
+    }
+
+    /******************************************************************************************************************/
+
+    /**
+     * In the cache directory, the cache files are named "<source file name>-<source hash>-<content hash>.<extension>".
+     * Return the name up to the source hash (including the trailing '-'), or an empty string if the name of the given
+     * file does not follow this pattern.
+     */
+    std::string getSourcePrefix(const std::filesystem::path& cacheFile) {
+      auto stem = cacheFile.stem().string();
+      constexpr size_t hashLength = 16;
+      if(stem.size() < 2 * (hashLength + 1) || stem[stem.size() - hashLength - 1] != '-' ||
+          stem[stem.size() - 2 * hashLength - 2] != '-') {
+        return {};
+      }
+      return stem.substr(0, stem.size() - hashLength);
+    }
+
+    /******************************************************************************************************************/
+
+    /** Delete the cache files for other contents of the same source file and variant as the given cache file. */
+    void removeOtherContents(const std::filesystem::path& cacheFile) {
+      auto prefix = getSourcePrefix(cacheFile);
+      if(prefix.empty()) {
+        return;
+      }
+      auto directory = cacheFile.parent_path();
+      std::error_code error;
+      std::vector<std::filesystem::path> outdated;
+      for(std::filesystem::directory_iterator it(directory.empty() ? "." : directory, error), end;
+          !error && it != end; it.increment(error)) {
+        const auto& path = it->path();
+        if(path.filename() != cacheFile.filename() && path.extension() == cacheFile.extension() &&
+            getSourcePrefix(path) == prefix) {
+          outdated.push_back(path);
+        }
+      }
+      for(const auto& path : outdated) {
+        std::filesystem::remove(path, error);
+      }
+    }
+
+  } // namespace
+
+  /********************************************************************************************************************/
+
+  void CatalogueCache::setLocation(Location location, const std::string& cacheDirectory) {
+    if(location == Location::cacheDirectory && cacheDirectory.empty()) {
+      throw ChimeraTK::logic_error("CatalogueCache::setLocation(): The cache directory must not be empty.");
+    }
+    auto& setting = getLocationSetting();
+    std::lock_guard<std::mutex> lock(setting.mutex);
+    setting.location = location;
+    setting.cacheDirectory = cacheDirectory;
+  }
+
+  /********************************************************************************************************************/
+
+  CatalogueCache::Location CatalogueCache::getLocation() {
+    auto& setting = getLocationSetting();
+    std::lock_guard<std::mutex> lock(setting.mutex);
+    return setting.location;
+  }
+
+  /********************************************************************************************************************/
+
+  uint64_t CatalogueCache::hash(std::string_view data, uint64_t seed) {
+    uint64_t h = seed;
+    for(char c : data) {
+      h ^= static_cast<unsigned char>(c);
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+  /********************************************************************************************************************/
+
+  std::string CatalogueCache::getCacheFileName(const std::string& sourceFileName, uint64_t contentHash,
+      const std::string& extension, std::string_view variant) {
+    auto& setting = getLocationSetting();
+    std::lock_guard<std::mutex> lock(setting.mutex);
+
+    auto fileName = parserUtilities::extractFileName(sourceFileName);
+    if(setting.location == Location::sourceDirectory) {
+      return parserUtilities::extractDirectory(sourceFileName) + "." + fileName + "." + extension;
+    }
+    if(setting.location == Location::cacheDirectory) {
+      // The source hash identifies the source file, so the cache files of its previous contents can be found.
+      std::error_code error;
+      auto sourcePath = std::filesystem::absolute(sourceFileName, error).lexically_normal().string();
+      if(error) {
+        sourcePath = sourceFileName;
+      }
+      auto sourceHash = hash(variant, hash(std::string_view(sourcePath.c_str(), sourcePath.size() + 1)));
+      return parserUtilities::concatenatePaths(
+          setting.cacheDirectory, fileName + "-" + toHex(sourceHash) + "-" + toHex(contentHash) + "." + extension);
+    }
+    return {};
+  }
+
+  /********************************************************************************************************************/
+  /********************************************************************************************************************/
+
+  CatalogueCache::Writer::Writer(std::string_view kind, uint32_t version, uint64_t contentHash) {
+    _buffer.append(magic);
+    write(byteOrderMark);
+    write(version);
+    writeString(kind);
+    write(contentHash);
+    // placeholders for the payload size and the payload hash, filled in store()
+    _payloadSizeOffset = _buffer.size();
+    write(uint64_t(0));
+    write(uint64_t(0));
+  }
+
+  /********************************************************************************************************************/
+
+  void CatalogueCache::Writer::writeString(std::string_view value) {
+    write(uint64_t(value.size()));
+    _buffer.append(value);
+  }
+
+  /********************************************************************************************************************/
+
+  bool CatalogueCache::Writer::store(const std::string& cacheFileName) {
+    auto payload = std::string_view(_buffer).substr(_payloadSizeOffset + 2 * sizeof(uint64_t));
+    uint64_t payloadSize = payload.size();
+    uint64_t payloadHash = hash(payload);
+    std::memcpy(_buffer.data() + _payloadSizeOffset, &payloadSize, sizeof(payloadSize));
+    std::memcpy(_buffer.data() + _payloadSizeOffset + sizeof(uint64_t), &payloadHash, sizeof(payloadHash));
+
+    std::error_code error;
+    auto directory = std::filesystem::path(cacheFileName).parent_path();
+    if(!directory.empty()) {
+      std::filesystem::create_directories(directory, error);
+    }
+
+    std::string temporaryName = cacheFileName + ".tmp" + std::to_string(::getpid());
+    {
+      std::ofstream file(temporaryName, std::ios::binary | std::ios::trunc);
+      if(!file) return false;
+      file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+      if(!file) {
+        file.close();
+        std::filesystem::remove(temporaryName, error);
+        return false;
+      }
+    }
+    std::filesystem::rename(temporaryName, cacheFileName, error);
+    if(error) {
+      std::filesystem::remove(temporaryName, error);
+      return false;
+    }
+    removeOtherContents(cacheFileName);
+    return true;
+  }
+
+  /********************************************************************************************************************/
+  /********************************************************************************************************************/
+
+  CatalogueCache::Reader::Reader(
+      const std::string& cacheFileName, std::string_view kind, uint32_t version, uint64_t contentHash)
+  : _fileName(cacheFileName) {
+    try {
+      _file = std::make_unique<parserUtilities::MappedFile>(cacheFileName);
+    }
+    catch(ChimeraTK::logic_error& e) {
+      throw ChimeraTK::runtime_error(std::string("Cannot read catalogue cache file: ") + e.what());
+    }
+    _data = _file->getContent();
+
+    if(take(magic.size()) != magic || read<uint32_t>() != byteOrderMark || read<uint32_t>() != version ||
+        readString() != kind || read<uint64_t>() != contentHash) {
+      throw ChimeraTK::runtime_error("Catalogue cache file '" + _fileName + "' does not match the source file.");
+    }
+    auto payloadSize = read<uint64_t>();
+    auto payloadHash = read<uint64_t>();
+    if(payloadSize != _data.size()) {
+      throw ChimeraTK::runtime_error("Catalogue cache file '" + _fileName + "' has the wrong size.");
+    }
+    if(payloadHash != hash(_data)) {
+      throw ChimeraTK::runtime_error("Catalogue cache file '" + _fileName + "' is corrupt.");
+    }
+  }
+
+  /********************************************************************************************************************/
+
+  std::string_view CatalogueCache::Reader::readString() {
+    auto size = read<uint64_t>();
+    return take(size);
+  }
+
+  /********************************************************************************************************************/
+
+  std::string_view CatalogueCache::Reader::take(size_t nBytes) {
+    if(nBytes > _data.size()) {
+      throw ChimeraTK::runtime_error("Catalogue cache file '" + _fileName + "' is truncated.");
+    }
+    auto result = _data.substr(0, nBytes);
+    _data.remove_prefix(nBytes);
+    return result;
+  }
+
+  /********************************************************************************************************************/
+
+} // namespace ChimeraTK
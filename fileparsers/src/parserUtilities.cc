@@ -3,6 +3,13 @@
 
 #include "parserUtilities.h"
 
+#include "Exception.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <cerrno>
 #include <cstdlib>
 #include <filesystem>
 #include <stdexcept>
@@ -69,4 +76,46 @@ namespace ChimeraTK::parserUtilities {
     return path + "/";
   }
 
+  MappedFile::MappedFile(const std::string& fileName) {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if(fd < 0) {
+      throw ChimeraTK::logic_error("Cannot open file \"" + fileName + "\"");
+    }
+    struct stat fileStat {};
+    if(::fstat(fd, &fileStat) != 0) {
+      ::close(fd);
+      throw ChimeraTK::logic_error("Cannot open file \"" + fileName + "\"");
+    }
+    if(!S_ISREG(fileStat.st_mode)) {
+      // pipes etc. cannot be mapped and have no size in advance
+      char chunk[65536];
+      ssize_t n;
+      while((n = ::read(fd, chunk, sizeof(chunk))) != 0) {
+        if(n < 0) {
+          if(errno == EINTR) continue;
+          ::close(fd);
+          throw ChimeraTK::logic_error("Cannot read file \"" + fileName + "\"");
+        }
+        _buffer.append(chunk, static_cast<size_t>(n));
+      }
+      ::close(fd);
+      return;
+    }
+    _size = static_cast<size_t>(fileStat.st_size);
+    // mmap() refuses empty files
+    if(_size > 0) {
+      _data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if(_data == MAP_FAILED) {
+      throw ChimeraTK::logic_error("Cannot map file \"" + fileName + "\" into memory");
+    }
+  }
+
+  MappedFile::~MappedFile() {
+    if(_data) {
+      ::munmap(_data, _size);
+    }
+  }
+
 } // namespace ChimeraTK::parserUtilities
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AsyncNDRegisterAccessorTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "AsyncNDRegisterAccessor.h"
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackend.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <thread>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(AsyncNDRegisterAccessorTestSuite)
+
+static const std::string cdd{"(dummy?map=asyncQueueSize.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testQueueSizeFromMetadata) {
+  Device device(cdd);
+  device.open();
+  device.activateAsyncRead();
+
+  auto defaultQueue = device.getScalarRegisterAccessor<int32_t>("APP/DEFAULT_QUEUE", 0, {AccessMode::wait_for_new_data});
+  auto largeQueue = device.getScalarRegisterAccessor<int32_t>("APP/LARGE_QUEUE", 0, {AccessMode::wait_for_new_data});
+  auto polled = device.getScalarRegisterAccessor<int32_t>("APP/POLLED");
+
+  auto defaultStatistics = findAsyncQueueStatistics(defaultQueue.getHighLevelImplElement());
+  auto largeStatistics = findAsyncQueueStatistics(largeQueue.getHighLevelImplElement());
+  BOOST_REQUIRE(defaultStatistics);
+  BOOST_REQUIRE(largeStatistics);
+  BOOST_CHECK_EQUAL(defaultStatistics->getQueueSize(), 5);
+  BOOST_CHECK_EQUAL(largeStatistics->getQueueSize(), 64);
+
+  // poll-type accessors have no queue
+  BOOST_CHECK(!findAsyncQueueStatistics(polled.getHighLevelImplElement()));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testOverflowStatistics) {
+  Device device(cdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(dummy);
+
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/DEFAULT_QUEUE", 0, {AccessMode::wait_for_new_data});
+  auto statistics = findAsyncQueueStatistics(accessor.getHighLevelImplElement());
+  BOOST_REQUIRE(statistics);
+
+  device.activateAsyncRead();
+  accessor.read(); // initial value
+  statistics->resetQueueStatistics();
+
+  // fill the queue up to its capacity: nothing is lost
+  for(size_t i = 0; i < 5; ++i) {
+    dummy->triggerInterrupt(1);
+  }
+  BOOST_CHECK_EQUAL(statistics->getNumberOfOverwrittenElements(), 0);
+  BOOST_CHECK_EQUAL(statistics->getQueueHighWaterMark(), 5);
+
+  // each further trigger overwrites the latest element
+  dummy->triggerInterrupt(1);
+  dummy->triggerInterrupt(1);
+  BOOST_CHECK_EQUAL(statistics->getNumberOfOverwrittenElements(), 2);
+  BOOST_CHECK_EQUAL(statistics->getQueueHighWaterMark(), 5);
+
+  size_t nUpdates = 0;
+  while(accessor.readNonBlocking()) {
+    ++nUpdates;
+  }
+  BOOST_CHECK_EQUAL(nUpdates, 5);
+
+  statistics->resetQueueStatistics();
+  BOOST_CHECK_EQUAL(statistics->getNumberOfOverwrittenElements(), 0);
+  BOOST_CHECK_EQUAL(statistics->getQueueHighWaterMark(), 0);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testMailbox) {
+  Device device(cdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(dummy);
+
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/MAILBOX", 0, {AccessMode::wait_for_new_data});
+  auto statistics = findAsyncQueueStatistics(accessor.getHighLevelImplElement());
+  BOOST_REQUIRE(statistics);
+  BOOST_CHECK_EQUAL(statistics->getQueueSize(), 1);
+
+  device.activateAsyncRead();
+  accessor.read(); // initial value
+
+  // only the latest of several values is received
+  VersionNumber lastVersion{nullptr};
+  for(int32_t value = 1; value <= 10; ++value) {
+    dummy->write(uint64_t(0), uint64_t(0xC), &value, sizeof(value));
+    lastVersion = dummy->triggerInterrupt(1);
+  }
+  BOOST_CHECK_EQUAL(statistics->getNumberOfOverwrittenElements(), 9);
+
+  BOOST_CHECK(accessor.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(accessor), 10);
+  BOOST_CHECK(accessor.getVersionNumber() == lastVersion);
+  BOOST_CHECK(!accessor.readNonBlocking());
+
+  // the mailbox keeps working after it has been emptied
+  int32_t value = 42;
+  dummy->write(uint64_t(0), uint64_t(0xC), &value, sizeof(value));
+  dummy->triggerInterrupt(1);
+  accessor.read();
+  BOOST_CHECK_EQUAL(int32_t(accessor), 42);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testInvalidQueueSizeMetadata) {
+  const std::string mapFile{"invalidAsyncQueueSize.map"};
+  auto createBackend = [&](const std::string& metadata) {
+    std::ofstream(mapFile, std::ios::trunc) << metadata << "\nAPP.REGISTER 1 0x0 4 0 32 0 1 INTERRUPT1\n";
+    DummyBackend backend(mapFile);
+    return backend.getAsyncQueueSize("APP/REGISTER");
+  };
+
+  BOOST_CHECK_EQUAL(createBackend("@ASYNC_QUEUE_SIZE 7"), 7);
+  BOOST_CHECK_EQUAL(createBackend("@ASYNC_QUEUE_SIZE:APP.REGISTER 0x10"), 16);
+  BOOST_CHECK_EQUAL(createBackend("@ASYNC_QUEUE_SIZE " + std::to_string(AsyncQueueStatistics::maxQueueSize)),
+      AsyncQueueStatistics::maxQueueSize);
+
+  // negative values must not wrap around to a huge queue
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE -1"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE:APP.REGISTER -5"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE 0"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE " + std::to_string(AsyncQueueStatistics::maxQueueSize + 1)),
+      ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE 5x"), ChimeraTK::logic_error);
+
+  // keys which only start with ASYNC_QUEUE_SIZE are not silently ignored
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZEX 5"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE_APP.REGISTER 5"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(createBackend("@ASYNC_QUEUE_SIZE:APP.UNKNOWN 5"), ChimeraTK::logic_error);
+
+  std::remove(mapFile.c_str());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSubscribeWhileTriggering) {
+  Device device(cdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(dummy);
+
+  auto permanent = device.getScalarRegisterAccessor<int32_t>("APP/LARGE_QUEUE", 0, {AccessMode::wait_for_new_data});
+  device.activateAsyncRead();
+  permanent.read(); // initial value
+
+  // Trigger the interrupt continuously. The value increases with each trigger.
+  std::atomic<bool> stop{false};
+  std::atomic<size_t> nTriggers{0};
+  auto triggering = std::async(std::launch::async, [&] {
+    for(int32_t value = 1; !stop; ++value) {
+      dummy->write(uint64_t(0), uint64_t(0x0), &value, sizeof(value));
+      dummy->triggerInterrupt(1);
+      ++nTriggers;
+    }
+  });
+
+  // Subscribe and unsubscribe while the interrupt is being dispatched. Boost.Test is not thread safe, so errors are
+  // only counted here.
+  std::atomic<size_t> nDecreasingValues{0};
+  std::atomic<size_t> nRemovedButAlive{0};
+  auto subscribing = std::async(std::launch::async, [&] {
+    for(size_t i = 0; i < 200; ++i) {
+      boost::weak_ptr<TransferElement> removed;
+      {
+        auto accessor =
+            device.getScalarRegisterAccessor<int32_t>("APP/DEFAULT_QUEUE", 0, {AccessMode::wait_for_new_data});
+        removed = accessor.getHighLevelImplElement();
+        accessor.read(); // initial value, sent during the subscription since async read is active
+        int32_t previous = accessor;
+        while(accessor.readNonBlocking()) {
+          nDecreasingValues += int32_t(accessor) < previous;
+          previous = accessor;
+        }
+      }
+      // The dispatcher must not keep a removed subscriber alive. It is only referenced by the dispatcher for the short
+      // time a value is put into its queue, so wait for this to complete if necessary.
+      for(size_t retry = 0; !removed.expired() && retry < 1000; ++retry) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      nRemovedButAlive += !removed.expired();
+    }
+  });
+
+  // Both threads are always waited for before the locals they use go out of scope, so the accessors and the backend
+  // are finally released by this thread and not by the one dispatching the interrupt. A deadlock blocks the test
+  // until the ctest timeout.
+  subscribing.wait();
+  stop = true;
+  triggering.wait();
+  subscribing.get();
+  triggering.get();
+  BOOST_CHECK_GT(nTriggers, 0);
+  BOOST_CHECK_EQUAL(nDecreasingValues, 0);
+  BOOST_CHECK_EQUAL(nRemovedButAlive, 0);
+
+  // the remaining subscriber is still served
+  while(permanent.readNonBlocking()) {
+  }
+  dummy->triggerInterrupt(1);
+  BOOST_CHECK(permanent.readNonBlocking());
+  BOOST_CHECK(!permanent.readNonBlocking());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
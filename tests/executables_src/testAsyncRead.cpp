@@ -72,6 +72,8 @@ class AsyncTestDummy : public DeviceBackendImpl {
     [[nodiscard]] bool isReadable() const override { return true; }
     [[nodiscard]] bool isWriteable() const override { return true; }
 
+    void wakeUpRead() override { this->wakeUpRead_impl(this->_readQueue); }
+
     std::vector<boost::shared_ptr<TransferElement>> getHardwareAccessingElements() override {
       return {this->shared_from_this()};
     }
@@ -538,6 +540,334 @@ BOOST_AUTO_TEST_CASE(testReadAnyWithPoll) {
 
 /**********************************************************************************************************************/
 
+BOOST_AUTO_TEST_CASE(testReadAnyBatch) {
+  std::cout << "testReadAnyBatch" << std::endl;
+
+  Device device;
+  device.open(cdd);
+  auto backend = boost::dynamic_pointer_cast<AsyncTestDummy>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_CHECK(backend != nullptr);
+
+  auto a1 = device.getScalarRegisterAccessor<int32_t>("a1", 0, {AccessMode::wait_for_new_data});
+  auto a2 = device.getScalarRegisterAccessor<int32_t>("a2", 0, {AccessMode::wait_for_new_data});
+  auto a3 = device.getScalarRegisterAccessor<int32_t>("a3");
+
+  backend->registers["/a1"] = 10;
+  backend->registers["/a2"] = 20;
+  backend->registers["/a3"] = 30;
+
+  ReadAnyGroup group{a1, a2, a3};
+
+  // all available updates are processed in one call, in the order of arrival
+  backend->notificationQueue["/a1"].push();
+  backend->notificationQueue["/a2"].push();
+  backend->notificationQueue["/a1"].push();
+  auto ids = group.readAnyBatch();
+  BOOST_REQUIRE_EQUAL(ids.size(), 3);
+  BOOST_CHECK(ids[0] == a1.getId());
+  BOOST_CHECK(ids[1] == a2.getId());
+  BOOST_CHECK(ids[2] == a1.getId());
+  BOOST_CHECK(a1 == 10);
+  BOOST_CHECK(a2 == 20);
+  BOOST_CHECK(a3 == 30);
+
+  // the number of processed updates is limited by maxCount, the remaining ones stay in the group
+  backend->registers["/a1"] = 11;
+  backend->registers["/a2"] = 21;
+  backend->notificationQueue["/a1"].push();
+  backend->notificationQueue["/a2"].push();
+  ids = group.readAnyBatch(1);
+  BOOST_REQUIRE_EQUAL(ids.size(), 1);
+  BOOST_CHECK(ids[0] == a1.getId());
+  BOOST_CHECK(a1 == 11);
+  BOOST_CHECK(a2 == 20);
+  BOOST_CHECK(group.readAnyNonBlocking() == a2.getId());
+  BOOST_CHECK(a2 == 21);
+
+  // the call blocks until the first update arrives
+  {
+    std::atomic<bool> flag{false};
+    std::thread thread([&group, &flag, &ids] {
+      ids = group.readAnyBatch();
+      flag = true;
+    });
+    usleep(100000);
+    BOOST_CHECK(flag == false);
+    backend->notificationQueue["/a2"].push();
+    thread.join();
+    BOOST_REQUIRE_EQUAL(ids.size(), 1);
+    BOOST_CHECK(ids[0] == a2.getId());
+  }
+
+  // with a deadline, an empty list is returned if no update arrives in time
+  auto start = std::chrono::steady_clock::now();
+  ids = group.readAnyBatch(10, start + std::chrono::milliseconds(50));
+  BOOST_CHECK(ids.empty());
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+
+  // the wake-up at the deadline is not visible as an update afterwards, and the elements keep their values
+  BOOST_CHECK(group.readAnyBatch(10, std::chrono::steady_clock::now()).empty());
+  BOOST_CHECK(group.readAnyNonBlocking() == TransferElementID());
+  BOOST_CHECK(a1 == 11);
+  BOOST_CHECK(a2 == 21);
+
+  // with a deadline, available updates are processed like without
+  backend->registers["/a1"] = 12;
+  backend->registers["/a3"] = 32;
+  backend->notificationQueue["/a1"].push();
+  backend->notificationQueue["/a2"].push();
+  ids = group.readAnyBatch(10, std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  BOOST_REQUIRE_EQUAL(ids.size(), 2);
+  BOOST_CHECK(ids[0] == a1.getId());
+  BOOST_CHECK(ids[1] == a2.getId());
+  BOOST_CHECK(a1 == 12);
+  BOOST_CHECK(a3 == 32);
+
+  // an exception of a later update does not lose the IDs of the updates processed before
+  backend->registers["/a2"] = 22;
+  backend->registers["/a3"] = 33;
+  backend->notificationQueue["/a2"].push();
+  try {
+    throw ChimeraTK::runtime_error("Test exception");
+  }
+  catch(...) {
+    backend->notificationQueue["/a1"].push_exception(std::current_exception());
+  }
+  backend->notificationQueue["/a2"].push();
+  ids = group.readAnyBatch();
+  BOOST_REQUIRE_EQUAL(ids.size(), 1);
+  BOOST_CHECK(ids[0] == a2.getId());
+  BOOST_CHECK(a2 == 22);
+  BOOST_CHECK(a3 == 32); // poll-type elements are not updated in this case
+
+  // the exception is thrown by the next call, the update behind it is processed afterwards
+  BOOST_CHECK_THROW(group.readAnyNonBlocking(), ChimeraTK::runtime_error);
+  BOOST_CHECK(group.readAnyNonBlocking() == a2.getId());
+  BOOST_CHECK(a3 == 33);
+
+  device.close();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadUntil) {
+  std::cout << "testReadUntil" << std::endl;
+
+  Device device;
+  device.open(cdd);
+  auto backend = boost::dynamic_pointer_cast<AsyncTestDummy>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_CHECK(backend != nullptr);
+
+  auto a1 = device.getScalarRegisterAccessor<int32_t>("a1", 0, {AccessMode::wait_for_new_data});
+  auto a2 = device.getScalarRegisterAccessor<int32_t>("a2", 0, {AccessMode::wait_for_new_data});
+  auto a3 = device.getScalarRegisterAccessor<int32_t>("a3");
+
+  backend->registers["/a1"] = 10;
+  backend->registers["/a2"] = 20;
+  backend->registers["/a3"] = 30;
+
+  // single accessor: returns false after the deadline without an update
+  auto start = std::chrono::steady_clock::now();
+  BOOST_CHECK(!a1.readUntil(start + std::chrono::milliseconds(50)));
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+  BOOST_CHECK(a1 == 0);
+
+  // single accessor: returns true as soon as the update arrives
+  {
+    std::thread thread([&backend] {
+      usleep(50000);
+      backend->notificationQueue["/a1"].push();
+    });
+    BOOST_CHECK(a1.readUntil(std::chrono::steady_clock::now() + std::chrono::seconds(10)));
+    BOOST_CHECK(a1 == 10);
+    thread.join();
+  }
+
+  // poll-type accessors are read synchronously
+  BOOST_CHECK(a3.readUntil(std::chrono::steady_clock::now()));
+  BOOST_CHECK(a3 == 30);
+
+  ReadAnyGroup group{a1, a2, a3};
+  backend->registers["/a3"] = 31;
+
+  // group: a default-constructed ID is returned after the deadline, poll-type elements are not updated
+  start = std::chrono::steady_clock::now();
+  BOOST_CHECK(group.readAnyUntil(start + std::chrono::milliseconds(50)) == TransferElementID());
+  BOOST_CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50));
+  BOOST_CHECK(a3 == 30);
+
+  // group: already available updates are returned even if the deadline has passed
+  backend->notificationQueue["/a2"].push();
+  BOOST_CHECK(group.readAnyUntil(std::chrono::steady_clock::now()) == a2.getId());
+  BOOST_CHECK(a2 == 20);
+  BOOST_CHECK(a3 == 31);
+
+  // group: returns as soon as the update arrives
+  {
+    backend->registers["/a1"] = 11;
+    std::thread thread([&backend] {
+      usleep(50000);
+      backend->notificationQueue["/a1"].push();
+    });
+    BOOST_CHECK(group.readAnyUntil(std::chrono::steady_clock::now() + std::chrono::seconds(10)) == a1.getId());
+    BOOST_CHECK(a1 == 11);
+    thread.join();
+  }
+
+  device.close();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadAnyPriority) {
+  std::cout << "testReadAnyPriority" << std::endl;
+
+  Device device;
+  device.open(cdd);
+  auto backend = boost::dynamic_pointer_cast<AsyncTestDummy>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_CHECK(backend != nullptr);
+
+  auto low = device.getScalarRegisterAccessor<int32_t>("low", 0, {AccessMode::wait_for_new_data});
+  auto high1 = device.getScalarRegisterAccessor<int32_t>("high1", 0, {AccessMode::wait_for_new_data});
+  auto high2 = device.getScalarRegisterAccessor<int32_t>("high2", 0, {AccessMode::wait_for_new_data});
+  auto medium = device.getScalarRegisterAccessor<int32_t>("medium", 0, {AccessMode::wait_for_new_data});
+
+  backend->registers["/low"] = 1;
+  backend->registers["/high1"] = 2;
+  backend->registers["/high2"] = 3;
+  backend->registers["/medium"] = 4;
+
+  ReadAnyGroup group;
+  group.add(low);
+  group.add(high1, 10);
+  group.add(high2, 10);
+  group.add(medium, 5);
+  group.finalise();
+
+  // the highest priority is served first, same priorities in the order of arrival
+  backend->notificationQueue["/low"].push();
+  backend->notificationQueue["/medium"].push();
+  backend->notificationQueue["/high2"].push();
+  backend->notificationQueue["/low"].push();
+  backend->notificationQueue["/high1"].push();
+  BOOST_CHECK(group.readAny() == high2.getId());
+  BOOST_CHECK(group.readAny() == high1.getId());
+  BOOST_CHECK(group.readAny() == medium.getId());
+  BOOST_CHECK(group.readAny() == low.getId());
+  BOOST_CHECK(group.readAnyNonBlocking() == low.getId());
+  BOOST_CHECK(group.readAnyNonBlocking() == TransferElementID());
+  BOOST_CHECK(low == 1);
+  BOOST_CHECK(high1 == 2);
+  BOOST_CHECK(high2 == 3);
+  BOOST_CHECK(medium == 4);
+
+  // starvation protection: after the limit, the oldest pending update is served
+  group.setStarvationLimit(4);
+  backend->notificationQueue["/low"].push();
+  for(size_t i = 0; i < 3; ++i) {
+    backend->notificationQueue["/high1"].push();
+    backend->notificationQueue["/high2"].push();
+  }
+  for(size_t i = 0; i < 4; ++i) {
+    BOOST_CHECK(group.readAny() != low.getId());
+  }
+  BOOST_CHECK(group.readAny() == low.getId());
+  BOOST_CHECK(group.readAny() != low.getId());
+  BOOST_CHECK(group.readAny() != low.getId());
+  BOOST_CHECK(group.readAnyNonBlocking() == TransferElementID());
+
+  device.close();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadAnyPriorityLatency) {
+  std::cout << "testReadAnyPriorityLatency" << std::endl;
+
+  Device device;
+  device.open(cdd);
+  auto backend = boost::dynamic_pointer_cast<AsyncTestDummy>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_CHECK(backend != nullptr);
+
+  auto diag1 = device.getScalarRegisterAccessor<int32_t>("diag1", 0, {AccessMode::wait_for_new_data});
+  auto diag2 = device.getScalarRegisterAccessor<int32_t>("diag2", 0, {AccessMode::wait_for_new_data});
+  auto interlock = device.getScalarRegisterAccessor<int32_t>("interlock", 0, {AccessMode::wait_for_new_data});
+
+  backend->registers["/diag1"] = 1;
+  backend->registers["/diag2"] = 2;
+  backend->registers["/interlock"] = 3;
+
+  ReadAnyGroup group;
+  group.add(diag1);
+  group.add(diag2);
+  group.add(interlock, 1);
+  group.finalise();
+
+  // flood the group with diagnostic updates
+  std::atomic<bool> stop{false};
+  std::thread flooder([&] {
+    auto q1 = backend->notificationQueue.at("/diag1");
+    auto q2 = backend->notificationQueue.at("/diag2");
+    while(!stop) {
+      q1.push();
+      q2.push();
+      std::this_thread::yield();
+    }
+  });
+
+  // send interlock updates while the flood is running. The flag is set only after the push, so the update is already
+  // queued in the group when the reader sees the flag.
+  constexpr size_t nInterlocks = 20;
+  std::atomic<std::chrono::steady_clock::time_point> sendTime{};
+  std::atomic<bool> interlockPushed{false};
+  std::thread sender([&] {
+    auto q = backend->notificationQueue.at("/interlock");
+    for(size_t i = 0; i < nInterlocks; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      sendTime = std::chrono::steady_clock::now();
+      q.push();
+      interlockPushed = true;
+      while(interlockPushed) std::this_thread::yield();
+    }
+  });
+
+  // Count on the reader side how many diagnostic updates are returned by readAny() calls which have been started after
+  // the interlock update was pushed.
+  size_t nDiagnostics = 0;
+  size_t diagnosticsAhead = 0;
+  std::chrono::steady_clock::duration maxLatency{};
+  for(size_t received = 0; received < nInterlocks;) {
+    bool pushedBefore = interlockPushed;
+    auto id = group.readAny();
+    if(id == interlock.getId()) {
+      maxLatency = std::max(maxLatency, std::chrono::steady_clock::now() - sendTime.load());
+      interlockPushed = false;
+      ++received;
+    }
+    else {
+      ++nDiagnostics;
+      if(pushedBefore) {
+        ++diagnosticsAhead;
+      }
+    }
+  }
+  stop = true;
+  sender.join();
+  flooder.join();
+
+  std::cout << "  diagnostic updates processed: " << nDiagnostics << std::endl;
+  std::cout << "  max. interlock latency: "
+            << std::chrono::duration_cast<std::chrono::microseconds>(maxLatency).count() << " us" << std::endl;
+
+  // A pending interlock update is always served first. The starvation limit (default 100) is not reached with
+  // nInterlocks updates.
+  BOOST_CHECK_EQUAL(diagnosticsAhead, 0);
+
+  device.close();
+}
+
+/**********************************************************************************************************************/
+
 BOOST_AUTO_TEST_CASE(testWaitAny) {
   std::cout << "testWaitAny" << std::endl;
 
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE AsyncTransferTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackendBase.h"
+#include "TransferGroup.h"
+
+#include <tuple>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(AsyncTransferTestSuite)
+
+static const std::string cdd{"(ExceptionDummy?map=pollScheduler.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadWrite) {
+  Device device(cdd);
+  device.open();
+
+  auto writeA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  writeA = 17;
+  auto writeDone = writeA.writeAsyncTransfer();
+  bool previousDataLost = true;
+  writeDone.pop_wait(previousDataLost);
+  BOOST_CHECK(!previousDataLost);
+
+  // many reads in flight at the same time
+  std::vector<ScalarRegisterAccessor<int32_t>> accessors;
+  std::vector<cppext::future_queue<void>> readsDone;
+  for(size_t i = 0; i < 100; ++i) {
+    accessors.push_back(device.getScalarRegisterAccessor<int32_t>("APP/A"));
+  }
+  for(auto& accessor : accessors) {
+    readsDone.push_back(accessor.readAsyncTransfer());
+  }
+  for(size_t i = 0; i < accessors.size(); ++i) {
+    readsDone[i].pop_wait();
+    BOOST_CHECK_EQUAL(int32_t(accessors[i]), 17);
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testExceptions) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<DummyBackendBase>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+
+  // runtime errors are delivered through the queue
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  backend->throwExceptionRead = true;
+  auto done = accessor.readAsyncTransfer();
+  BOOST_CHECK_THROW(done.pop_wait(), ChimeraTK::runtime_error);
+  backend->throwExceptionRead = false;
+  device.open();
+
+  // so are logic errors
+  device.close();
+  done = accessor.readAsyncTransfer();
+  BOOST_CHECK_THROW(done.pop_wait(), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testWaitForNewDataNotSupported) {
+  Device device("(dummy?map=timerInterrupt.map)");
+  device.open();
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/STATUS", 0, {AccessMode::wait_for_new_data});
+  BOOST_CHECK_THROW(std::ignore = accessor.readAsyncTransfer(), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTransferGroup) {
+  Device device(cdd);
+  device.open();
+
+  auto a = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto b = device.getScalarRegisterAccessor<int32_t>("APP/B");
+  auto readA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto readB = device.getScalarRegisterAccessor<int32_t>("APP/B");
+
+  {
+    TransferGroup group;
+    group.addAccessor(a);
+    group.addAccessor(b);
+    a = 3;
+    b = 4;
+    group.writeAsyncTransfer().pop_wait();
+    readA.read();
+    readB.read();
+    BOOST_CHECK_EQUAL(int32_t(readA), 3);
+    BOOST_CHECK_EQUAL(int32_t(readB), 4);
+
+    readA = 5;
+    readA.write();
+    auto done = group.readAsyncTransfer();
+    done.pop_wait();
+    BOOST_CHECK_EQUAL(int32_t(a), 5);
+
+    // the destructor waits for a transfer which is still in progress
+    std::ignore = group.readAsyncTransfer();
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testPoolPerBackend) {
+  auto backend = BackendFactory::getInstance().createBackend(cdd);
+  auto otherBackend = BackendFactory::getInstance().createBackend("(dummy?map=timerInterrupt.map)");
+  BOOST_CHECK(&backend->getAsyncTransferPool() == &backend->getAsyncTransferPool());
+  BOOST_CHECK(&backend->getAsyncTransferPool() != &otherBackend->getAsyncTransferPool());
+  BOOST_CHECK(&backend->getAsyncTransferPool() != &AsyncTransferPool::getDefault());
+  BOOST_CHECK_EQUAL(backend->getAsyncTransferPool().getNumberOfThreads(), 2);
+  BOOST_CHECK_THROW(AsyncTransferPool(0), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CatalogueCacheTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "CatalogueCache.h"
+#include "LNMBackendRegisterInfo.h"
+#include "LogicalNameMapParser.h"
+#include "MapFileParser.h"
+#include "StreamMapFileParser.h"
+
+#include <filesystem>
+#include <fstream>
+#include <typeinfo>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(CatalogueCacheTestSuite)
+
+static const std::string cacheDirectory{"catalogueCacheTest"};
+
+/**********************************************************************************************************************/
+
+struct Fixture {
+  Fixture() {
+    std::filesystem::remove_all(cacheDirectory);
+    CatalogueCache::setLocation(CatalogueCache::Location::cacheDirectory, cacheDirectory);
+  }
+
+  ~Fixture() { CatalogueCache::setLocation(CatalogueCache::Location::disabled); }
+};
+
+/**********************************************************************************************************************/
+
+std::vector<std::filesystem::path> getCacheFiles(const std::string& directory, const std::string& extension) {
+  std::vector<std::filesystem::path> files;
+  for(const auto& entry : std::filesystem::directory_iterator(directory)) {
+    if(entry.path().extension() == extension) files.push_back(entry.path());
+  }
+  return files;
+}
+
+/**********************************************************************************************************************/
+
+// Set the modification time of the file into the past. A cache hit does not touch the cache file, while a cache miss
+// writes it again, which is detected by the modification time.
+std::filesystem::file_time_type makeOld(const std::filesystem::path& file) {
+  auto time = std::filesystem::last_write_time(file) - std::chrono::hours(1);
+  std::filesystem::last_write_time(file, time);
+  return time;
+}
+
+/**********************************************************************************************************************/
+
+void compareCatalogues(const std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>& a,
+    const std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue>& b) {
+  BOOST_REQUIRE_EQUAL(a.first.getNumberOfRegisters(), b.first.getNumberOfRegisters());
+  auto itB = b.first.begin();
+  for(const auto& info : a.first) {
+    BOOST_CHECK(info == *itB);
+    BOOST_CHECK(info.getDataDescriptor() == itB->getDataDescriptor());
+    ++itB;
+  }
+  BOOST_CHECK(a.first.getListOfInterrupts() == b.first.getListOfInterrupts());
+  BOOST_REQUIRE_EQUAL(a.second.getNumberOfMetadata(), b.second.getNumberOfMetadata());
+  for(auto it = a.second.cbegin(); it != a.second.cend(); ++it) {
+    BOOST_CHECK_EQUAL(b.second.getMetadata(it->first), it->second);
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testMapFile, Fixture) {
+  for(const auto* mapFile : {"goodMapFile.map", "interruptMapFile.map", "nestedInterrupts.map", "asyncQueueSize.map",
+          "muxedDataAcessor.map", "newSequences.mapp"}) {
+    BOOST_TEST_CONTEXT(mapFile) {
+      auto reference = StreamMapFileParser().parseWithStreams(mapFile);
+
+      // cache miss: the file is parsed and the cache file is written
+      compareCatalogues(MapFileParser().parse(mapFile), reference);
+      auto cacheFiles = getCacheFiles(cacheDirectory, ".mapcache");
+      BOOST_REQUIRE_EQUAL(cacheFiles.size(), 1);
+      auto time = makeOld(cacheFiles[0]);
+
+      // cache hit
+      compareCatalogues(MapFileParser().parse(mapFile), reference);
+      BOOST_CHECK(std::filesystem::last_write_time(cacheFiles[0]) == time);
+
+      std::filesystem::remove_all(cacheDirectory);
+    }
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testMapFileChanged, Fixture) {
+  const std::string mapFile{"catalogueCacheTest.map"};
+  std::filesystem::copy_file("goodMapFile.map", mapFile, std::filesystem::copy_options::overwrite_existing);
+  auto original = MapFileParser().parse(mapFile);
+
+  auto originalCacheFiles = getCacheFiles(cacheDirectory, ".mapcache");
+  BOOST_REQUIRE_EQUAL(originalCacheFiles.size(), 1);
+
+  // a changed map file results in a different cache file, which replaces the old one
+  std::ofstream(mapFile, std::ios::app) << "ADDED_REGISTER 1 0x100 4 0\n";
+  auto changed = MapFileParser().parse(mapFile);
+  BOOST_CHECK_EQUAL(changed.first.getNumberOfRegisters(), original.first.getNumberOfRegisters() + 1);
+  BOOST_CHECK(changed.first.hasRegister("ADDED_REGISTER"));
+  auto changedCacheFiles = getCacheFiles(cacheDirectory, ".mapcache");
+  BOOST_REQUIRE_EQUAL(changedCacheFiles.size(), 1);
+  BOOST_CHECK(changedCacheFiles[0] != originalCacheFiles[0]);
+
+  compareCatalogues(MapFileParser().parse(mapFile), StreamMapFileParser().parseWithStreams(mapFile));
+
+  // a file with the same name in another directory is a different source file, its cache file is kept separately
+  std::filesystem::create_directories(cacheDirectory + "/other");
+  const std::string otherMapFile{cacheDirectory + "/other/" + mapFile};
+  std::filesystem::copy_file("goodMapFile.map", otherMapFile);
+  compareCatalogues(MapFileParser().parse(otherMapFile), StreamMapFileParser().parseWithStreams(otherMapFile));
+  BOOST_CHECK_EQUAL(getCacheFiles(cacheDirectory, ".mapcache").size(), 2);
+  std::ofstream(otherMapFile, std::ios::app) << "ADDED_REGISTER 1 0x100 4 0\n";
+  std::ignore = MapFileParser().parse(otherMapFile);
+  BOOST_CHECK_EQUAL(getCacheFiles(cacheDirectory, ".mapcache").size(), 2);
+  BOOST_CHECK(std::filesystem::exists(changedCacheFiles[0]));
+
+  std::filesystem::remove(mapFile);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testCorruptCacheFile, Fixture) {
+  auto reference = StreamMapFileParser().parseWithStreams("goodMapFile.map");
+  std::ignore = MapFileParser().parse("goodMapFile.map");
+  auto cacheFile = getCacheFiles(cacheDirectory, ".mapcache").at(0);
+  auto size = std::filesystem::file_size(cacheFile);
+
+  // truncated file: the map file is parsed again and the cache file is replaced
+  std::filesystem::resize_file(cacheFile, size / 2);
+  compareCatalogues(MapFileParser().parse("goodMapFile.map"), reference);
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(cacheFile), size);
+
+  // overwritten content
+  {
+    std::fstream file(cacheFile, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(size / 2));
+    std::string garbage(size / 4, '\xff');
+    file.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+  }
+  compareCatalogues(MapFileParser().parse("goodMapFile.map"), reference);
+
+  // wrong header
+  std::ofstream(cacheFile, std::ios::trunc) << "not a cache file";
+  compareCatalogues(MapFileParser().parse("goodMapFile.map"), reference);
+  BOOST_CHECK_EQUAL(std::filesystem::file_size(cacheFile), size);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testSourceDirectory, Fixture) {
+  std::filesystem::create_directories(cacheDirectory + "/source");
+  const std::string mapFile{cacheDirectory + "/source/test.map"};
+  std::filesystem::copy_file("goodMapFile.map", mapFile);
+  CatalogueCache::setLocation(CatalogueCache::Location::sourceDirectory);
+
+  auto reference = StreamMapFileParser().parseWithStreams(mapFile);
+  compareCatalogues(MapFileParser().parse(mapFile), reference);
+  BOOST_REQUIRE(std::filesystem::exists(cacheDirectory + "/source/.test.map.mapcache"));
+  auto time = makeOld(cacheDirectory + "/source/.test.map.mapcache");
+  compareCatalogues(MapFileParser().parse(mapFile), reference);
+  BOOST_CHECK(std::filesystem::last_write_time(cacheDirectory + "/source/.test.map.mapcache") == time);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testDisabled, Fixture) {
+  CatalogueCache::setLocation(CatalogueCache::Location::disabled);
+  BOOST_CHECK(!CatalogueCache::isEnabled());
+  BOOST_CHECK_EQUAL(CatalogueCache::getCacheFileName("goodMapFile.map", 0, "mapcache"), "");
+  std::ignore = MapFileParser().parse("goodMapFile.map");
+  BOOST_CHECK(!std::filesystem::exists(cacheDirectory));
+
+  BOOST_CHECK_THROW(CatalogueCache::setLocation(CatalogueCache::Location::cacheDirectory), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+void compareCatalogues(const BackendRegisterCatalogue<LNMBackendRegisterInfo>& a,
+    std::map<std::string, LNMVariable>& variablesA, const BackendRegisterCatalogue<LNMBackendRegisterInfo>& b,
+    std::map<std::string, LNMVariable>& variablesB) {
+  BOOST_REQUIRE_EQUAL(a.getNumberOfRegisters(), b.getNumberOfRegisters());
+  auto itB = b.begin();
+  for(const auto& info : a) {
+    BOOST_TEST_CONTEXT(info.name) {
+      BOOST_CHECK_EQUAL(info.name, itB->name);
+      BOOST_CHECK_EQUAL(info.targetType, itB->targetType);
+      BOOST_CHECK_EQUAL(info.deviceName, itB->deviceName);
+      BOOST_CHECK_EQUAL(info.registerName, itB->registerName);
+      BOOST_CHECK_EQUAL(info.firstIndex, itB->firstIndex);
+      BOOST_CHECK_EQUAL(info.length, itB->length);
+      BOOST_CHECK_EQUAL(info.channel, itB->channel);
+      BOOST_CHECK_EQUAL(info.bit, itB->bit);
+      BOOST_CHECK_EQUAL(info.nChannels, itB->nChannels);
+      BOOST_CHECK(info.valueType == itB->valueType);
+      BOOST_CHECK_EQUAL(info.readable, itB->readable);
+      BOOST_CHECK_EQUAL(info.writeable, itB->writeable);
+      BOOST_CHECK(info.supportedFlags == itB->supportedFlags);
+      BOOST_CHECK(info._dataDescriptor == itB->_dataDescriptor);
+      BOOST_CHECK_EQUAL(info.plugins.size(), itB->plugins.size());
+      for(size_t i = 0; i < info.plugins.size() && i < itB->plugins.size(); ++i) {
+        BOOST_CHECK(typeid(*info.plugins[i]) == typeid(*itB->plugins[i]));
+      }
+    }
+    ++itB;
+  }
+
+  BOOST_REQUIRE_EQUAL(variablesA.size(), variablesB.size());
+  for(auto& [name, variable] : variablesA) {
+    auto& other = variablesB.at(name);
+    BOOST_CHECK(variable.valueType == other.valueType);
+    BOOST_CHECK_EQUAL(variable.isConstant, other.isConstant);
+    callForType(variable.valueType, [&](auto arg) {
+      const auto& values = boost::fusion::at_key<decltype(arg)>(variable.valueTable.table).latestValue;
+      const auto& otherValues = boost::fusion::at_key<decltype(arg)>(other.valueTable.table).latestValue;
+      BOOST_CHECK_EQUAL(values.size(), otherValues.size());
+      if constexpr(!std::is_same_v<decltype(arg), Void>) {
+        BOOST_CHECK(values == otherValues);
+      }
+    });
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testXlmapFile, Fixture) {
+  for(const auto* xlmapFile : {"valid.xlmap", "mathPlugin.xlmap", "doubleBuffer.xlmap"}) {
+    BOOST_TEST_CONTEXT(xlmapFile) {
+      std::map<std::string, std::string> parameters{{"target", "TARGET"}, {"ParamA", "A"}, {"ParamB", "B"}};
+
+      CatalogueCache::setLocation(CatalogueCache::Location::disabled);
+      std::map<std::string, LNMVariable> referenceVariables;
+      auto reference = LogicalNameMapParser(parameters, referenceVariables).parseFile(xlmapFile);
+      CatalogueCache::setLocation(CatalogueCache::Location::cacheDirectory, cacheDirectory);
+
+      // cache miss
+      std::map<std::string, LNMVariable> variables;
+      auto catalogue = LogicalNameMapParser(parameters, variables).parseFile(xlmapFile);
+      compareCatalogues(catalogue, variables, reference, referenceVariables);
+      auto cacheFiles = getCacheFiles(cacheDirectory, ".xlmapcache");
+      BOOST_REQUIRE_EQUAL(cacheFiles.size(), 1);
+      auto time = makeOld(cacheFiles[0]);
+
+      // cache hit
+      std::map<std::string, LNMVariable> cachedVariables;
+      auto cached = LogicalNameMapParser(parameters, cachedVariables).parseFile(xlmapFile);
+      compareCatalogues(cached, cachedVariables, reference, referenceVariables);
+      BOOST_CHECK(std::filesystem::last_write_time(cacheFiles[0]) == time);
+
+      std::filesystem::remove_all(cacheDirectory);
+    }
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testXlmapParameters, Fixture) {
+  // the parameters are resolved while parsing, hence they are part of the cache key
+  std::map<std::string, LNMVariable> variables;
+  const std::string xlmapFile{"withParams.xlmap"};
+  auto catalogueA = LogicalNameMapParser({{"ParamA", "DEV1"}, {"ParamB", "REG1"}}, variables).parseFile(xlmapFile);
+  auto catalogueB = LogicalNameMapParser({{"ParamA", "DEV2"}, {"ParamB", "REG1"}}, variables).parseFile(xlmapFile);
+  BOOST_CHECK_EQUAL(getCacheFiles(cacheDirectory, ".xlmapcache").size(), 2);
+
+  auto cached = LogicalNameMapParser({{"ParamA", "DEV2"}, {"ParamB", "REG1"}}, variables).parseFile(xlmapFile);
+  BOOST_CHECK_EQUAL(catalogueA.getBackendRegister("SingleWordWithParams").deviceName, "DEV1");
+  BOOST_CHECK_EQUAL(catalogueB.getBackendRegister("SingleWordWithParams").deviceName, "DEV2");
+  BOOST_CHECK_EQUAL(cached.getBackendRegister("SingleWordWithParams").deviceName, "DEV2");
+  BOOST_CHECK_EQUAL(cached.getBackendRegister("SingleWordWithParams").registerName, "REG1");
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
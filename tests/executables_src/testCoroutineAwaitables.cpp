@@ -0,0 +1,323 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE CoroutineAwaitablesTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#if defined(__cpp_impl_coroutine) && __cplusplus >= 202002L
+
+#  include "BackendFactory.h"
+#  include "CoroutineAwaitables.h"
+#  include "Device.h"
+#  include "DummyBackend.h"
+#  include "waitFor.h"
+
+#  include <atomic>
+#  include <chrono>
+#  include <condition_variable>
+#  include <deque>
+#  include <future>
+#  include <thread>
+#  include <vector>
+
+using namespace ChimeraTK;
+
+/**********************************************************************************************************************/
+
+/**
+ * Simple executor running the posted jobs in a single thread.
+ */
+class Executor {
+ public:
+  Executor() : _thread([this] { run(); }) {}
+
+  ~Executor() {
+    post({});
+    _thread.join();
+  }
+
+  void post(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _jobs.push_back(std::move(job));
+    }
+    _condition.notify_one();
+  }
+
+  /** co_await executor.schedule() continues the coroutine in the executor thread. */
+  auto schedule() {
+    struct Awaiter {
+      Executor& executor;
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<> handle) { executor.post([handle] { handle.resume(); }); }
+      void await_resume() const noexcept {}
+    };
+    return Awaiter{*this};
+  }
+
+  [[nodiscard]] std::thread::id getThreadId() const { return _thread.get_id(); }
+
+ private:
+  void run() {
+    while(true) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _condition.wait(lock, [&] { return !_jobs.empty(); });
+        job = std::move(_jobs.front());
+        _jobs.pop_front();
+      }
+      if(!job) return;
+      job();
+    }
+  }
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::function<void()>> _jobs;
+  std::thread _thread;
+};
+
+/**********************************************************************************************************************/
+
+/**
+ * Eagerly started coroutine. The result (or exception) is available through the future.
+ */
+struct Task {
+  struct promise_type {
+    std::promise<void> promise;
+    Task get_return_object() { return Task{promise.get_future()}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() { promise.set_value(); }
+    void unhandled_exception() { promise.set_exception(std::current_exception()); }
+  };
+
+  std::future<void> result;
+};
+
+/**
+ * Eagerly started coroutine which is owned by the caller. It must be destroyed through the handle.
+ */
+struct OwnedTask {
+  struct promise_type {
+    OwnedTask get_return_object() { return OwnedTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() {}
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE(CoroutineAwaitablesTestSuite)
+
+static const std::string cdd{"(ExceptionDummy?map=pollScheduler.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testReadWrite) {
+  Device device(cdd);
+  device.open();
+  auto writeA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto readA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+
+  Executor executor;
+  bool previousDataLost = true;
+  bool resumedInExecutor = false;
+  auto task = [&]() -> Task {
+    co_await executor.schedule();
+    writeA = 42;
+    previousDataLost = co_await awaitWrite(writeA);
+    co_await awaitRead(readA);
+    co_await executor.schedule();
+    resumedInExecutor = (std::this_thread::get_id() == executor.getThreadId());
+  }();
+  task.result.get();
+
+  BOOST_CHECK(!previousDataLost);
+  BOOST_CHECK_EQUAL(int32_t(readA), 42);
+  BOOST_CHECK(resumedInExecutor);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testExceptions) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<DummyBackendBase>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/A");
+
+  Executor executor;
+  backend->throwExceptionRead = true;
+  auto task = [&]() -> Task {
+    co_await executor.schedule();
+    co_await awaitRead(accessor);
+  }();
+  BOOST_CHECK_THROW(task.result.get(), ChimeraTK::runtime_error);
+  backend->throwExceptionRead = false;
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTransferGroup) {
+  Device device(cdd);
+  device.open();
+  auto a = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto b = device.getScalarRegisterAccessor<int32_t>("APP/B");
+  auto readA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto readB = device.getScalarRegisterAccessor<int32_t>("APP/B");
+  TransferGroup writeGroup;
+  writeGroup.addAccessor(a);
+  writeGroup.addAccessor(b);
+  TransferGroup readGroup;
+  readGroup.addAccessor(readA);
+  readGroup.addAccessor(readB);
+
+  Executor executor;
+  auto task = [&]() -> Task {
+    co_await executor.schedule();
+    a = 3;
+    b = 4;
+    co_await awaitWrite(writeGroup);
+    co_await awaitRead(readGroup);
+  }();
+  task.result.get();
+
+  BOOST_CHECK_EQUAL(int32_t(readA), 3);
+  BOOST_CHECK_EQUAL(int32_t(readB), 4);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testPushTypeAndReadAny) {
+  const std::string interruptCdd{"(dummy?map=interruptTimestamp.map)"};
+  Device device(interruptCdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(interruptCdd));
+  BOOST_REQUIRE(dummy);
+
+  auto data = device.getScalarRegisterAccessor<int32_t>("APP/DATA");
+  auto data1 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_1", 0, {AccessMode::wait_for_new_data});
+  auto data3 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_3", 0, {AccessMode::wait_for_new_data});
+  device.activateAsyncRead();
+  data1.read();
+
+  Executor executor;
+  std::promise<void> waiting;
+  TransferElementID updatedId;
+  auto task = [&]() -> Task {
+    co_await executor.schedule();
+    // the initial value is usually there already, so this completes without suspending
+    co_await awaitRead(data3);
+    waiting.set_value();
+    co_await awaitRead(data3);
+
+    ReadAnyGroup group{data1, data3};
+    updatedId = co_await awaitReadAny(group);
+  }();
+
+  // the executor thread is not blocked while the coroutine waits for the interrupt
+  waiting.get_future().get();
+  std::promise<void> jobDone;
+  executor.post([&] { jobDone.set_value(); });
+  jobDone.get_future().get();
+
+  data = 42;
+  data.write();
+  dummy->triggerInterrupt(3);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  dummy->triggerInterrupt(3);
+  task.result.get();
+
+  BOOST_CHECK_EQUAL(int32_t(data3), 42);
+  BOOST_CHECK(updatedId == data3.getId());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testCancel) {
+  const std::string interruptCdd{"(dummy?map=interruptTimestamp.map)"};
+  Device device(interruptCdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(interruptCdd));
+  BOOST_REQUIRE(dummy);
+
+  auto data3 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_3", 0, {AccessMode::wait_for_new_data});
+  device.activateAsyncRead();
+  data3.read();
+
+  // The coroutine runs in this thread until it is suspended in the co_await.
+  std::atomic<bool> resumed{false};
+  auto task = [&]() -> OwnedTask {
+    co_await awaitRead(data3);
+    resumed = true;
+  }();
+  BOOST_CHECK(!resumed);
+
+  // Destroying the suspended coroutine cancels the wait: the coroutine is not resumed and the update is not consumed.
+  task.handle.destroy();
+  dummy->triggerInterrupt(3);
+  BOOST_CHECK(waitFor([&] { return data3.readNonBlocking(); }));
+  BOOST_CHECK(!resumed);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testResumeFromDispatcher) {
+  const std::string interruptCdd{"(dummy?map=interruptTimestamp.map)"};
+  Device device(interruptCdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(interruptCdd));
+  BOOST_REQUIRE(dummy);
+
+  // more waiting accessors than the AsyncTransferPool has threads
+  std::vector<ScalarRegisterAccessor<int32_t>> accessors;
+  for(size_t i = 0; i < 2 * dummy->getAsyncTransferPool().getNumberOfThreads(); ++i) {
+    accessors.push_back(device.getScalarRegisterAccessor<int32_t>("APP/DATA_3", 0, {AccessMode::wait_for_new_data}));
+  }
+  device.activateAsyncRead();
+  for(auto& accessor : accessors) {
+    accessor.read();
+  }
+
+  std::vector<std::thread::id> resumedIn;
+  auto awaitUpdate = [&](ScalarRegisterAccessor<int32_t>& accessor) -> Task {
+    co_await awaitRead(accessor);
+    resumedIn.push_back(std::this_thread::get_id());
+  };
+  std::vector<Task> tasks;
+  for(auto& accessor : accessors) {
+    tasks.push_back(awaitUpdate(accessor));
+  }
+  BOOST_CHECK(resumedIn.empty());
+
+  // The DummyBackend dispatches the interrupt in the calling thread, so all coroutines have been resumed from this
+  // thread before triggerInterrupt() returns.
+  dummy->triggerInterrupt(3);
+  BOOST_CHECK_EQUAL(resumedIn.size(), accessors.size());
+  for(auto& id : resumedIn) {
+    BOOST_CHECK(id == std::this_thread::get_id());
+  }
+  for(auto& task : tasks) {
+    task.result.get();
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#else
+
+BOOST_AUTO_TEST_CASE(testCoroutinesNotSupported) {
+  BOOST_TEST_MESSAGE("Compiler without C++20 coroutine support, CoroutineAwaitables.h is not tested.");
+}
+
+#endif
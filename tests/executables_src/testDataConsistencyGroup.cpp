@@ -9,6 +9,9 @@ using namespace boost::unit_test_framework;
 #include "DataConsistencyGroup.h"
 #include "Device.h"
 #include "NDRegisterAccessor.h"
+#include "ScalarRegisterAccessor.h"
+
+#include <deque>
 
 using namespace ChimeraTK;
 
@@ -50,6 +53,31 @@ class Accessor : public NDRegisterAccessor<UserType> {
   //  VersionNumber currentVersion;
 };
 
+// Accessor which receives the values pushed by the test through its _readQueue
+template<typename UserType>
+class PushAccessor : public Accessor<UserType> {
+ public:
+  PushAccessor() {
+    this->_readQueue = cppext::future_queue<void>(10);
+    this->buffer_2D.resize(1);
+    this->buffer_2D[0].resize(1);
+  }
+
+  void push(UserType value, VersionNumber version) {
+    values.emplace_back(value, version);
+    this->_readQueue.push();
+  }
+
+  void doPostRead(TransferType, bool hasNewData) override {
+    if(!hasNewData) return;
+    this->buffer_2D[0][0] = values.front().first;
+    this->_versionNumber = values.front().second;
+    values.pop_front();
+  }
+
+  std::deque<std::pair<UserType, VersionNumber>> values;
+};
+
 BOOST_AUTO_TEST_CASE(testDataConsistencyGroup) {
   boost::shared_ptr<Accessor<int>> acc_1 = boost::make_shared<Accessor<int>>();
   boost::shared_ptr<Accessor<int>> acc_2 = boost::make_shared<Accessor<int>>();
@@ -181,4 +209,131 @@ BOOST_AUTO_TEST_CASE(testException) {
   BOOST_CHECK_THROW(dcgroup.add(acc), ChimeraTK::logic_error);
 }
 
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testHistorized) {
+  auto impl1 = boost::make_shared<PushAccessor<int>>();
+  auto impl2 = boost::make_shared<PushAccessor<int>>();
+  auto impl3 = boost::make_shared<PushAccessor<int>>();
+  ScalarRegisterAccessor<int> acc1(impl1);
+  ScalarRegisterAccessor<int> acc2(impl2);
+  ScalarRegisterAccessor<int> acc3(impl3);
+
+  DataConsistencyGroup dcgroup;
+  dcgroup.setMatchingMode(DataConsistencyGroup::MatchingMode::historized);
+  dcgroup.setHistoryLength(3);
+  dcgroup.add(acc1);
+  dcgroup.add(acc2);
+  dcgroup.add(acc3);
+  BOOST_CHECK(acc1.getId() == impl1->getId());
+
+  // elements must be passed as non-const reference, and the mode cannot be changed any more
+  BOOST_CHECK_THROW(dcgroup.add(boost::make_shared<PushAccessor<int>>()), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(dcgroup.setMatchingMode(DataConsistencyGroup::MatchingMode::exact), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(dcgroup.setHistoryLength(5), ChimeraTK::logic_error);
+
+  auto receive = [&](boost::shared_ptr<PushAccessor<int>>& impl, ScalarRegisterAccessor<int>& acc, int value,
+                     VersionNumber version) {
+    impl->push(value, version);
+    BOOST_REQUIRE(acc.readNonBlocking());
+    return dcgroup.update(acc.getId());
+  };
+
+  // acc2 is one event late: the consistent sets are still assembled
+  VersionNumber v1, v2, v3, v4, v5, v6, v7;
+  BOOST_CHECK(!receive(impl1, acc1, 11, v1));
+  BOOST_CHECK(!receive(impl3, acc3, 31, v1));
+  BOOST_CHECK(!receive(impl1, acc1, 12, v2));
+  BOOST_CHECK(!receive(impl3, acc3, 32, v2));
+  BOOST_CHECK(receive(impl2, acc2, 21, v1));
+  BOOST_CHECK_EQUAL(int(acc1), 11);
+  BOOST_CHECK_EQUAL(int(acc2), 21);
+  BOOST_CHECK_EQUAL(int(acc3), 31);
+  BOOST_CHECK(acc1.getVersionNumber() == v1);
+  BOOST_CHECK(acc3.getVersionNumber() == v1);
+  BOOST_CHECK(dcgroup.getIncompleteVersions().empty());
+  BOOST_CHECK(receive(impl2, acc2, 22, v2));
+  BOOST_CHECK_EQUAL(int(acc1), 12);
+  BOOST_CHECK_EQUAL(int(acc3), 32);
+  BOOST_CHECK(acc1.getVersionNumber() == v2);
+
+  // acc3 misses an event: it is reported as incomplete when the next set is complete
+  BOOST_CHECK(!receive(impl1, acc1, 13, v3));
+  BOOST_CHECK(!receive(impl2, acc2, 23, v3));
+  BOOST_CHECK(!receive(impl1, acc1, 14, v4));
+  BOOST_CHECK(!receive(impl2, acc2, 24, v4));
+  BOOST_CHECK(receive(impl3, acc3, 34, v4));
+  BOOST_CHECK_EQUAL(int(acc1), 14);
+  BOOST_CHECK_EQUAL(int(acc2), 24);
+  BOOST_CHECK_EQUAL(int(acc3), 34);
+  BOOST_REQUIRE_EQUAL(dcgroup.getIncompleteVersions().size(), 1);
+  BOOST_CHECK(dcgroup.getIncompleteVersions()[0] == v3);
+
+  // history overflow: the oldest value of acc1 is given up
+  BOOST_CHECK(!receive(impl1, acc1, 15, v5));
+  BOOST_CHECK(!receive(impl1, acc1, 16, v6));
+  BOOST_CHECK(!receive(impl1, acc1, 17, v7));
+  BOOST_CHECK(dcgroup.getIncompleteVersions().empty());
+  BOOST_CHECK(!receive(impl1, acc1, 18, VersionNumber()));
+  BOOST_REQUIRE_EQUAL(dcgroup.getIncompleteVersions().size(), 1);
+  BOOST_CHECK(dcgroup.getIncompleteVersions()[0] == v5);
+  BOOST_CHECK(!receive(impl2, acc2, 26, v6));
+  BOOST_CHECK(receive(impl3, acc3, 36, v6));
+  BOOST_CHECK_EQUAL(int(acc1), 16);
+  BOOST_CHECK_EQUAL(int(acc2), 26);
+  BOOST_CHECK_EQUAL(int(acc3), 36);
+  BOOST_CHECK(dcgroup.getIncompleteVersions().empty());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTimeWindow) {
+  auto impl1 = boost::make_shared<PushAccessor<int>>();
+  auto impl2 = boost::make_shared<PushAccessor<int>>();
+  ScalarRegisterAccessor<int> acc1(impl1);
+  ScalarRegisterAccessor<int> acc2(impl2);
+
+  DataConsistencyGroup dcgroup;
+  dcgroup.setMatchingMode(DataConsistencyGroup::MatchingMode::timeWindow);
+  dcgroup.setTolerance(std::chrono::milliseconds(2));
+  dcgroup.add(acc1);
+  dcgroup.add(acc2);
+
+  auto receive = [&](boost::shared_ptr<PushAccessor<int>>& impl, ScalarRegisterAccessor<int>& acc, int value,
+                     VersionNumber version) {
+    impl->push(value, version);
+    BOOST_REQUIRE(acc.readNonBlocking());
+    return dcgroup.update(acc.getId());
+  };
+
+  auto t0 = std::chrono::system_clock::now();
+  VersionNumber v1a(t0);
+  VersionNumber v1b(t0 + std::chrono::milliseconds(1));
+  VersionNumber v2a(t0 + std::chrono::milliseconds(10));
+  VersionNumber v2b(t0 + std::chrono::milliseconds(15));
+  VersionNumber v3a(t0 + std::chrono::milliseconds(20));
+  VersionNumber v3b(t0 + std::chrono::milliseconds(19));
+
+  // time stamps within the tolerance
+  BOOST_CHECK(!receive(impl1, acc1, 11, v1a));
+  BOOST_CHECK(receive(impl2, acc2, 21, v1b));
+  BOOST_CHECK_EQUAL(int(acc1), 11);
+  BOOST_CHECK_EQUAL(int(acc2), 21);
+
+  // time stamps too far apart
+  BOOST_CHECK(!receive(impl1, acc1, 12, v2a));
+  BOOST_CHECK(!receive(impl2, acc2, 22, v2b));
+
+  // the next matching set also gives up the unmatched values
+  BOOST_CHECK(!receive(impl1, acc1, 13, v3a));
+  BOOST_CHECK(receive(impl2, acc2, 23, v3b));
+  BOOST_CHECK_EQUAL(int(acc1), 13);
+  BOOST_CHECK_EQUAL(int(acc2), 23);
+  BOOST_CHECK(acc1.getVersionNumber() == v3a);
+  BOOST_CHECK(acc2.getVersionNumber() == v3b);
+  BOOST_CHECK_EQUAL(dcgroup.getIncompleteVersions().size(), 2);
+}
+
+/**********************************************************************************************************************/
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE DeadlineTimerTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "DeadlineTimer.h"
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(DeadlineTimerTestSuite)
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testOrder) {
+  auto& timer = DeadlineTimer::getInstance();
+  auto now = std::chrono::steady_clock::now();
+
+  std::mutex mutex;
+  std::vector<int> calls;
+  std::promise<void> done;
+  auto record = [&](int index) {
+    return [&, index] {
+      std::lock_guard<std::mutex> lock(mutex);
+      calls.push_back(index);
+    };
+  };
+
+  // scheduled in a different order than the deadlines
+  auto h2 = timer.schedule(now + std::chrono::milliseconds(20), record(2));
+  auto h1 = timer.schedule(now + std::chrono::milliseconds(10), record(1));
+  auto h3 = timer.schedule(now + std::chrono::milliseconds(30), [&] {
+    record(3)();
+    done.set_value();
+  });
+  done.get_future().get();
+  BOOST_CHECK(std::chrono::steady_clock::now() >= now + std::chrono::milliseconds(30));
+
+  std::lock_guard<std::mutex> lock(mutex);
+  BOOST_CHECK((calls == std::vector<int>{1, 2, 3}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testCancel) {
+  auto& timer = DeadlineTimer::getInstance();
+  auto now = std::chrono::steady_clock::now();
+
+  bool cancelledCalled = false;
+  std::promise<void> done;
+  {
+    auto cancelled = timer.schedule(now + std::chrono::milliseconds(10), [&] { cancelledCalled = true; });
+  }
+  auto moved = timer.schedule(now + std::chrono::milliseconds(20), [&] { cancelledCalled = true; });
+  DeadlineTimer::Handle target = std::move(moved);
+  target.cancel();
+
+  // the functions are called in the order of the deadlines, so the cancelled ones would have been called before
+  auto last = timer.schedule(now + std::chrono::milliseconds(30), [&] { done.set_value(); });
+  done.get_future().get();
+  BOOST_CHECK(!cancelledCalled);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,7 @@
 #include "Device.h"
 #include "DummyBackend.h"
 #include "Exception.h"
+#include "NumericAddress.h"
 #include "parserUtilities.h"
 
 #include <boost/bind/bind.hpp>
@@ -497,6 +498,25 @@ BOOST_AUTO_TEST_CASE(testDummyInterrupt) {
 
 /**********************************************************************************************************************/
 
+BOOST_AUTO_TEST_CASE(testCatalogueIsShared) {
+  auto backend = boost::make_shared<TestableDummyBackend>(TEST_MAPPING_FILE);
+
+  // obtaining the catalogue repeatedly must not copy it
+  auto catalogue = backend->getRegisterCatalogue();
+  BOOST_CHECK(&backend->getRegisterCatalogue().getImpl() == &catalogue.getImpl());
+
+  // the catalogue stays valid after the backend has been destroyed
+  backend.reset();
+  BOOST_CHECK(catalogue.hasRegister(READ_ONLY_REGISTER_STRING));
+  BOOST_CHECK(!catalogue.getRegister(READ_ONLY_REGISTER_STRING).isWriteable());
+
+  // registers which are not stored in the catalogue are still found
+  BOOST_CHECK(catalogue.getRegister(std::string(READ_ONLY_REGISTER_STRING) + ".DUMMY_WRITEABLE").isWriteable());
+  BOOST_CHECK_EQUAL(catalogue.getRegister(numeric_address::BAR() / 0 / 32 * 8).getNumberOfElements(), 2);
+}
+
+/**********************************************************************************************************************/
+
 BOOST_AUTO_TEST_CASE(testAddressRange) {
   TestableDummyBackend::AddressRange range24_8_0(0, 24, 8);
 
@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE InterruptTimestampTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackend.h"
+
+#include <chrono>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(InterruptTimestampTestSuite)
+
+static const std::string cdd{"(dummy?map=interruptTimestamp.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTimestampFromRegister) {
+  Device device(cdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(dummy);
+
+  auto timestampNs = device.getOneDRegisterAccessor<int32_t>("APP/TIMESTAMP_NS", 0, 0, {AccessMode::raw});
+  auto taiMs = device.getScalarRegisterAccessor<int32_t>("APP/TAI_MS", 0, {AccessMode::raw});
+  auto data = device.getScalarRegisterAccessor<int32_t>("APP/DATA");
+  auto data1 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_1", 0, {AccessMode::wait_for_new_data});
+  auto data2 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_2", 0, {AccessMode::wait_for_new_data});
+  auto data3 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_3", 0, {AccessMode::wait_for_new_data});
+
+  device.activateAsyncRead();
+  data1.read();
+  data2.read();
+  data3.read();
+
+  // 64 bit nanosecond counter, least significant word first
+  const uint64_t ns = 1700000000123456789ULL;
+  timestampNs[0] = static_cast<int32_t>(ns & 0xFFFFFFFF);
+  timestampNs[1] = static_cast<int32_t>(ns >> 32);
+  timestampNs.write();
+  data = 42;
+  data.write();
+
+  auto version1 = dummy->triggerInterrupt(1);
+  data1.read();
+  BOOST_CHECK_EQUAL(int32_t(data1), 42);
+  BOOST_CHECK(data1.getVersionNumber() == version1);
+  auto expected1 = std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+  BOOST_CHECK(data1.getVersionNumber().getTime() == expected1);
+
+  // millisecond TAI counter, converted to UTC with the offset
+  taiMs = 1234567;
+  taiMs.write();
+  auto version2 = dummy->triggerInterrupt(2);
+  data2.read();
+  BOOST_CHECK(data2.getVersionNumber() == version2);
+  BOOST_CHECK(data2.getVersionNumber().getTime() ==
+      std::chrono::system_clock::time_point(std::chrono::milliseconds(1234567) - std::chrono::seconds(37)));
+
+  // the version numbers keep their order, although the time stamp is older
+  BOOST_CHECK(version2 > version1);
+
+  // without time stamp register the system clock is used
+  auto before = std::chrono::system_clock::now();
+  dummy->triggerInterrupt(3);
+  auto after = std::chrono::system_clock::now();
+  data3.read();
+  BOOST_CHECK(data3.getVersionNumber().getTime() >= before);
+  BOOST_CHECK(data3.getVersionNumber().getTime() <= after);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -55,6 +55,9 @@ BOOST_AUTO_TEST_CASE(testCatalogue) {
 
   const RegisterCatalogue& catalogue = device.getRegisterCatalogue();
 
+  // the completed catalogue is shared and not copied on each call
+  BOOST_CHECK(&device.getRegisterCatalogue().getImpl() == &catalogue.getImpl());
+
   auto info = catalogue.getRegister("SingleWord");
   BOOST_CHECK(info.getRegisterName() == "/SingleWord");
   BOOST_CHECK(info.getNumberOfElements() == 1);
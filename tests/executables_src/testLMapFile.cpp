@@ -47,6 +47,7 @@ BOOST_AUTO_TEST_CASE(testErrorInDmapFile) {
   testErrorInDmapFileSingle("invalidStartIndex1.xlmap");
   testErrorInDmapFileSingle("invalidStartIndex2.xlmap");
   testErrorInDmapFileSingle("invalidDuplicateName.xlmap");
+  testErrorInDmapFileSingle("invalidDuplicateParameter.xlmap");
   std::cout << "*** End of invalid xlmap file test. ********************" << std::endl;
   std::cout << "********************************************************" << std::endl;
 }
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE LMapParallelOpenTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "ExceptionDummyBackend.h"
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(LMapParallelOpenTestSuite)
+
+/**********************************************************************************************************************/
+
+struct Fixture {
+  Fixture() {
+    BackendFactory::getInstance().setDMapFilePath("parallelOpen.dmap");
+    for(const auto& name : {"PO_TARGET1", "PO_TARGET2", "PO_TARGET3"}) {
+      targets.push_back(boost::dynamic_pointer_cast<ExceptionDummy>(BackendFactory::getInstance().createBackend(name)));
+      BOOST_REQUIRE(targets.back());
+    }
+  }
+
+  ~Fixture() {
+    for(auto& target : targets) {
+      target->throwExceptionOpen = false;
+      if(target->isOpen()) target->close();
+    }
+  }
+
+  std::vector<boost::shared_ptr<ExceptionDummy>> targets;
+};
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testParallelOpen, Fixture) {
+  for(const auto* concurrency : {"1", "2", "8"}) {
+    Device device(std::string("(logicalNameMap?map=parallelOpen.xlmap&openConcurrency=") + concurrency + ")");
+    device.open();
+    for(auto& target : targets) {
+      BOOST_CHECK(target->isOpen());
+    }
+
+    auto a1 = device.getScalarRegisterAccessor<int32_t>("A1");
+    auto a3 = device.getScalarRegisterAccessor<int32_t>("A3");
+    a1 = 42;
+    a1.write();
+    a3 = 43;
+    a3.write();
+    a1.read();
+    BOOST_CHECK_EQUAL(int32_t(a1), 42);
+    device.close();
+    for(auto& target : targets) {
+      BOOST_CHECK(!target->isOpen());
+    }
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testCombinedErrors, Fixture) {
+  Device device("(logicalNameMap?map=parallelOpen.xlmap)");
+
+  // a single failure is passed on unchanged
+  targets[1]->throwExceptionOpen = true;
+  try {
+    device.open();
+    BOOST_ERROR("open() did not throw");
+  }
+  catch(ChimeraTK::runtime_error& e) {
+    BOOST_CHECK_EQUAL(std::string(e.what()), "DummyException: open throws by request");
+  }
+  BOOST_CHECK(targets[0]->isOpen());
+  BOOST_CHECK(targets[2]->isOpen());
+
+  // multiple failures are reported together
+  targets[2]->throwExceptionOpen = true;
+  try {
+    device.open();
+    BOOST_ERROR("open() did not throw");
+  }
+  catch(ChimeraTK::runtime_error& e) {
+    std::string message = e.what();
+    BOOST_CHECK(message.find("Failed to open 2 of 3 target devices") != std::string::npos);
+    BOOST_CHECK(message.find("'PO_TARGET2'") != std::string::npos);
+    BOOST_CHECK(message.find("'PO_TARGET3'") != std::string::npos);
+    BOOST_CHECK(message.find("'PO_TARGET1'") == std::string::npos);
+  }
+  BOOST_CHECK(!device.isFunctional());
+
+  // recovery
+  targets[1]->throwExceptionOpen = false;
+  targets[2]->throwExceptionOpen = false;
+  device.open();
+  BOOST_CHECK(device.isFunctional());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testLazyTargets, Fixture) {
+  Device device("(logicalNameMap?map=parallelOpen.xlmap&lazyTargets=1)");
+  device.open();
+  for(auto& target : targets) {
+    BOOST_CHECK(!target->isOpen());
+  }
+
+  // the target is opened when the first accessor using it is requested
+  auto a1 = device.getScalarRegisterAccessor<int32_t>("A1");
+  BOOST_CHECK(targets[0]->isOpen());
+  BOOST_CHECK(!targets[1]->isOpen());
+  a1 = 5;
+  a1.write();
+
+  // a failing open puts the logical device into the exception state
+  targets[2]->throwExceptionOpen = true;
+  auto b3 = device.getScalarRegisterAccessor<int32_t>("B3");
+  BOOST_CHECK(!device.isFunctional());
+
+  // transfers report the exception state, not the closed target (B3 is a read-only channel, so A3 is written)
+  auto a3 = device.getScalarRegisterAccessor<int32_t>("A3");
+  BOOST_CHECK_THROW(b3.read(), ChimeraTK::runtime_error);
+  BOOST_CHECK_THROW(a3.read(), ChimeraTK::runtime_error);
+  a3 = 7;
+  BOOST_CHECK_THROW(a3.write(), ChimeraTK::runtime_error);
+
+  // the recovery opens it again
+  targets[2]->throwExceptionOpen = false;
+  device.open();
+  BOOST_CHECK(targets[2]->isOpen());
+  BOOST_CHECK(!targets[1]->isOpen());
+  b3.read();
+  a3 = 8;
+  a3.write();
+  a3.read();
+  BOOST_CHECK_EQUAL(int32_t(a3), 8);
+  a1.read();
+  BOOST_CHECK_EQUAL(int32_t(a1), 5);
+
+  // targets are also created for the catalogue, but only opened while the logical device is open
+  device.close();
+  auto catalogue = device.getRegisterCatalogue();
+  BOOST_CHECK(catalogue.hasRegister("A2"));
+  BOOST_CHECK(!targets[1]->isOpen());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testInvalidParameters) {
+  BackendFactory::getInstance().setDMapFilePath("parallelOpen.dmap");
+  BOOST_CHECK_THROW(Device("(logicalNameMap?map=parallelOpen.xlmap&openConcurrency=0)"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(Device("(logicalNameMap?map=parallelOpen.xlmap&openConcurrency=x)"), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(Device("(logicalNameMap?map=parallelOpen.xlmap&lazyTargets=yes)"), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
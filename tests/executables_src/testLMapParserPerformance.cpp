@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "CatalogueCache.h"
+#include "LogicalNameMapParser.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace ChimeraTK;
+
+/*
+ * Benchmark for parsing large xlmap files.
+ *
+ * Usage: ( cd tests ; ../bin/testLMapParserPerformance [<NumberOfRegisters>] )
+ *
+ * An xlmap file with the given number of registers is generated, organised in modules of 1000 registers each. It
+ * contains a mix of redirected registers, channels, bits, constants, variables and registers with plugins, similar to a
+ * facility-wide logical map. The time to parse the file is printed, also with the CatalogueCache enabled, once to fill
+ * the cache and once to read the result back from the cache.
+ *
+ * If omitted, the number of registers defaults to 1000 (which is acceptable also on slower machines in debug build
+ * mode). Use e.g. 100000 to get numbers representative for a facility-wide logical map.
+ */
+
+/**********************************************************************************************************************/
+
+void generateMapFile(const std::string& fileName, size_t nRegisters) {
+  std::ofstream file(fileName);
+  file << "<logicalNameMap>\n";
+  file << "  <constant name=\"OFFSET\"><type>integer</type><value>4</value></constant>\n";
+  for(size_t i = 0; i < nRegisters; ++i) {
+    if(i % 1000 == 0) {
+      if(i > 0) file << "  </module>\n";
+      file << "  <module name=\"MODULE" << i / 1000 << "\">\n";
+    }
+    std::string name = "REG" + std::to_string(i);
+    switch(i % 6) {
+      case 0:
+        file << "    <redirectedRegister name=\"" << name << "\"><targetDevice>TARGET</targetDevice>"
+             << "<targetRegister>APP/" << name << "</targetRegister></redirectedRegister>\n";
+        break;
+      case 1:
+        file << "    <redirectedRegister name=\"" << name << "\"><targetDevice><par>target</par></targetDevice>"
+             << "<targetRegister>APP/ARRAY</targetRegister><targetStartIndex><ref>/OFFSET</ref></targetStartIndex>"
+             << "<numberOfElements>4</numberOfElements></redirectedRegister>\n";
+        break;
+      case 2:
+        file << "    <redirectedChannel name=\"" << name << "\"><targetDevice>TARGET</targetDevice>"
+             << "<targetRegister>APP/MUXED</targetRegister><targetChannel>3</targetChannel></redirectedChannel>\n";
+        break;
+      case 3:
+        file << "    <redirectedBit name=\"" << name << "\"><targetDevice>TARGET</targetDevice>"
+             << "<targetRegister>APP/STATUS</targetRegister><targetBit>5</targetBit></redirectedBit>\n";
+        break;
+      case 4:
+        file << "    <variable name=\"" << name << "\"><type>float64</type><value>1.5</value></variable>\n";
+        break;
+      case 5:
+        file << "    <redirectedRegister name=\"" << name << "\"><targetDevice>TARGET</targetDevice>"
+             << "<targetRegister>APP/" << name << "</targetRegister>"
+             << "<plugin name=\"math\"><parameter name=\"formula\">x*2 + offset</parameter>"
+             << "<parameter name=\"offset\">1</parameter></plugin></redirectedRegister>\n";
+        break;
+    }
+  }
+  if(nRegisters > 0) file << "  </module>\n";
+  file << "</logicalNameMap>\n";
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nRegisters = 1000;
+  if(argc > 1) {
+    nRegisters = std::stoul(argv[1]);
+  }
+
+  const std::string fileName = "lmapParserPerformance.xlmap";
+  generateMapFile(fileName, nRegisters);
+
+  auto measure = [&](size_t& nRegistersParsed) {
+    std::map<std::string, LNMVariable> variables;
+    LogicalNameMapParser parser({{"target", "TARGET"}}, variables);
+    auto t0 = std::chrono::steady_clock::now();
+    auto catalogue = parser.parseFile(fileName);
+    auto t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    nRegistersParsed = catalogue.getNumberOfRegisters();
+    return t;
+  };
+
+  size_t nParsed = 0, nParsedFill = 0, nParsedCached = 0;
+  auto t = measure(nParsed);
+
+  const std::string cacheDirectory = "lmapParserPerformance.cache";
+  std::filesystem::remove_all(cacheDirectory);
+  CatalogueCache::setLocation(CatalogueCache::Location::cacheDirectory, cacheDirectory);
+  auto tFill = measure(nParsedFill);
+  auto tCached = measure(nParsedCached);
+  CatalogueCache::setLocation(CatalogueCache::Location::disabled);
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Parsing an xlmap file with " << nRegisters << " registers:" << std::endl;
+  if(nParsed != nRegisters + 1 || nParsedFill != nRegisters + 1 || nParsedCached != nRegisters + 1) {
+    std::cout << " ERROR: Wrong number of registers in the catalogue: " << nParsed << " " << nParsedFill << " "
+              << nParsedCached << std::endl;
+    return 1;
+  }
+  std::cout << "   " << t << " s (" << static_cast<double>(nRegisters) / t << " registers/s)" << std::endl;
+  std::cout << "   filling the cache: " << tFill << " s" << std::endl;
+  std::cout << "   from the cache:    " << tCached << " s" << std::endl;
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
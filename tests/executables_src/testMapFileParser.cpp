@@ -11,7 +11,13 @@ using namespace boost::unit_test_framework;
 #include "helperFunctions.h"
 #include "MapFileParser.h"
 #include "NumericAddressedRegisterCatalogue.h"
+#include "StreamMapFileParser.h"
 
+#include <sys/stat.h>
+
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <sstream>
 
 using namespace ChimeraTK;
@@ -480,4 +486,69 @@ BOOST_AUTO_TEST_CASE(testMapFileNewStyleMuxed) {
 
 /*******************************************************************************************************************/
 
+BOOST_AUTO_TEST_CASE(testCompareWithStreamParser) {
+  // parse() must give the same result as the original stream-based implementation for every map file
+  size_t nFiles = 0;
+  for(const auto& entry : std::filesystem::directory_iterator(".")) {
+    auto extension = entry.path().extension();
+    if(extension != ".map" && extension != ".mapp") continue;
+    ++nFiles;
+    BOOST_TEST_CONTEXT("Map file " << entry.path()) {
+      std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> fast, reference;
+      std::string fastError, referenceError;
+      try {
+        fast = MapFileParser().parse(entry.path().string());
+      }
+      catch(ChimeraTK::logic_error& e) {
+        fastError = e.what();
+      }
+      try {
+        reference = StreamMapFileParser().parseWithStreams(entry.path().string());
+      }
+      catch(ChimeraTK::logic_error& e) {
+        referenceError = e.what();
+      }
+      BOOST_CHECK_EQUAL(fastError, referenceError);
+      if(!fastError.empty() || !referenceError.empty()) continue;
+
+      std::vector<NumericAddressedRegisterInfo> referenceRegisters;
+      for(const auto& info : reference.first) {
+        referenceRegisters.push_back(info);
+      }
+      compareCatalogue(fast.first, referenceRegisters);
+
+      BOOST_CHECK_EQUAL(fast.second.getNumberOfMetadata(), reference.second.getNumberOfMetadata());
+      for(auto it = reference.second.cbegin(); it != reference.second.cend(); ++it) {
+        BOOST_CHECK_EQUAL(fast.second.getMetadata(it->first), it->second);
+      }
+    }
+  }
+  BOOST_CHECK_GT(nFiles, 10);
+}
+
+/*******************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testNonRegularFile) {
+  // map files can also be read from pipes, e.g. process substitutions like <(generateMap), which cannot be mapped
+  const std::string fifoName = "testNonRegularFile.fifo";
+  std::filesystem::remove(fifoName);
+  BOOST_REQUIRE(::mkfifo(fifoName.c_str(), 0600) == 0);
+  auto writer = std::async(std::launch::async, [&] {
+    std::ifstream source("goodMapFile.map");
+    std::ofstream(fifoName) << source.rdbuf();
+  });
+  auto fromPipe = MapFileParser().parse(fifoName);
+  writer.wait();
+  std::filesystem::remove(fifoName);
+
+  auto reference = MapFileParser().parse("goodMapFile.map");
+  std::vector<NumericAddressedRegisterInfo> referenceRegisters;
+  for(const auto& info : reference.first) {
+    referenceRegisters.push_back(info);
+  }
+  compareCatalogue(fromPipe.first, referenceRegisters);
+}
+
+/*******************************************************************************************************************/
+
 BOOST_AUTO_TEST_SUITE_END()
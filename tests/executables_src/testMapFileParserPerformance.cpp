@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "CatalogueCache.h"
+#include "MapFileParser.h"
+#include "StreamMapFileParser.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace ChimeraTK;
+
+/*
+ * Benchmark for parsing large map files.
+ *
+ * Usage: ( cd tests ; ../bin/testMapFileParserPerformance [<NumberOfLines>] )
+ *
+ * A map file with the given number of register lines is generated, similar to the maps generated for large firmware
+ * projects: registers in modules, comments, metadata, interrupts and multiplexed areas. The file is parsed with parse()
+ * and with the stream-based reference implementation of the tests (StreamMapFileParser). Finally, the file is parsed
+ * with the CatalogueCache enabled, once to fill the cache and once to read the result back from the cache.
+ *
+ * If omitted, the number of lines defaults to 1000 (which is acceptable also on slower machines in debug build mode).
+ * Use e.g. 100000 to get numbers representative for the maps of large firmware projects.
+ */
+
+/**********************************************************************************************************************/
+
+void generateMapFile(const std::string& fileName, size_t nLines) {
+  std::ofstream file(fileName);
+  file << "# generated map file for the performance test\n";
+  file << "@MAPFILE_REVISION 1.0.0\n";
+  file << "@INTERRUPT_HANDLER {\"1\":{\"INTC\":{\"path\":\"APP0.INTC\",\"options\":[\"MER\"],\"version\":1}}}\n";
+  size_t address = 0;
+  for(size_t i = 0; i < nLines; ++i) {
+    std::string module = "MODULE" + std::to_string(i / 1000);
+    switch(i % 10) {
+      case 0:
+        // 2D area with 4 channels, 5 lines in total
+        file << module << ".AREA_MULTIPLEXED_SEQUENCE_DATA" << i << "  0x0  0x" << std::hex << address
+             << "  0x40  0x2  32  0  0  RO\n";
+        for(size_t c = 0; c < 4; ++c) {
+          file << module << ".SEQUENCE_DATA" << std::dec << i << "_" << c << "  0x1  0x" << std::hex
+               << address + 4 * c << "  0x4  0x2  16  " << std::dec << c << "  1\n";
+        }
+        address += 0x40;
+        i += 4;
+        break;
+      case 5:
+        file << module << ".EVENT" << i << "  0x1  0x" << std::hex << address << "  0x4  0x0  32  0  0  INTERRUPT1:"
+             << std::dec << i % 8 << "  # interrupt\n";
+        address += 4;
+        break;
+      case 6:
+        file << module << ".FLOAT" << i << "  0x10  0x" << std::hex << address << "  0x40  0x0  32  IEEE754  1  RW\n";
+        address += 0x40;
+        break;
+      default:
+        file << module << ".WORD" << std::dec << i << "\t0x00000001\t0x" << std::hex << address
+             << "\t0x00000004\t0x00000000\t32\t0\t1\tRW\n";
+        address += 4;
+    }
+    file << std::dec;
+  }
+}
+
+/**********************************************************************************************************************/
+
+template<typename PARSE>
+double measure(PARSE parse, size_t& nRegisters) {
+  auto t0 = std::chrono::steady_clock::now();
+  auto [catalogue, metadata] = parse();
+  auto t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  nRegisters = catalogue.getNumberOfRegisters();
+  return t;
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nLines = 1000;
+  if(argc > 1) {
+    nLines = std::stoul(argv[1]);
+  }
+
+  const std::string fileName = "mapFileParserPerformance.map";
+  generateMapFile(fileName, nLines);
+
+  size_t nRegisters = 0, nRegistersReference = 0;
+  auto t = measure([&] { return MapFileParser().parse(fileName); }, nRegisters);
+  auto tReference = measure([&] { return StreamMapFileParser().parseWithStreams(fileName); }, nRegistersReference);
+
+  const std::string cacheDirectory = "mapFileParserPerformance.cache";
+  std::filesystem::remove_all(cacheDirectory);
+  CatalogueCache::setLocation(CatalogueCache::Location::cacheDirectory, cacheDirectory);
+  size_t nRegistersFill = 0, nRegistersCached = 0;
+  auto tFill = measure([&] { return MapFileParser().parse(fileName); }, nRegistersFill);
+  auto tCached = measure([&] { return MapFileParser().parse(fileName); }, nRegistersCached);
+  CatalogueCache::setLocation(CatalogueCache::Location::disabled);
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Parsing a map file with " << nLines << " lines (" << nRegisters << " registers):" << std::endl;
+  if(nRegisters != nRegistersReference || nRegisters != nRegistersFill || nRegisters != nRegistersCached) {
+    std::cout << " ERROR: Number of registers differs: " << nRegistersReference << " " << nRegistersFill << " "
+              << nRegistersCached << std::endl;
+    return 1;
+  }
+  std::cout << "   parse():            " << t << " s (" << static_cast<double>(nLines) / t << " lines/s)" << std::endl;
+  std::cout << "   parseWithStreams(): " << tReference << " s (" << static_cast<double>(nLines) / tReference
+            << " lines/s)" << std::endl;
+  std::cout << "   parse(), filling the cache: " << tFill << " s" << std::endl;
+  std::cout << "   parse(), from the cache:    " << tCached << " s" << std::endl;
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE NestedInterruptsTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackend.h"
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(NestedInterruptsTestSuite)
+
+static const std::string cdd{"(dummy?map=nestedInterrupts.map)"};
+
+/**********************************************************************************************************************/
+
+struct Fixture {
+  Fixture() {
+    device.open();
+    dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(cdd));
+    BOOST_REQUIRE(dummy);
+  }
+
+  Device device{cdd};
+  boost::shared_ptr<DummyBackend> dummy;
+
+  ScalarRegisterAccessor<int32_t> isr{device.getScalarRegisterAccessor<int32_t>("APP/INTC/ISR")};
+  ScalarRegisterAccessor<int32_t> subStatus{device.getScalarRegisterAccessor<int32_t>("APP/SUB_STATUS")};
+  ScalarRegisterAccessor<int32_t> data{device.getScalarRegisterAccessor<int32_t>("APP/DATA")};
+};
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testActivationEnablesController, Fixture) {
+  auto ier = device.getScalarRegisterAccessor<int32_t>("APP/INTC/IER");
+  auto mer = device.getScalarRegisterAccessor<int32_t>("APP/INTC/MER");
+  auto subMask = device.getScalarRegisterAccessor<int32_t>("APP/SUB_MASK");
+  auto subEnable = device.getScalarRegisterAccessor<int32_t>("APP/SUB_ENABLE");
+
+  device.activateAsyncRead();
+
+  ier.readLatest();
+  mer.readLatest();
+  subMask.readLatest();
+  subEnable.readLatest();
+  BOOST_CHECK_EQUAL(int32_t(ier), 0b111); // sub-interrupts 0, 1 and 2 are used
+  BOOST_CHECK_EQUAL(int32_t(mer), 3);
+  BOOST_CHECK_EQUAL(int32_t(subMask), 1 << 4);
+  BOOST_CHECK_EQUAL(int32_t(subEnable), 1);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testDispatchToAssertedSubInterrupts, Fixture) {
+  auto primary = device.getScalarRegisterAccessor<int32_t>("APP/PRIMARY", 0, {AccessMode::wait_for_new_data});
+  auto nested0 = device.getScalarRegisterAccessor<int32_t>("APP/NESTED_0", 0, {AccessMode::wait_for_new_data});
+  auto nested2 = device.getScalarRegisterAccessor<int32_t>("APP/NESTED_2", 0, {AccessMode::wait_for_new_data});
+  auto deep4 = device.getScalarRegisterAccessor<int32_t>("APP/DEEP_4", 0, {AccessMode::wait_for_new_data});
+  auto iar = device.getScalarRegisterAccessor<int32_t>("APP/INTC/IAR");
+  auto subAck = device.getScalarRegisterAccessor<int32_t>("APP/SUB_ACK");
+
+  device.activateAsyncRead();
+  // initial values
+  primary.read();
+  nested0.read();
+  nested2.read();
+  deep4.read();
+
+  // only sub-interrupt 2 is asserted
+  data = 12;
+  data.write();
+  isr = 1 << 2;
+  isr.write();
+  dummy->triggerInterrupt(3);
+
+  BOOST_CHECK(primary.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(primary), 12);
+  BOOST_CHECK(nested2.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(nested2), 12);
+  BOOST_CHECK(!nested0.readNonBlocking());
+  BOOST_CHECK(!deep4.readNonBlocking());
+  iar.readLatest();
+  BOOST_CHECK_EQUAL(int32_t(iar), 1 << 2);
+
+  // sub-interrupt 0 and the nested controller on sub-interrupt 1 are asserted at the same time
+  data = 13;
+  data.write();
+  isr = (1 << 0) | (1 << 1);
+  isr.write();
+  subStatus = 1 << 4;
+  subStatus.write();
+  dummy->triggerInterrupt(3);
+
+  BOOST_CHECK(primary.readNonBlocking());
+  BOOST_CHECK(nested0.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(nested0), 13);
+  BOOST_CHECK(deep4.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(deep4), 13);
+  BOOST_CHECK(!nested2.readNonBlocking());
+  iar.readLatest();
+  BOOST_CHECK_EQUAL(int32_t(iar), 0b11);
+  subAck.readLatest();
+  BOOST_CHECK_EQUAL(int32_t(subAck), 1 << 4);
+
+  // nothing asserted: only the primary interrupt receives data
+  isr = 0;
+  isr.write();
+  dummy->triggerInterrupt(3);
+  BOOST_CHECK(primary.readNonBlocking());
+  BOOST_CHECK(!nested0.readNonBlocking());
+  BOOST_CHECK(!nested2.readNonBlocking());
+  BOOST_CHECK(!deep4.readNonBlocking());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testMissingControllerDescription) {
+  // interruptMapFile.map uses nested interrupts without describing the interrupt controllers
+  Device device;
+  BOOST_CHECK_THROW(device.open("(dummy?map=interruptMapFile.map)"), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
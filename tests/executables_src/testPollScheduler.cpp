@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE PollSchedulerTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "ExceptionDummyBackend.h"
+#include "PollScheduler.h"
+#include "waitFor.h"
+
+#include <atomic>
+#include <chrono>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(PollSchedulerTestSuite)
+
+/**********************************************************************************************************************/
+
+/**
+ * ExceptionDummy which counts the read transfers.
+ */
+struct CountingDummy : public ExceptionDummy {
+  using ExceptionDummy::ExceptionDummy;
+
+  static boost::shared_ptr<DeviceBackend> createInstance(std::string, std::map<std::string, std::string> parameters) {
+    return returnInstance<CountingDummy>(parameters.at("map"), convertPathRelativeToDmapToAbs(parameters.at("map")));
+  }
+
+  struct BackendRegisterer {
+    BackendRegisterer() {
+      ChimeraTK::BackendFactory::getInstance().registerBackendType(
+          "CountingDummy", &CountingDummy::createInstance, {"map"});
+    }
+  };
+
+  void read(uint64_t bar, uint64_t address, int32_t* data, size_t sizeInBytes) override {
+    ++nReads;
+    ExceptionDummy::read(bar, address, data, sizeInBytes);
+  }
+
+  std::atomic<size_t> nReads{0};
+};
+
+static CountingDummy::BackendRegisterer gCountingDummyRegisterer;
+
+static const std::string cdd{"(CountingDummy?map=pollScheduler.map)"};
+
+/**********************************************************************************************************************/
+
+/**
+ * Test fixture with a PollScheduler running on a SimulatedClock. advanceTick() advances the clock by one tick and
+ * waits until the tick has been processed.
+ */
+struct Fixture {
+  Fixture() {
+    device.open();
+    backend = boost::dynamic_pointer_cast<CountingDummy>(BackendFactory::getInstance().createBackend(cdd));
+    BOOST_REQUIRE(backend);
+  }
+
+  void advanceTick() {
+    auto tickCount = scheduler.getTickCount();
+    BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+    clock->advance(tick);
+    BOOST_REQUIRE(waitFor([&] { return scheduler.getTickCount() == tickCount + 1; }));
+  }
+
+  const std::chrono::milliseconds tick{10};
+  Device device{cdd};
+  boost::shared_ptr<CountingDummy> backend;
+  std::shared_ptr<TimerInterruptSource::SimulatedClock> clock{std::make_shared<TimerInterruptSource::SimulatedClock>()};
+  PollScheduler scheduler{BackendFactory::getInstance().createBackend(cdd), tick, clock};
+};
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testSharedReads, Fixture) {
+  auto writeA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto writeB = device.getScalarRegisterAccessor<int32_t>("APP/B");
+  writeA = 1;
+  writeA.write();
+  writeB = 2;
+  writeB.write();
+
+  // many consumers of the same register, and one with a different period
+  std::vector<ScalarRegisterAccessor<int32_t>> consumersA;
+  for(size_t i = 0; i < 10; ++i) {
+    consumersA.push_back(scheduler.getScalarRegisterAccessor<int32_t>("APP/A", std::chrono::milliseconds(20)));
+  }
+  // periods are rounded to multiples of the tick
+  auto consumerB = scheduler.getScalarRegisterAccessor<int32_t>("APP/B", std::chrono::milliseconds(38));
+  BOOST_CHECK_EQUAL(scheduler.getNumberOfPollGroups(), 2);
+  BOOST_CHECK(consumerB.getAccessModeFlags().has(AccessMode::wait_for_new_data));
+
+  // The first poll of each group activates it and sends the initial values. The subsequent polls read each register
+  // only once per period.
+  advanceTick();
+  advanceTick();
+  for(auto& consumer : consumersA) {
+    BOOST_CHECK(consumer.readNonBlocking());
+    BOOST_CHECK_EQUAL(int32_t(consumer), 1);
+  }
+  advanceTick();
+  advanceTick();
+  BOOST_CHECK(consumerB.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(consumerB), 2);
+
+  writeA = 10;
+  writeA.write();
+  auto nReads = backend->nReads.load();
+  advanceTick();
+  BOOST_CHECK_EQUAL(backend->nReads - nReads, 0);
+  advanceTick();
+  BOOST_CHECK_EQUAL(backend->nReads - nReads, 1);
+  for(auto& consumer : consumersA) {
+    BOOST_CHECK(consumer.readLatest());
+    BOOST_CHECK_EQUAL(int32_t(consumer), 10);
+  }
+  BOOST_CHECK(consumersA[0].getVersionNumber() == consumersA[9].getVersionNumber());
+
+  advanceTick();
+  advanceTick();
+  BOOST_CHECK_EQUAL(backend->nReads - nReads, 3);
+  BOOST_CHECK(consumerB.readNonBlocking());
+  BOOST_CHECK(!consumerB.readNonBlocking());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testMergedPeriods, Fixture) {
+  auto fast = scheduler.getScalarRegisterAccessor<int32_t>("APP/A", 2 * tick);
+  auto slow = scheduler.getScalarRegisterAccessor<int32_t>("APP/A", 4 * tick);
+  auto other = scheduler.getScalarRegisterAccessor<int32_t>("APP/B", 4 * tick);
+  BOOST_CHECK_EQUAL(scheduler.getNumberOfPollGroups(), 2);
+
+  // activate both groups
+  for(size_t i = 0; i < 4; ++i) {
+    advanceTick();
+  }
+  BOOST_CHECK(fast.readLatest());
+  BOOST_CHECK(slow.readLatest());
+  BOOST_CHECK(other.readLatest());
+
+  // Both groups are due in every second tick of the fast group. They are read together, so the register used in both
+  // groups is transferred only once.
+  auto nReads = backend->nReads.load();
+  advanceTick();
+  advanceTick();
+  BOOST_CHECK_EQUAL(backend->nReads - nReads, 1);
+  advanceTick();
+  advanceTick();
+  BOOST_CHECK_EQUAL(backend->nReads - nReads, 3); // APP/A once, APP/B once
+
+  BOOST_CHECK(fast.readLatest());
+  BOOST_CHECK(slow.readLatest());
+  BOOST_CHECK(other.readLatest());
+  BOOST_CHECK(fast.getVersionNumber() == slow.getVersionNumber());
+  BOOST_CHECK(slow.getVersionNumber() == other.getVersionNumber());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testExceptionHandling, Fixture) {
+  auto consumer = scheduler.getScalarRegisterAccessor<int32_t>("APP/A", tick);
+  advanceTick();
+  BOOST_CHECK(consumer.readNonBlocking());
+
+  // the exception is sent to the consumer
+  backend->throwExceptionRead = true;
+  advanceTick();
+  BOOST_CHECK_THROW(consumer.readNonBlocking(), ChimeraTK::runtime_error);
+
+  // nothing is sent while the device is faulty
+  backend->throwExceptionRead = false;
+  advanceTick();
+  BOOST_CHECK(!consumer.readNonBlocking());
+
+  // a new initial value is sent after the recovery
+  auto writeA = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  device.open();
+  writeA = 5;
+  writeA.write();
+  advanceTick();
+  BOOST_CHECK(consumer.readNonBlocking());
+  BOOST_CHECK_EQUAL(int32_t(consumer), 5);
+  advanceTick();
+  BOOST_CHECK(consumer.readNonBlocking());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testGetInstance) {
+  auto backend = BackendFactory::getInstance().createBackend(cdd);
+  auto scheduler = PollScheduler::getInstance(backend);
+  BOOST_CHECK(scheduler == PollScheduler::getInstance(backend));
+  BOOST_CHECK(scheduler->getTick() == std::chrono::milliseconds(10));
+
+  auto otherBackend = BackendFactory::getInstance().createBackend("(CountingDummy?map=timerInterrupt.map)");
+  BOOST_CHECK(scheduler != PollScheduler::getInstance(otherBackend));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
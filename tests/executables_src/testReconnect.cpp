@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE ReconnectTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "ExceptionDummyBackend.h"
+#include "waitFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(ReconnectTestSuite)
+
+/**********************************************************************************************************************/
+
+/**
+ * ExceptionDummy which records the time of each call to open(). open() can also be made to throw a logic_error.
+ */
+struct RecordingDummy : public ExceptionDummy {
+  using ExceptionDummy::ExceptionDummy;
+
+  static boost::shared_ptr<DeviceBackend> createInstance(std::string, std::map<std::string, std::string> parameters) {
+    return returnInstance<RecordingDummy>(parameters.at("map"), convertPathRelativeToDmapToAbs(parameters.at("map")));
+  }
+
+  struct BackendRegisterer {
+    BackendRegisterer() {
+      ChimeraTK::BackendFactory::getInstance().registerBackendType(
+          "ReconnectRecordingDummy", &RecordingDummy::createInstance, {"map"});
+    }
+  };
+
+  void open() override {
+    {
+      std::lock_guard<std::mutex> lock(attemptsMutex);
+      attempts.push_back(std::chrono::steady_clock::now());
+    }
+    if(throwLogicErrorOpen) {
+      throw ChimeraTK::logic_error("RecordingDummy: invalid configuration");
+    }
+    ExceptionDummy::open();
+  }
+
+  std::vector<std::chrono::steady_clock::time_point> getAttempts() {
+    std::lock_guard<std::mutex> lock(attemptsMutex);
+    return attempts;
+  }
+
+  std::mutex attemptsMutex;
+  std::vector<std::chrono::steady_clock::time_point> attempts;
+  std::atomic<bool> throwLogicErrorOpen{false};
+};
+
+static RecordingDummy::BackendRegisterer gRecordingDummyRegisterer;
+
+static const std::string cdd{"(ReconnectRecordingDummy?map=pollScheduler.map)"};
+
+/**********************************************************************************************************************/
+
+struct Fixture {
+  Fixture() {
+    device.open();
+    backend = boost::dynamic_pointer_cast<RecordingDummy>(BackendFactory::getInstance().createBackend(cdd));
+    BOOST_REQUIRE(backend);
+    backend->enableReconnect(std::chrono::milliseconds(5), std::chrono::milliseconds(40));
+  }
+
+  ~Fixture() {
+    backend->throwLogicErrorOpen = false;
+    backend->throwExceptionOpen = false;
+    backend->throwExceptionRead = false;
+    device.close();
+    BOOST_CHECK(waitFor([&] { return !backend->isReconnecting(); }));
+  }
+
+  Device device{cdd};
+  boost::shared_ptr<RecordingDummy> backend;
+};
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testReconnect, Fixture) {
+  auto a = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto pushA = device.getScalarRegisterAccessor<int32_t>("APP/A/PUSH_READ", 0, {AccessMode::wait_for_new_data});
+  a = 10;
+  a.write();
+  device.activateAsyncRead();
+  pushA.read();
+  BOOST_CHECK_EQUAL(int32_t(pushA), 10);
+
+  // outage: the supervisor retries in the background
+  auto nAttemptsBefore = backend->getAttempts().size();
+  backend->throwExceptionOpen = true;
+  backend->throwExceptionRead = true;
+  BOOST_CHECK(!a.tryRead());
+  backend->throwExceptionRead = false;
+  BOOST_CHECK_THROW(pushA.read(), ChimeraTK::runtime_error);
+  BOOST_CHECK(waitFor([&] { return backend->isReconnecting(); }));
+  BOOST_CHECK(!backend->isFunctional());
+  BOOST_CHECK(!backend->waitUntilFunctional(std::chrono::milliseconds(100)));
+
+  // The delay doubles with each attempt up to the maximum: 5, 10, 20, 40, 40 ms. The supervisor waits at least the
+  // delay, so the time between two attempts is never shorter.
+  BOOST_REQUIRE(waitFor([&] { return backend->getAttempts().size() >= nAttemptsBefore + 5; }));
+  auto attempts = backend->getAttempts();
+  std::chrono::milliseconds expectedDelay{5};
+  for(size_t i = nAttemptsBefore + 1; i < nAttemptsBefore + 5; ++i) {
+    expectedDelay = std::min(expectedDelay * 2, std::chrono::milliseconds(40));
+    BOOST_CHECK(attempts[i] - attempts[i - 1] >= expectedDelay);
+  }
+
+  // the device is back: waiting threads are woken and the push-type accessors get their initial value again
+  backend->throwExceptionOpen = false;
+  BOOST_CHECK(backend->waitUntilFunctional(std::chrono::seconds(10)));
+  BOOST_CHECK(backend->isFunctional());
+  BOOST_CHECK(waitFor([&] { return !backend->isReconnecting(); }));
+  pushA.read();
+  BOOST_CHECK_EQUAL(int32_t(pushA), 10);
+  BOOST_CHECK(a.tryRead().hasValue());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testNoAsyncReadReplay, Fixture) {
+  // asynchronous read has not been activated since the last open, so it is not activated by the supervisor either
+  auto pushA = device.getScalarRegisterAccessor<int32_t>("APP/A/PUSH_READ", 0, {AccessMode::wait_for_new_data});
+  device.setException("outage");
+  BOOST_CHECK(backend->waitUntilFunctional(std::chrono::seconds(10)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  BOOST_CHECK(!pushA.readNonBlocking());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testCloseStopsReconnect, Fixture) {
+  backend->throwExceptionOpen = true;
+  device.setException("outage");
+  BOOST_CHECK(waitFor([&] { return backend->isReconnecting(); }));
+  device.close();
+  BOOST_CHECK(waitFor([&] { return !backend->isReconnecting(); }));
+  BOOST_CHECK(!backend->isOpen());
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testGiveUpOnLogicError, Fixture) {
+  auto a = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  backend->throwLogicErrorOpen = true;
+  device.setException("outage");
+
+  // the supervisor stops retrying, and the backend reports why it stays in the exception state
+  BOOST_CHECK(!backend->waitUntilFunctional(std::chrono::seconds(10)));
+  BOOST_CHECK(waitFor([&] { return !backend->isReconnecting(); }));
+  auto nAttempts = backend->getAttempts().size();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(backend->getAttempts().size(), nAttempts);
+  BOOST_CHECK(!backend->isFunctional());
+  BOOST_CHECK(backend->getActiveExceptionMessage().find("RecordingDummy: invalid configuration") != std::string::npos);
+  BOOST_CHECK_THROW(a.read(), ChimeraTK::runtime_error);
+
+  // the application can recover the backend itself, and the supervisor is active again for the next exception
+  backend->throwLogicErrorOpen = false;
+  device.open();
+  BOOST_CHECK(backend->isFunctional());
+  device.setException("outage");
+  BOOST_CHECK(backend->waitUntilFunctional(std::chrono::seconds(10)));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_FIXTURE_TEST_CASE(testInvalidDelays, Fixture) {
+  BOOST_CHECK_THROW(backend->enableReconnect(std::chrono::milliseconds(0)), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(
+      backend->enableReconnect(std::chrono::milliseconds(100), std::chrono::milliseconds(10)), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
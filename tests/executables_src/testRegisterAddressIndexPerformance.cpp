@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "NumericAddressedRegisterCatalogue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+using namespace ChimeraTK;
+
+/*
+ * Benchmark for finding registers by address in large catalogues.
+ *
+ * Usage: ( cd tests ; ../bin/testRegisterAddressIndexPerformance [<NumberOfRegisters>] )
+ *
+ * A NumericAddressedRegisterCatalogue with the given number of registers is filled, distributed over 4 bars. Every
+ * 100th register is an array of 64 words overlapping the following scalar registers, like the ".MULTIPLEXED_RAW"
+ * registers of 2D registers. The time to build the address index and to look up random addresses (point queries) and
+ * random ranges of 256 bytes (range queries) is printed. For comparison, the point queries are also done by a linear
+ * scan over the catalogue, which was the only way before the index existed.
+ *
+ * If omitted, the number of registers defaults to 1000 (which is acceptable also on slower machines in debug build
+ * mode). Use e.g. 100000 to get numbers representative for large catalogues.
+ */
+
+/**********************************************************************************************************************/
+
+template<typename FUNCTION>
+double measure(FUNCTION function) {
+  auto t0 = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nRegisters = 1000;
+  if(argc > 1) {
+    nRegisters = std::stoul(argv[1]);
+  }
+  const uint64_t nBars = 4;
+  const uint64_t barSize = 4 * (nRegisters / nBars + 1);
+
+  NumericAddressedRegisterCatalogue catalogue;
+  catalogue.reserve(nRegisters);
+  for(size_t i = 0; i < nRegisters; ++i) {
+    uint32_t nElements = (i % 100 == 0) ? 64 : 1;
+    catalogue.addRegister(NumericAddressedRegisterInfo(
+        "/MODULE" + std::to_string(i / 1000) + "/REGISTER" + std::to_string(i), nElements, 4 * (i / nBars),
+        4 * nElements, i % nBars));
+  }
+
+  const size_t nQueries = 100000;
+  std::mt19937 random(42);
+  std::vector<std::pair<uint64_t, uint64_t>> addresses(nQueries);
+  for(auto& [bar, address] : addresses) {
+    bar = random() % nBars;
+    address = random() % barSize;
+  }
+
+  // the first query builds the index
+  auto tBuild = measure([&] { (void)catalogue.getRegistersAtAddress(0, 0); });
+
+  size_t nFound = 0;
+  auto tPoint = measure([&] {
+    for(const auto& [bar, address] : addresses) nFound += catalogue.getRegistersAtAddress(bar, address).size();
+  });
+
+  size_t nFoundRange = 0;
+  auto tRange = measure([&] {
+    for(const auto& [bar, address] : addresses) {
+      nFoundRange += catalogue.getRegistersInAddressRange(bar, address, 256).size();
+    }
+  });
+
+  // linear scan for comparison, only for some addresses since it is slow
+  size_t nScanned = std::min<size_t>(nQueries, 100);
+  size_t nFoundScan = 0, nFoundReference = 0;
+  auto tScan = measure([&] {
+    for(size_t q = 0; q < nScanned; ++q) {
+      const auto& [bar, address] = addresses[q];
+      for(const auto& info : catalogue) {
+        nFoundScan += info.bar == bar && info.address <= address &&
+            address < info.address + info.nElements * info.elementPitchBits / 8;
+      }
+    }
+  });
+  for(size_t q = 0; q < nScanned; ++q) {
+    nFoundReference += catalogue.getRegistersAtAddress(addresses[q].first, addresses[q].second).size();
+  }
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Address lookups in a catalogue with " << nRegisters << " registers:" << std::endl;
+  if(nFoundScan != nFoundReference) {
+    std::cout << " ERROR: Index and linear scan disagree: " << nFoundReference << " != " << nFoundScan << std::endl;
+    return 1;
+  }
+  auto perQuery = [](double t, size_t n) { return t / static_cast<double>(n) * 1e9; };
+  std::cout << "   building the index:         " << tBuild << " s" << std::endl;
+  std::cout << "   point query (index):        " << perQuery(tPoint, nQueries) << " ns, "
+            << static_cast<double>(nFound) / nQueries << " registers found on average" << std::endl;
+  std::cout << "   256 byte range query:       " << perQuery(tRange, nQueries) << " ns, "
+            << static_cast<double>(nFoundRange) / nQueries << " registers found on average" << std::endl;
+  std::cout << "   point query (linear scan):  " << perQuery(tScan, nScanned) << " ns" << std::endl;
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
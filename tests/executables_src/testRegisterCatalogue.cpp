@@ -8,6 +8,11 @@
 using namespace boost::unit_test_framework;
 
 #include "BackendRegisterCatalogue.h"
+#include "NumericAddressedRegisterCatalogue.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
 
 using namespace ChimeraTK;
 
@@ -15,7 +20,7 @@ using namespace ChimeraTK;
 
 class myRegisterInfo : public BackendRegisterInfoBase {
  public:
-  myRegisterInfo(std::string path, unsigned int nbOfElements, unsigned int nbOfChannels, unsigned int nbOfDimensions,
+  myRegisterInfo(RegisterPath path, unsigned int nbOfElements, unsigned int nbOfChannels, unsigned int nbOfDimensions,
       DataDescriptor dataDescriptor, bool readable, bool writeable, AccessModeFlags supportedFlags)
   : _path(path), _nbOfElements(nbOfElements), _nbOfChannels(nbOfChannels), _nbOfDimensions(nbOfDimensions),
     _dataDescriptor(dataDescriptor), _readable(readable), _writeable(writeable), _supportedFlags(supportedFlags) {}
@@ -231,4 +236,220 @@ BOOST_AUTO_TEST_CASE(testRangeBasedLoopFrontend) {
 
 /*******************************************************************************************************************/
 
+BOOST_AUTO_TEST_CASE(testAlternativeSeparator) {
+  CatalogueGenerator generator;
+  auto catalogue = generator.generateCatalogue();
+
+  // lookup with alternative separator of a register named without
+  RegisterPath dotted("some.register.name");
+  dotted.setAltSeparator(".");
+  BOOST_TEST(catalogue.hasRegister(dotted));
+  BOOST_TEST(!catalogue.hasRegister("some.register.name"));
+
+  // lookup without alternative separator of a register named with
+  RegisterPath name("module.with.dots");
+  name.setAltSeparator(".");
+  catalogue.addRegister(myRegisterInfo{name, 1, 1, 0, generator.dataDescriptor3, true, false, {}});
+  BOOST_TEST(catalogue.hasRegister("module.with.dots"));
+  BOOST_TEST(catalogue.hasRegister("/module/with/dots"));
+  BOOST_TEST(catalogue.hasRegister("module/with.dots"));
+  BOOST_TEST(!catalogue.hasRegister("module/with"));
+  myRegisterInfo duplicate{"/module/with/dots", 1, 1, 0, generator.dataDescriptor3, true, false, {}};
+  BOOST_CHECK_THROW(catalogue.addRegister(duplicate), ChimeraTK::logic_error);
+
+  catalogue.modifyRegister(myRegisterInfo{name, 5, 1, 1, generator.dataDescriptor3, true, false, {}});
+  BOOST_TEST(catalogue.getBackendRegister("module/with/dots").getNumberOfElements() == 5);
+
+  catalogue.removeRegister("/module/with/dots");
+  BOOST_TEST(!catalogue.hasRegister(name));
+  BOOST_TEST(catalogue.getNumberOfRegisters() == 3);
+  size_t nIterated = 0;
+  for([[maybe_unused]] auto& info : catalogue) ++nIterated;
+  BOOST_TEST(nIterated == 3);
+}
+
+/*******************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testModuleQueries) {
+  DataDescriptor dd{DataDescriptor::FundamentalType::numeric, true, true, 5};
+  auto makeInfo = [&](const RegisterPath& name) { return myRegisterInfo{name, 1, 1, 0, dd, true, true, {}}; };
+  BackendRegisterCatalogue<myRegisterInfo> backendCatalogue;
+  for(const auto* name : {"/APP/MOD1/A", "/APP/MOD2/A", "/APP/MOD1/B", "/APP/MOD2/SUB/C", "/OTHER/X", "/APP"}) {
+    backendCatalogue.addRegister(makeInfo(name));
+  }
+  RegisterCatalogue catalogue(backendCatalogue.clone());
+
+  auto names = [](const std::vector<RegisterInfo>& infos) {
+    std::vector<std::string> result;
+    for(const auto& info : infos) result.push_back(info.getRegisterName());
+    return result;
+  };
+  using Names = std::vector<std::string>;
+
+  // subtree, sorted by module and in catalogue order within a module
+  BOOST_TEST(names(catalogue.getRegistersInModule("/APP")) ==
+          Names({"/APP", "/APP/MOD1/A", "/APP/MOD1/B", "/APP/MOD2/A", "/APP/MOD2/SUB/C"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersInModule("APP/MOD2")) == Names({"/APP/MOD2/A", "/APP/MOD2/SUB/C"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getRegistersInModule("/").size() == 6);
+  BOOST_TEST(catalogue.getRegistersInModule("/APP/MOD").empty());
+  BOOST_TEST(catalogue.getRegistersInModule("/NOT/THERE").empty());
+
+  // the RegisterInfo objects share the catalogue content
+  const auto inModule = catalogue.getRegistersInModule("/OTHER");
+  const auto single = catalogue.getRegister("/OTHER/X");
+  BOOST_TEST(&inModule.front().getImpl() == &single.getImpl());
+
+  // direct children
+  BOOST_TEST(catalogue.getChildNames("/") == Names({"APP", "OTHER"}), boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getChildNames("/APP") == Names({"MOD1", "MOD2"}), boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getChildNames("/APP/MOD2") == Names({"A", "SUB"}), boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getChildNames("/APP/MOD1/A").empty());
+  BOOST_TEST(catalogue.getChildNames("/NOT/THERE").empty());
+
+  // glob patterns
+  BOOST_TEST(names(catalogue.getRegistersMatching("/APP/*/A")) == Names({"/APP/MOD1/A", "/APP/MOD2/A"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersMatching("/APP/MOD?/?")) ==
+          Names({"/APP/MOD1/A", "/APP/MOD1/B", "/APP/MOD2/A"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersMatching("/APP/**/C")) == Names({"/APP/MOD2/SUB/C"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersMatching("/**/A")) == Names({"/APP/MOD1/A", "/APP/MOD2/A"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersMatching("/**/MOD2/**")) == Names({"/APP/MOD2/A", "/APP/MOD2/SUB/C"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getRegistersMatching("**").size() == 6);
+  BOOST_TEST(names(catalogue.getRegistersMatching("/*")) == Names({"/APP"}), boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getRegistersMatching("/APP/*/D").empty());
+
+  BOOST_TEST(RegisterPathTree::matchComponent("A*B*C", "AxxBxBxC"));
+  BOOST_TEST(!RegisterPathTree::matchComponent("A*B*C", "AxxBxBxCx"));
+  BOOST_TEST(RegisterPathTree::matchComponent("*", ""));
+  BOOST_TEST(!RegisterPathTree::matchComponent("?", ""));
+
+  // the index is updated when the catalogue is modified
+  BOOST_TEST(backendCatalogue.getRegistersInModule("/OTHER").size() == 1);
+  backendCatalogue.addRegister(makeInfo("/OTHER/Y"));
+  BOOST_TEST(backendCatalogue.getRegistersInModule("/OTHER").size() == 2);
+  backendCatalogue.removeRegister("/OTHER/X");
+  BOOST_TEST(backendCatalogue.getChildNames("/OTHER") == Names({"Y"}), boost::test_tools::per_element());
+  backendCatalogue.modifyRegister(myRegisterInfo{"/OTHER/Y", 7, 1, 0, dd, true, true, {}});
+  BOOST_TEST(backendCatalogue.getRegistersInModule("/OTHER").front()->getNumberOfElements() == 7);
+
+  // names with alternative separator are split at both separators, also in queries
+  RegisterPath dotted("DOTTED.MODULE.REG");
+  dotted.setAltSeparator(".");
+  BackendRegisterCatalogue<myRegisterInfo> dottedCatalogue;
+  dottedCatalogue.addRegister(makeInfo(dotted));
+  BOOST_TEST(dottedCatalogue.getChildNames("DOTTED") == Names({"MODULE"}), boost::test_tools::per_element());
+  BOOST_TEST(dottedCatalogue.getRegistersInModule("DOTTED.MODULE").size() == 1);
+  BOOST_TEST(dottedCatalogue.getRegistersMatching("DOTTED.*.REG").size() == 1);
+}
+
+/*******************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testAddressIndex) {
+  NumericAddressedRegisterCatalogue catalogue;
+  catalogue.addRegister(NumericAddressedRegisterInfo("/A", 4, 0x10, 16, 0));        // [0x10, 0x20)
+  catalogue.addRegister(NumericAddressedRegisterInfo("/B", 1, 0x20, 4, 0));         // [0x20, 0x24)
+  catalogue.addRegister(NumericAddressedRegisterInfo("/A_RAW", 16, 0x10, 16, 0, 8)); // [0x10, 0x20), overlaps A
+  catalogue.addRegister(NumericAddressedRegisterInfo("/C", 1, 0x20, 4, 1));         // other bar
+  catalogue.addRegister(NumericAddressedRegisterInfo("/INTERRUPT", 0, 0x30, 0, 0, 0, 0, false,
+      NumericAddressedRegisterInfo::Access::INTERRUPT, NumericAddressedRegisterInfo::Type::VOID, {1}));
+
+  auto names = [](const std::vector<const NumericAddressedRegisterInfo*>& infos) {
+    std::vector<std::string> result;
+    for(const auto* info : infos) result.push_back(info->pathName);
+    return result;
+  };
+  using Names = std::vector<std::string>;
+
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x10)) == Names({"/A", "/A_RAW"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x1F)) == Names({"/A", "/A_RAW"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x20)) == Names({"/B"}), boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(1, 0x22)) == Names({"/C"}), boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x30)) == Names({"/INTERRUPT"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getRegistersAtAddress(0, 0x0F).empty());
+  BOOST_TEST(catalogue.getRegistersAtAddress(0, 0x24).empty());
+  BOOST_TEST(catalogue.getRegistersAtAddress(2, 0x10).empty());
+
+  BOOST_TEST(names(catalogue.getRegistersInAddressRange(0, 0x1C, 8)) == Names({"/A", "/A_RAW", "/B"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(names(catalogue.getRegistersInAddressRange(0, 0, 0x100)) == Names({"/A", "/A_RAW", "/B", "/INTERRUPT"}),
+      boost::test_tools::per_element());
+  BOOST_TEST(catalogue.getRegistersInAddressRange(0, 0x10, 0).empty());
+  BOOST_TEST(names(catalogue.getRegistersInAddressRange(0, 0x30, std::numeric_limits<uint64_t>::max())) ==
+          Names({"/INTERRUPT"}),
+      boost::test_tools::per_element());
+
+  // the index is updated when the catalogue is modified
+  catalogue.modifyRegister(NumericAddressedRegisterInfo("/B", 1, 0x40, 4, 0));
+  BOOST_TEST(catalogue.getRegistersAtAddress(0, 0x20).empty());
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x40)) == Names({"/B"}), boost::test_tools::per_element());
+  catalogue.removeRegister("/A_RAW");
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x10)) == Names({"/A"}), boost::test_tools::per_element());
+  catalogue.addRegister(NumericAddressedRegisterInfo("/D", 2, 0x1C, 8, 0));
+  BOOST_TEST(names(catalogue.getRegistersAtAddress(0, 0x20)) == Names({"/D"}), boost::test_tools::per_element());
+
+  // compare with a linear search for a larger number of overlapping registers
+  NumericAddressedRegisterCatalogue bigCatalogue;
+  for(uint32_t i = 0; i < 1000; ++i) {
+    uint32_t nElements = 1 + (i * 7919) % 13;
+    bigCatalogue.addRegister(
+        NumericAddressedRegisterInfo("/R" + std::to_string(i), nElements, (i * 104729) % 4000, 4 * nElements, i % 2));
+  }
+  for(uint64_t address = 0; address < 4100; address += 3) {
+    for(uint64_t bar = 0; bar < 2; ++bar) {
+      std::vector<const NumericAddressedRegisterInfo*> expected;
+      for(const auto& info : bigCatalogue) {
+        if(info.bar == bar && info.address < address + 5 && info.address + info.nElements * 4 > address) {
+          expected.push_back(&info);
+        }
+      }
+      std::stable_sort(expected.begin(), expected.end(), [](auto* a, auto* b) { return a->address < b->address; });
+      BOOST_CHECK(bigCatalogue.getRegistersInAddressRange(bar, address, 5) == expected);
+    }
+  }
+}
+
+/*******************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSharedCatalogue) {
+  CatalogueGenerator generator;
+  auto backend_catalogue = generator.generateCatalogue();
+  RegisterCatalogue catalogue(backend_catalogue.clone());
+
+  // copies of the catalogue share the implementation
+  RegisterCatalogue copy(catalogue);
+  BOOST_TEST(&copy.getImpl() == &catalogue.getImpl());
+
+  // register information is handed out without copying
+  const auto* stored = &*catalogue.begin();
+  auto info = catalogue.getRegister("/some/register/name");
+  BOOST_TEST(&std::as_const(info).getImpl() == stored);
+  const auto infoFromCopy = copy.getRegister("/some/register/name");
+  BOOST_TEST(&infoFromCopy.getImpl() == stored);
+
+  // copies of the RegisterInfo share the implementation, until it is modified (copy on write)
+  auto infoCopy = info;
+  BOOST_TEST(&std::as_const(infoCopy).getImpl() == stored);
+  auto& modified = dynamic_cast<myRegisterInfo&>(infoCopy.getImpl());
+  BOOST_TEST(&modified != stored);
+  BOOST_CHECK(modified == generator.theInfo);
+  BOOST_TEST(&std::as_const(info).getImpl() == stored);
+
+  // the RegisterInfo keeps the catalogue alive
+  catalogue = RegisterCatalogue(backend_catalogue.clone());
+  copy = catalogue;
+  BOOST_TEST(info.getRegisterName() == "/some/register/name");
+  BOOST_TEST(info.getNumberOfElements() == 42);
+}
+
+/*******************************************************************************************************************/
+
 BOOST_AUTO_TEST_SUITE_END()
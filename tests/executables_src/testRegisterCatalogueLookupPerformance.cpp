@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "NumericAddressedRegisterCatalogue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+using namespace ChimeraTK;
+
+/*
+ * Benchmark for register lookups in large catalogues.
+ *
+ * Usage: ( cd tests ; ../bin/testRegisterCatalogueLookupPerformance [<NumberOfRegisters>] )
+ *
+ * A NumericAddressedRegisterCatalogue with the given number of registers in modules of 1000 registers is filled, and
+ * all registers are looked up in random order, once in the "MODULE.REGISTER" notation of map files and once in the
+ * "/MODULE/REGISTER" notation. For comparison, the same lookups are done in a std::map<RegisterPath, ...>, which was
+ * used by the catalogue before.
+ *
+ * If omitted, the number of registers defaults to 1000 (which is acceptable also on slower machines in debug build
+ * mode). Use e.g. 100000 to get numbers representative for large catalogues.
+ */
+
+/**********************************************************************************************************************/
+
+template<typename FUNCTION>
+double measure(FUNCTION function) {
+  auto t0 = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nRegisters = 1000;
+  if(argc > 1) {
+    nRegisters = std::stoul(argv[1]);
+  }
+
+  std::vector<std::string> dotNames, slashNames;
+  for(size_t i = 0; i < nRegisters; ++i) {
+    auto module = "MODULE" + std::to_string(i / 1000);
+    auto name = "REGISTER_WITH_A_TYPICAL_LENGTH" + std::to_string(i);
+    dotNames.push_back(module + "." + name);
+    slashNames.push_back("/" + module + "/" + name);
+  }
+
+  NumericAddressedRegisterCatalogue catalogue;
+  auto tFill = measure([&] {
+    catalogue.reserve(nRegisters);
+    for(size_t i = 0; i < nRegisters; ++i) {
+      catalogue.addRegister(NumericAddressedRegisterInfo(dotNames[i], 1, 4 * i, 4));
+    }
+  });
+
+  std::map<RegisterPath, size_t> reference;
+  auto tFillReference = measure([&] {
+    for(size_t i = 0; i < nRegisters; ++i) {
+      RegisterPath path(dotNames[i]);
+      path.setAltSeparator(".");
+      reference.emplace(path, i);
+    }
+  });
+
+  std::vector<size_t> order(nRegisters);
+  for(size_t i = 0; i < nRegisters; ++i) order[i] = i;
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+  size_t nFound = 0, nFoundSlash = 0, nFoundReference = 0;
+  auto tLookup = measure([&] {
+    for(auto i : order) nFound += catalogue.findBackendRegister(dotNames[i]) != nullptr;
+  });
+  auto tLookupSlash = measure([&] {
+    for(auto i : order) nFoundSlash += catalogue.findBackendRegister(slashNames[i]) != nullptr;
+  });
+  auto tLookupReference = measure([&] {
+    for(auto i : order) nFoundReference += reference.find(dotNames[i]) != reference.end();
+  });
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Register lookups in a catalogue with " << nRegisters << " registers:" << std::endl;
+  if(nFound != nRegisters || nFoundSlash != nRegisters || nFoundReference != nRegisters) {
+    std::cout << " ERROR: Not all registers found: " << nFound << " " << nFoundSlash << " " << nFoundReference
+              << std::endl;
+    return 1;
+  }
+  auto perLookup = [&](double t) { return t / static_cast<double>(nRegisters) * 1e9; };
+  std::cout << "   filling the catalogue:            " << tFill << " s" << std::endl;
+  std::cout << "   filling std::map<RegisterPath>:   " << tFillReference << " s" << std::endl;
+  std::cout << "   lookup \"MODULE.REGISTER\":         " << perLookup(tLookup) << " ns" << std::endl;
+  std::cout << "   lookup \"/MODULE/REGISTER\":        " << perLookup(tLookupSlash) << " ns" << std::endl;
+  std::cout << "   lookup in std::map<RegisterPath>: " << perLookup(tLookupReference) << " ns" << std::endl;
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
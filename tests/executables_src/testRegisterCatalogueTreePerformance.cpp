@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "NumericAddressedRegisterCatalogue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace ChimeraTK;
+
+/*
+ * Benchmark for hierarchical queries in large catalogues.
+ *
+ * Usage: ( cd tests ; ../bin/testRegisterCatalogueTreePerformance [<NumberOfRegisters>] )
+ *
+ * A NumericAddressedRegisterCatalogue with the given number of registers is filled, organised as
+ * "/APPn/MODULEm/REGISTERk" with 100 registers per module and 100 modules per application. The time to build the prefix
+ * tree index and to query all registers of each module, the children of each application and a glob pattern is printed.
+ * For comparison, the module queries are also done by a linear scan over the catalogue, which was the only way before
+ * the index existed.
+ *
+ * If omitted, the number of registers defaults to 1000 (which is acceptable also on slower machines in debug build
+ * mode). Use e.g. 100000 to get numbers representative for large catalogues.
+ */
+
+/**********************************************************************************************************************/
+
+template<typename FUNCTION>
+double measure(FUNCTION function) {
+  auto t0 = std::chrono::steady_clock::now();
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nRegisters = 1000;
+  if(argc > 1) {
+    nRegisters = std::stoul(argv[1]);
+  }
+
+  NumericAddressedRegisterCatalogue catalogue;
+  catalogue.reserve(nRegisters);
+  std::vector<std::string> moduleNames;
+  std::vector<std::string> applicationNames;
+  for(size_t i = 0; i < nRegisters; ++i) {
+    auto application = "/APP" + std::to_string(i / 10000);
+    auto module = application + "/MODULE" + std::to_string(i / 100 % 100);
+    if(i % 10000 == 0) applicationNames.push_back(application);
+    if(i % 100 == 0) moduleNames.push_back(module);
+    catalogue.addRegister(NumericAddressedRegisterInfo(module + "/REGISTER" + std::to_string(i % 100), 1, 4 * i, 4));
+  }
+
+  // the first query builds the index
+  size_t nBuild = 0;
+  auto tBuild = measure([&] { nBuild = catalogue.getRegistersInModule("/").size(); });
+
+  size_t nInModules = 0;
+  auto tModules = measure([&] {
+    for(const auto& module : moduleNames) nInModules += catalogue.getRegistersInModule(module).size();
+  });
+
+  // linear scan for comparison, only for some modules since it is slow
+  size_t nScanned = std::min<size_t>(moduleNames.size(), 100);
+  size_t nInModulesScan = 0;
+  auto tModulesScan = measure([&] {
+    for(size_t m = 0; m < nScanned; ++m) {
+      auto prefix = moduleNames[m] + "/";
+      for(const auto& info : catalogue) {
+        nInModulesScan += std::string(info.getRegisterName()).compare(0, prefix.size(), prefix) == 0;
+      }
+    }
+  });
+
+  size_t nChildren = 0;
+  auto tChildren = measure([&] {
+    for(const auto& application : applicationNames) nChildren += catalogue.getChildNames(application).size();
+  });
+
+  size_t nMatching = 0;
+  auto tGlob = measure([&] { nMatching = catalogue.getRegistersMatching("/**/MODULE?/REGISTER*7").size(); });
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Module queries in a catalogue with " << nRegisters << " registers:" << std::endl;
+  if(nBuild != nRegisters || nInModules != nRegisters || nInModulesScan != 100 * nScanned ||
+      nChildren != moduleNames.size()) {
+    std::cout << " ERROR: Wrong number of registers found: " << nBuild << " " << nInModules << " " << nInModulesScan
+              << " " << nChildren << std::endl;
+    return 1;
+  }
+  auto perQuery = [](double t, size_t n) { return t / static_cast<double>(n) * 1e6; };
+  std::cout << "   building the index:           " << tBuild << " s" << std::endl;
+  std::cout << "   registers in module (index):  " << perQuery(tModules, moduleNames.size()) << " us" << std::endl;
+  std::cout << "   registers in module (scan):   " << perQuery(tModulesScan, nScanned) << " us" << std::endl;
+  std::cout << "   children of application:      " << perQuery(tChildren, applicationNames.size()) << " us"
+            << std::endl;
+  std::cout << "   glob pattern (" << nMatching << " matches): " << tGlob * 1e6 << " us" << std::endl;
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
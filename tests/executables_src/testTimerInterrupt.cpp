@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TimerInterruptTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackend.h"
+#include "TimerInterruptSource.h"
+#include "waitFor.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(TimerInterruptTestSuite)
+
+static const std::string cdd{"(dummy?map=timerInterrupt.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSimulatedClock) {
+  const std::chrono::milliseconds period{100};
+  auto clock = std::make_shared<TimerInterruptSource::SimulatedClock>();
+  std::atomic<size_t> nCalls{0};
+  TimerInterruptSource timer(
+      period,
+      [&] {
+        ++nCalls;
+        if(nCalls == 2) {
+          // the second call takes 2.5 periods
+          clock->advance(period * 5 / 2);
+        }
+      },
+      clock);
+
+  BOOST_CHECK(!timer.isRunning());
+  timer.start();
+  BOOST_CHECK(timer.isRunning());
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+
+  // not triggered before the period is over
+  clock->advance(period / 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  BOOST_CHECK_EQUAL(nCalls, 0);
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  clock->advance(period / 2);
+  BOOST_REQUIRE(waitFor([&] { return nCalls == 1; }));
+
+  // a call taking too long makes the timer skip the missed periods
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  clock->advance(period);
+  BOOST_REQUIRE(waitFor([&] { return nCalls == 2; }));
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  BOOST_CHECK_EQUAL(timer.getNumberOfSkippedPeriods(), 2);
+  BOOST_CHECK_EQUAL(nCalls, 2);
+
+  // the period stays aligned to the start time
+  clock->advance(period / 2);
+  BOOST_REQUIRE(waitFor([&] { return nCalls == 3; }));
+
+  timer.stop();
+  BOOST_CHECK(!timer.isRunning());
+  clock->advance(period * 10);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  BOOST_CHECK_EQUAL(nCalls, 3);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testPushAccessorsOnPolledRegisters) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<NumericAddressedBackend>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+  auto* timer = backend->getTimerInterruptSource(100);
+  BOOST_REQUIRE(timer != nullptr);
+  BOOST_CHECK(timer->getPeriod() == std::chrono::milliseconds(10));
+  BOOST_CHECK(backend->getTimerInterruptSource(1) == nullptr);
+
+  auto clock = std::make_shared<TimerInterruptSource::SimulatedClock>();
+  backend->setTimerInterruptClock(clock);
+
+  // the register is not writeable through the interrupt, so use the writeable variant of the dummy
+  auto statusWrite = device.getScalarRegisterAccessor<int32_t>("APP/STATUS.DUMMY_WRITEABLE");
+  auto status = device.getScalarRegisterAccessor<int32_t>("APP/STATUS", 0, {AccessMode::wait_for_new_data});
+  auto counter = device.getScalarRegisterAccessor<int32_t>("APP/COUNTER", 0, {AccessMode::wait_for_new_data});
+
+  // the timer only runs while asynchronous read is active
+  BOOST_CHECK(!timer->isRunning());
+  device.activateAsyncRead();
+  BOOST_CHECK(timer->isRunning());
+  BOOST_CHECK_THROW(backend->setTimerInterruptClock(clock), ChimeraTK::logic_error);
+
+  // initial values
+  status.read();
+  counter.read();
+
+  // nothing is sent before the period is over
+  statusWrite = 42;
+  statusWrite.write();
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  clock->advance(timer->getPeriod() / 2);
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  BOOST_CHECK(!status.readNonBlocking());
+
+  // the new value arrives with the next timer trigger
+  clock->advance(timer->getPeriod() / 2);
+  status.read();
+  counter.read();
+  BOOST_CHECK_EQUAL(int32_t(status), 42);
+
+  // both registers are read in the same transfer
+  BOOST_CHECK(status.getVersionNumber() == counter.getVersionNumber());
+
+  // exactly one trigger per period
+  BOOST_REQUIRE(waitFor([&] { return clock->hasWaitingThread(); }));
+  BOOST_CHECK(!status.readNonBlocking());
+
+  device.close();
+  BOOST_CHECK(!timer->isRunning());
+}
+
+/**********************************************************************************************************************/
+
+/**
+ * Dummy recording the calls to startInterruptHandlingThread().
+ */
+class RecordingDummy : public DummyBackend {
+ public:
+  using DummyBackend::DummyBackend;
+
+  void startInterruptHandlingThread(uint32_t interruptNumber) override {
+    startedInterruptHandlingThreads.push_back(interruptNumber);
+  }
+
+  std::vector<uint32_t> startedInterruptHandlingThreads;
+};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testNoInterruptHandlingThreadForTimer) {
+  // Backends like the UioBackend cannot handle interrupt numbers without hardware interrupt.
+  auto backend = boost::make_shared<RecordingDummy>("timerInterrupt.map");
+  backend->open();
+
+  auto status = backend->getRegisterAccessor<int32_t>("APP/STATUS", 1, 0, {AccessMode::wait_for_new_data});
+  BOOST_CHECK(backend->startedInterruptHandlingThreads.empty());
+
+  auto hwStatus = backend->getRegisterAccessor<int32_t>("APP/HW_STATUS", 1, 0, {AccessMode::wait_for_new_data});
+  BOOST_CHECK(backend->startedInterruptHandlingThreads == std::vector<uint32_t>({1}));
+
+  backend->close();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
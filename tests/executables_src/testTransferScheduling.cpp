@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TransferSchedulingTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "DummyBackend.h"
+#include "NumericAddressedLowLevelTransferElement.h"
+#include "OneDRegisterAccessor.h"
+#include "ScalarRegisterAccessor.h"
+#include "TransferGroup.h"
+#include "TransferScheduler.h"
+#include "TwoDRegisterAccessor.h"
+#include "waitFor.h"
+
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(TransferSchedulingTestSuite)
+
+/**********************************************************************************************************************/
+
+/**
+ * DummyBackend which records the sizes of the read and write transfers.
+ */
+struct RecordingDummy : public DummyBackend {
+  using DummyBackend::DummyBackend;
+
+  void read(uint64_t bar, uint64_t address, int32_t* data, size_t sizeInBytes) override {
+    {
+      std::lock_guard<std::mutex> lock(recordMutex);
+      readSizes.push_back(sizeInBytes);
+    }
+    DummyBackend::read(bar, address, data, sizeInBytes);
+  }
+
+  void write(uint64_t bar, uint64_t address, int32_t const* data, size_t sizeInBytes) override {
+    {
+      std::lock_guard<std::mutex> lock(recordMutex);
+      writeSizes.push_back(sizeInBytes);
+    }
+    DummyBackend::write(bar, address, data, sizeInBytes);
+  }
+
+  void clearRecords() {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    readSizes.clear();
+    writeSizes.clear();
+  }
+
+  std::mutex recordMutex;
+  std::vector<size_t> readSizes;
+  std::vector<size_t> writeSizes;
+};
+
+/**********************************************************************************************************************/
+
+TransferPriority getPriority(TransferElementAbstractor& accessor) {
+  auto elements = accessor.getHardwareAccessingElements();
+  BOOST_REQUIRE_EQUAL(elements.size(), 1);
+  auto lowLevelElement = boost::dynamic_pointer_cast<NumericAddressedLowLevelTransferElement>(elements.front());
+  BOOST_REQUIRE(lowLevelElement);
+  return lowLevelElement->getPriority();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testChunking) {
+  auto backend = boost::make_shared<RecordingDummy>("transferSchedulingMetadata.map");
+  backend->open();
+
+  OneDRegisterAccessor<int32_t> daq(backend->getRegisterAccessor<int32_t>("APP/DAQ", 0, 0, {}));
+  std::iota(daq.begin(), daq.end(), 42);
+
+  // large transfers are split into chunks of the size configured in the map file
+  backend->clearRecords();
+  daq.write();
+  BOOST_CHECK(backend->writeSizes == std::vector<size_t>(4, 1024));
+
+  OneDRegisterAccessor<int32_t> daq2(backend->getRegisterAccessor<int32_t>("APP/DAQ", 0, 0, {}));
+  backend->clearRecords();
+  daq2.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>(4, 1024));
+  for(size_t i = 0; i < daq2.getNElements(); ++i) {
+    BOOST_CHECK_EQUAL(daq2[i], int32_t(42 + i));
+  }
+
+  // small transfers are not affected
+  ScalarRegisterAccessor<int32_t> interlock(backend->getRegisterAccessor<int32_t>("APP/INTERLOCK", 1, 0, {}));
+  backend->clearRecords();
+  interlock.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>({4}));
+
+  // the chunk size is rounded to the word size
+  backend->enableTransferScheduling(1001);
+  backend->clearRecords();
+  daq2.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>({1000, 1000, 1000, 1000, 96}));
+
+  // chunk size 0 disables the splitting
+  backend->enableTransferScheduling(0);
+  backend->clearRecords();
+  daq2.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>({4096}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testPriorityOrder) {
+  TransferScheduler scheduler;
+  std::mutex orderMutex;
+  std::vector<TransferPriority> order;
+
+  auto transfer = [&](TransferPriority priority) {
+    TransferScheduler::Slot slot(scheduler, priority);
+    std::lock_guard<std::mutex> lock(orderMutex);
+    order.push_back(priority);
+  };
+
+  // occupy the transport, so the other transfers have to wait
+  scheduler.acquire(TransferPriority::normal);
+  std::thread low(transfer, TransferPriority::low);
+  BOOST_REQUIRE(waitFor([&] { return scheduler.getNumberOfWaitingTransfers() == 1; }));
+  std::thread normal(transfer, TransferPriority::normal);
+  BOOST_REQUIRE(waitFor([&] { return scheduler.getNumberOfWaitingTransfers() == 2; }));
+  std::thread high(transfer, TransferPriority::high);
+  BOOST_REQUIRE(waitFor([&] { return scheduler.getNumberOfWaitingTransfers() == 3; }));
+
+  // the waiting transfers proceed by priority, not by arrival
+  scheduler.release();
+  low.join();
+  normal.join();
+  high.join();
+  BOOST_CHECK(order ==
+      std::vector<TransferPriority>({TransferPriority::high, TransferPriority::normal, TransferPriority::low}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testSetTransferPriority) {
+  auto backend = boost::make_shared<RecordingDummy>("transferSchedulingMetadata.map");
+  backend->open();
+
+  ScalarRegisterAccessor<int32_t> interlock(backend->getRegisterAccessor<int32_t>("APP/INTERLOCK", 1, 0, {}));
+  ScalarRegisterAccessor<int32_t> status(backend->getRegisterAccessor<int32_t>("APP/STATUS", 1, 0, {}));
+  BOOST_CHECK(getPriority(interlock) == TransferPriority::normal);
+
+  NumericAddressedBackend::setTransferPriority(interlock, TransferPriority::high);
+  NumericAddressedBackend::setTransferPriority(status, TransferPriority::low);
+  BOOST_CHECK(getPriority(interlock) == TransferPriority::high);
+  BOOST_CHECK(getPriority(status) == TransferPriority::low);
+
+  // the merged transfer uses the highest priority
+  TransferGroup group;
+  group.addAccessor(status);
+  group.addAccessor(interlock);
+  BOOST_CHECK(getPriority(status) == TransferPriority::high);
+  BOOST_CHECK(getPriority(interlock) == TransferPriority::high);
+  backend->clearRecords();
+  group.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>({8}));
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testMultiplexedRegister) {
+  auto backend = boost::make_shared<RecordingDummy>("transferSchedulingMetadata.map");
+  backend->open();
+
+  TwoDRegisterAccessor<int32_t> waveforms(backend->getRegisterAccessor<int32_t>("APP/WAVEFORMS", 0, 0, {}));
+  BOOST_REQUIRE_EQUAL(waveforms.getNChannels(), 4);
+  BOOST_REQUIRE_EQUAL(waveforms.getNElementsPerChannel(), 128);
+  for(size_t i = 0; i < waveforms.getNChannels(); ++i) {
+    std::iota(waveforms[i].begin(), waveforms[i].end(), int32_t(1000 * i));
+  }
+
+  // 2D registers go through the scheduler as well, hence they are split into chunks
+  backend->clearRecords();
+  waveforms.write();
+  BOOST_CHECK(backend->writeSizes == std::vector<size_t>(2, 1024));
+
+  TwoDRegisterAccessor<int32_t> waveforms2(backend->getRegisterAccessor<int32_t>("APP/WAVEFORMS", 0, 0, {}));
+  backend->clearRecords();
+  waveforms2.read();
+  BOOST_CHECK(backend->readSizes == std::vector<size_t>(2, 1024));
+  for(size_t i = 0; i < waveforms2.getNChannels(); ++i) {
+    for(size_t k = 0; k < waveforms2.getNElementsPerChannel(); ++k) {
+      BOOST_CHECK_EQUAL(waveforms2[i][k], int32_t(1000 * i + k));
+    }
+  }
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
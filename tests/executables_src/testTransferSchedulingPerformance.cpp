@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "DummyBackend.h"
+#include "OneDRegisterAccessor.h"
+#include "ScalarRegisterAccessor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+using namespace ChimeraTK;
+
+/*
+ * Latency benchmark for the scheduling of transfers in the NumericAddressedBackend.
+ *
+ * Usage: ( cd tests ; ../bin/testTransferSchedulingPerformance [<NumberOfInterlockReads>] )
+ *
+ * A DAQ thread continuously reads a 1 MB register, while the control thread reads a single-word interlock register and
+ * measures the latency of each read. The dummy simulates a transport with limited bandwidth, which can only execute one
+ * transfer at a time. The test is run without scheduling, and with scheduling, chunks of 64 kB and a high priority for
+ * the interlock register.
+ */
+
+/**********************************************************************************************************************/
+
+/**
+ * DummyBackend with a simulated bandwidth limit of the transport.
+ */
+struct ThrottledDummy : public DummyBackend {
+  using DummyBackend::DummyBackend;
+
+  void read(uint64_t bar, uint64_t address, int32_t* data, size_t sizeInBytes) override {
+    std::lock_guard<std::mutex> lock(transportMutex);
+    std::this_thread::sleep_for(std::chrono::nanoseconds(sizeInBytes * 1000000000 / bytesPerSecond));
+    DummyBackend::read(bar, address, data, sizeInBytes);
+  }
+
+  static constexpr size_t bytesPerSecond{256 * 1024 * 1024};
+  std::mutex transportMutex;
+};
+
+/**********************************************************************************************************************/
+
+void runBenchmark(const std::string& title, bool enableScheduling, size_t nInterlockReads) {
+  auto backend = boost::make_shared<ThrottledDummy>("transferScheduling.map");
+  backend->open();
+  if(enableScheduling) {
+    backend->enableTransferScheduling(64 * 1024);
+  }
+
+  OneDRegisterAccessor<int32_t> daq(backend->getRegisterAccessor<int32_t>("APP/DAQ", 0, 0, {}));
+  ScalarRegisterAccessor<int32_t> interlock(backend->getRegisterAccessor<int32_t>("APP/INTERLOCK", 1, 0, {}));
+  if(enableScheduling) {
+    NumericAddressedBackend::setTransferPriority(daq, TransferPriority::low);
+    NumericAddressedBackend::setTransferPriority(interlock, TransferPriority::high);
+  }
+
+  std::atomic<bool> stop{false};
+  size_t nDaqReads = 0;
+  std::thread daqThread([&] {
+    while(!stop) {
+      daq.read();
+      ++nDaqReads;
+    }
+  });
+
+  std::vector<double> latencies;
+  auto start = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < nInterlockReads; ++i) {
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    auto t0 = std::chrono::steady_clock::now();
+    interlock.read();
+    latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+  }
+  auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  stop = true;
+  daqThread.join();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto mean = std::accumulate(latencies.begin(), latencies.end(), 0.) / static_cast<double>(latencies.size());
+  std::cout << " " << title << ":" << std::endl;
+  std::cout << "   interlock read latency: mean " << mean << " us, median " << latencies[latencies.size() / 2]
+            << " us, max " << latencies.back() << " us" << std::endl;
+  std::cout << "   DAQ throughput: " << static_cast<double>(nDaqReads) / duration << " MB/s" << std::endl;
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nInterlockReads = 200;
+  if(argc > 1) {
+    nInterlockReads = std::stoul(argv[1]);
+  }
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Transfer scheduling latency benchmark (" << ThrottledDummy::bytesPerSecond / 1024 / 1024
+            << " MB/s simulated bandwidth):" << std::endl;
+  runBenchmark("without scheduling", false, nInterlockReads);
+  runBenchmark("with scheduling, 64 kB chunks", true, nInterlockReads);
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE TryReadTest
+#include <boost/test/unit_test.hpp>
+using namespace boost::unit_test_framework;
+
+#include "BackendFactory.h"
+#include "Device.h"
+#include "DummyBackend.h"
+#include "ReadAnyGroup.h"
+#include "TransferGroup.h"
+
+#include <tuple>
+
+using namespace ChimeraTK;
+
+BOOST_AUTO_TEST_SUITE(TryReadTestSuite)
+
+static const std::string cdd{"(ExceptionDummy?map=pollScheduler.map)"};
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTryRead) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<DummyBackendBase>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+
+  auto writer = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/A");
+  writer = 12;
+  writer.write();
+
+  auto result = accessor.tryRead();
+  BOOST_CHECK(result.hasValue());
+  BOOST_CHECK(result.getStatus() == TransferStatus::ok);
+  BOOST_CHECK(result.getErrorMessage().empty());
+  BOOST_CHECK_EQUAL(int32_t(accessor), 12);
+
+  // a failing transfer is returned and reported to the backend
+  auto version = accessor.getVersionNumber();
+  backend->throwExceptionRead = true;
+  result = accessor.tryRead();
+  BOOST_CHECK(!result);
+  BOOST_CHECK(result.getStatus() == TransferStatus::runtimeError);
+  BOOST_CHECK(!result.getErrorMessage().empty());
+  BOOST_CHECK_THROW(result.rethrow(), ChimeraTK::runtime_error);
+  BOOST_CHECK(!backend->isFunctional());
+  BOOST_CHECK(accessor.getVersionNumber() == version);
+  backend->throwExceptionRead = false;
+
+  // the backend stays in the exception state until it is opened again
+  writer = 13;
+  BOOST_CHECK(writer.tryWrite().getStatus() == TransferStatus::runtimeError);
+  result = accessor.tryRead();
+  BOOST_CHECK(result.getStatus() == TransferStatus::runtimeError);
+  BOOST_CHECK_THROW(accessor.read(), ChimeraTK::runtime_error);
+  BOOST_CHECK_EQUAL(int32_t(accessor), 12);
+
+  device.open();
+  BOOST_CHECK(writer.tryWrite().hasValue());
+  BOOST_CHECK(accessor.tryRead().hasValue());
+  BOOST_CHECK_EQUAL(int32_t(accessor), 13);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTryWrite) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<DummyBackendBase>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/B");
+  accessor = 5;
+  auto result = accessor.tryWrite();
+  BOOST_REQUIRE(result.hasValue());
+  BOOST_CHECK(!result.value());
+  BOOST_CHECK(!result.valueOr(true));
+
+  VersionNumber version;
+  backend->throwExceptionWrite = true;
+  result = accessor.tryWrite(version);
+  BOOST_CHECK(result.getStatus() == TransferStatus::runtimeError);
+  BOOST_CHECK_THROW(std::ignore = result.value(), ChimeraTK::runtime_error);
+  BOOST_CHECK(result.valueOr(true));
+  BOOST_CHECK(accessor.getVersionNumber() != version);
+  backend->throwExceptionWrite = false;
+  device.open();
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testLogicErrors) {
+  Device device(cdd);
+  device.open();
+  auto backend = boost::dynamic_pointer_cast<DummyBackendBase>(BackendFactory::getInstance().createBackend(cdd));
+  BOOST_REQUIRE(backend);
+  auto accessor = device.getScalarRegisterAccessor<int32_t>("APP/A");
+
+  // an outdated version number is a logic error, even if the device is known to be in an exception state
+  VersionNumber oldVersion;
+  BOOST_CHECK(accessor.tryWrite().hasValue());
+  backend->setException("test");
+  BOOST_CHECK_THROW(std::ignore = accessor.tryWrite(oldVersion), ChimeraTK::logic_error);
+
+  // so is a transfer on a closed device
+  device.close();
+  BOOST_CHECK_THROW(std::ignore = accessor.tryRead(), ChimeraTK::logic_error);
+  BOOST_CHECK_THROW(std::ignore = accessor.tryWrite(), ChimeraTK::logic_error);
+
+  // and a transfer of an element in a TransferGroup
+  device.open();
+  TransferGroup group;
+  group.addAccessor(accessor);
+  BOOST_CHECK_THROW(std::ignore = accessor.tryRead(), ChimeraTK::logic_error);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_CASE(testTryReadAny) {
+  const std::string interruptCdd{"(dummy?map=interruptTimestamp.map)"};
+  Device device(interruptCdd);
+  device.open();
+  auto dummy = boost::dynamic_pointer_cast<DummyBackend>(BackendFactory::getInstance().createBackend(interruptCdd));
+  BOOST_REQUIRE(dummy);
+
+  auto data = device.getScalarRegisterAccessor<int32_t>("APP/DATA");
+  auto data1 = device.getScalarRegisterAccessor<int32_t>("APP/DATA_1", 0, {AccessMode::wait_for_new_data});
+  auto polled = device.getScalarRegisterAccessor<int32_t>("APP/TAI_MS");
+  ReadAnyGroup group{data1, polled};
+  device.activateAsyncRead();
+
+  // initial value
+  auto result = group.tryReadAny();
+  BOOST_REQUIRE(result.hasValue());
+  BOOST_CHECK(result.value() == data1.getId());
+
+  data = 7;
+  data.write();
+  dummy->triggerInterrupt(1);
+  result = group.tryReadAny();
+  BOOST_REQUIRE(result.hasValue());
+  BOOST_CHECK(result.value() == data1.getId());
+  BOOST_CHECK_EQUAL(int32_t(data1), 7);
+
+  // the exception is delivered through the queue of the push-type element
+  dummy->setException("test");
+  result = group.tryReadAny();
+  BOOST_CHECK(result.getStatus() == TransferStatus::runtimeError);
+  BOOST_CHECK_EQUAL(result.getErrorMessage(), "test");
+
+  // interruptions are returned as well
+  device.open();
+  device.activateAsyncRead();
+  BOOST_CHECK(group.tryReadAny().hasValue());
+  group.interrupt();
+  BOOST_CHECK(group.tryReadAny().getStatus() == TransferStatus::interrupted);
+}
+
+/**********************************************************************************************************************/
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "Device.h"
+
+#include <chrono>
+#include <iostream>
+
+using namespace ChimeraTK;
+
+/*
+ * Throughput benchmark for reads while the device is in an exception state.
+ *
+ * Usage: ( cd tests ; ../bin/testTryReadPerformance [<NumberOfReads>] )
+ *
+ * The device is put into the exception state, then the same register is read repeatedly with read() and catching the
+ * exception, and with tryRead(). This is what an application does while a crate is power-cycled. The test is done with
+ * a plain accessor and with a type-converting accessor, which adds a decorator to the chain.
+ */
+
+/**********************************************************************************************************************/
+
+template<typename UserType>
+void runBenchmark(Device& device, const std::string& title, size_t nReads) {
+  auto accessor = device.getScalarRegisterAccessor<UserType>("APP/A");
+
+  auto t0 = std::chrono::steady_clock::now();
+  size_t nFailed = 0;
+  for(size_t i = 0; i < nReads; ++i) {
+    try {
+      accessor.read();
+    }
+    catch(ChimeraTK::runtime_error&) {
+      ++nFailed;
+    }
+  }
+  auto tThrowing = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  t0 = std::chrono::steady_clock::now();
+  for(size_t i = 0; i < nReads; ++i) {
+    if(!accessor.tryRead()) {
+      ++nFailed;
+    }
+  }
+  auto tNonThrowing = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  if(nFailed != 2 * nReads) {
+    std::cout << " ERROR: Not all reads have failed." << std::endl;
+  }
+  std::cout << " " << title << ":" << std::endl;
+  std::cout << "   read():    " << static_cast<double>(nReads) / tThrowing << " reads/s" << std::endl;
+  std::cout << "   tryRead(): " << static_cast<double>(nReads) / tNonThrowing << " reads/s" << std::endl;
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nReads = 100000;
+  if(argc > 1) {
+    nReads = std::stoul(argv[1]);
+  }
+
+  Device device("(ExceptionDummy?map=pollScheduler.map)");
+  device.open();
+  device.setException("simulated power cycle");
+
+  std::cout << " ***************************************************************************" << std::endl;
+  std::cout << " Read throughput while the device is in an exception state:" << std::endl;
+  runBenchmark<int32_t>(device, "int32_t accessor", nReads);
+  runBenchmark<double>(device, "double accessor", nReads);
+  std::cout << " ***************************************************************************" << std::endl;
+
+  return 0;
+}
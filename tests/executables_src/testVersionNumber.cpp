@@ -26,6 +26,7 @@ class VersionNumberTest {
   void testThreadedCreation();
   void testStringConvert();
   void testTimeStamp();
+  void testClockPolicy();
 
   VersionNumber v1;
   VersionNumber v2;
@@ -50,6 +51,7 @@ class VersionNumberTestSuite : public test_suite {
     add(BOOST_CLASS_TEST_CASE(&VersionNumberTest::testThreadedCreation, test));
     add(BOOST_CLASS_TEST_CASE(&VersionNumberTest::testStringConvert, test));
     add(BOOST_CLASS_TEST_CASE(&VersionNumberTest::testTimeStamp, test));
+    add(BOOST_CLASS_TEST_CASE(&VersionNumberTest::testClockPolicy, test));
   }
 };
 
@@ -332,3 +334,28 @@ void VersionNumberTest::testTimeStamp() {
   auto t1 = std::chrono::system_clock::now();
   BOOST_CHECK(vv2.getTime() < t1);
 }
+
+void VersionNumberTest::testClockPolicy() {
+  BOOST_CHECK(VersionNumber::getClockPolicy() == VersionNumber::ClockPolicy::precise);
+
+  VersionNumber::setClockPolicy(VersionNumber::ClockPolicy::coarse);
+  BOOST_CHECK(VersionNumber::getClockPolicy() == VersionNumber::ClockPolicy::coarse);
+
+  // The coarse clock may lag behind by one kernel tick. Allow a generous margin.
+  auto t0 = std::chrono::system_clock::now();
+  VersionNumber vv0;
+  VersionNumber vv1;
+  auto t1 = std::chrono::system_clock::now();
+  BOOST_CHECK(vv0.getTime() >= t0 - std::chrono::milliseconds(100));
+  BOOST_CHECK(vv1.getTime() >= vv0.getTime());
+  BOOST_CHECK(vv1.getTime() <= t1);
+
+  // the comparison is not affected by the clock
+  BOOST_CHECK(vv1 > vv0);
+  BOOST_CHECK(vv0 > v4);
+
+  VersionNumber::setClockPolicy(VersionNumber::ClockPolicy::precise);
+  VersionNumber vv2;
+  BOOST_CHECK(vv2 > vv1);
+  BOOST_CHECK(vv2.getTime() >= t1);
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+#include "VersionNumber.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ChimeraTK;
+
+/*
+ * Microbenchmark for the construction of VersionNumbers with the different clock policies.
+ *
+ * Usage: testVersionNumberPerformance [<NumberOfIterations>] [<NumberOfThreads>]
+ *
+ * <NumberOfIterations> is the number of VersionNumbers created per thread and policy, defaulting to 1000000.
+ * <NumberOfThreads> is the number of threads creating VersionNumbers concurrently, defaulting to 1.
+ *
+ */
+
+/**********************************************************************************************************************/
+
+static double measureNanosecondsPerVersion(size_t nIterations, size_t nThreads) {
+  auto worker = [nIterations] {
+    VersionNumber last{nullptr};
+    for(size_t i = 0; i < nIterations; ++i) {
+      VersionNumber v;
+      if(v <= last) {
+        std::cout << "ERROR: VersionNumbers not increasing!" << std::endl;
+        std::exit(1);
+      }
+      last = v;
+    }
+  };
+
+  auto t0 = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for(size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for(auto& t : threads) {
+    t.join();
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()) /
+      static_cast<double>(nIterations);
+}
+
+/**********************************************************************************************************************/
+
+int main(int argc, char** argv) {
+  size_t nIterations = argc > 1 ? std::strtoul(argv[1], nullptr, 0) : 1000000;
+  size_t nThreads = argc > 2 ? std::strtoul(argv[2], nullptr, 0) : 1;
+  if(nIterations == 0 || nThreads == 0) {
+    std::cout << "Usage: " << argv[0] << " [<NumberOfIterations>] [<NumberOfThreads>]" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Creating " << nIterations << " VersionNumbers in each of " << nThreads << " thread(s)" << std::endl;
+
+  VersionNumber::setClockPolicy(VersionNumber::ClockPolicy::precise);
+  std::cout << " precise clock: " << measureNanosecondsPerVersion(nIterations, nThreads) << " ns per VersionNumber"
+            << std::endl;
+
+  VersionNumber::setClockPolicy(VersionNumber::ClockPolicy::coarse);
+  std::cout << " coarse clock:  " << measureNanosecondsPerVersion(nIterations, nThreads) << " ns per VersionNumber"
+            << std::endl;
+
+  VersionNumber::setClockPolicy(VersionNumber::ClockPolicy::precise);
+  return 0;
+}
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include "MapFileParser.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace ChimeraTK;
+
+/**********************************************************************************************************************/
+
+/**
+ * Reference implementation of MapFileParser::parse() for the tests. It reads the file line by line with std::getline()
+ * and tokenises it with std::istringstream, like the original implementation did. The catalogue is built by the
+ * MapFileParser, so only the tokenisation is compared.
+ */
+struct StreamMapFileParser : public MapFileParser {
+  /** Same result as parse(), but without using the catalogue cache. */
+  std::pair<NumericAddressedRegisterCatalogue, MetadataCatalogue> parseWithStreams(const std::string& file_name_) {
+    file_name = file_name_;
+    std::ifstream file;
+
+    file.open(file_name.c_str());
+    if(!file) {
+      throw ChimeraTK::logic_error("Cannot open file \"" + file_name + "\"");
+    }
+
+    std::string line;
+    while(std::getline(file, line)) {
+      line_nr++;
+
+      // Remove whitespace from beginning of line
+      line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](int c) { return !isspace(c); }));
+
+      // Remove comments from the end of the line
+      auto pos = line.find('#');
+      if(pos != std::string::npos) {
+        line.erase(pos, std::string::npos);
+      }
+
+      // Ignore empty lines (including all-comment lines)
+      if(line.empty()) {
+        continue;
+      }
+
+      // Parse meta data line
+      if(line[0] == '@') {
+        parseMetaDataWithStreams(line);
+        continue;
+      }
+
+      // Parse register line
+      parsedLines.push_back(parseLineWithStreams(line));
+    }
+
+    return makeCatalogue();
+  }
+
+  /** Stream-based counterpart of parseMetaData() */
+  void parseMetaDataWithStreams(std::string line) {
+    std::string metadata_name, metadata_value;
+
+    // Remove the '@' character...
+    line.erase(line.begin(), line.begin() + 1);
+
+    // ... and remove all the whitespace after it
+    line.erase(line.begin(), std::find_if(line.begin(), line.end(), [](int c) { return !isspace(c); }));
+
+    std::istringstream is;
+    is.str(line);
+    is >> metadata_name;
+    if(!is) {
+      throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " + std::to_string(line_nr));
+    }
+    // remove name from the string
+    line.erase(line.begin(), line.begin() + static_cast<std::string::difference_type>(metadata_name.length()));
+
+    line.erase(std::remove_if(line.begin(), line.end(), [](unsigned char x) { return std::isspace(x); }),
+        line.end()); // remove whitespaces from rest of the string (before and after the value)
+    metadata_value = line;
+    metadataCatalogue.addMetadata(metadata_name, metadata_value);
+    is.clear();
+  }
+
+  /** Stream-based counterpart of parseLine() */
+  ParsedLine parseLineWithStreams(const std::string& line) {
+    ParsedLine pl;
+
+    std::istringstream is;
+    is.str(line);
+
+    // extract register name
+    std::string name;
+    is >> name;
+    pl.pathName = name;
+    pl.pathName.setAltSeparator(".");
+
+    // extract mandatory address information
+    is >> std::setbase(0) >> pl.nElements >> std::setbase(0) >> pl.address >> std::setbase(0) >> pl.nBytes;
+    if(!is) {
+      throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " + std::to_string(line_nr));
+    }
+
+    // Note: default values for optional information are set in ParsedLine declaration
+
+    // extract bar
+    is >> std::setbase(0) >> pl.bar;
+
+    // extract width
+    if(!is.fail()) {
+      is >> std::setbase(0) >> pl.width;
+      if(pl.width > 32) {
+        throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
+            std::to_string(line_nr) + ": register width too big");
+      }
+    }
+
+    // extract bit interpretation field (nb. of fractional bits, IEEE754, VOID, ...)
+    if(!is.fail()) {
+      std::string bitInterpretation;
+      is >> bitInterpretation;
+      if(!is.fail()) {
+        // width is needed to determine whether type is VOID
+        std::tie(pl.type, pl.nFractionalBits) = getTypeAndNFractionalBits(bitInterpretation, pl.width);
+        if(pl.nFractionalBits > 1023 || pl.nFractionalBits < -1024) {
+          throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
+              std::to_string(line_nr) + ": too many fractional bits");
+        }
+      }
+    }
+
+    // extract signed flag
+    if(!is.fail()) {
+      is >> std::setbase(0) >> pl.signedFlag;
+    }
+
+    // extract access mode string (RO, RW, WO, INTERRUPT)
+    if(!is.fail()) {
+      std::string accessString;
+      is >> accessString;
+      if(!is.fail()) {
+        // first transform to uppercase
+        std::transform(accessString.begin(), accessString.end(), accessString.begin(),
+            [](unsigned char c) { return std::toupper(c); });
+
+        // first check if access mode is INTERRUPT
+        auto interruptId = getInterruptId(accessString);
+
+        if(!interruptId.empty()) {
+          pl.registerAccess = NumericAddressedRegisterInfo::Access::INTERRUPT;
+          pl.interruptID = interruptId;
+        }
+        else if(accessString == "RO") {
+          pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_ONLY;
+        }
+        else if(accessString == "RW") {
+          pl.registerAccess = NumericAddressedRegisterInfo::Access::READ_WRITE;
+        }
+        else if(accessString == "WO") {
+          pl.registerAccess = NumericAddressedRegisterInfo::Access::WRITE_ONLY;
+        }
+        else {
+          throw ChimeraTK::logic_error("Parsing error in map file '" + file_name + "' on line " +
+              std::to_string(line_nr) + ": invalid data access");
+        }
+      }
+    }
+
+    checkFileConsitencyAndThrowIfError(pl.registerAccess, pl.type, pl.nElements, pl.address, pl.nBytes, pl.bar,
+        pl.width, pl.nFractionalBits, pl.signedFlag);
+
+    return pl;
+  }
+};
+
+/**********************************************************************************************************************/
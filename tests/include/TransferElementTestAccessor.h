@@ -165,6 +165,8 @@ namespace ChimeraTK {
 
     void interrupt() override { this->interrupt_impl(this->_readQueue); }
 
+    void wakeUpRead() override { this->wakeUpRead_impl(this->_readQueue); }
+
     bool _writeable{true};
     bool _readable{true};
 
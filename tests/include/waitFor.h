@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: Deutsches Elektronen-Synchrotron DESY, MSK, ChimeraTK Project <chimeratk-support@desy.de>
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+#include <chrono>
+#include <thread>
+
+/**
+ * Wait until the condition is true, at most for the given timeout. Returns whether the condition has become true. Meant
+ * for tests which have to wait for another thread, e.g. BOOST_REQUIRE(waitFor([&] { return flag; }));
+ */
+template<typename CONDITION>
+bool waitFor(CONDITION condition, std::chrono::steady_clock::duration timeout = std::chrono::seconds(10)) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  while(!condition()) {
+    if(std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return true;
+}